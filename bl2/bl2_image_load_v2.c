@@ -88,6 +88,16 @@ struct entry_point_info *bl2_load_images(void)
 		bl2_node_info = bl2_node_info->next_load_info;
 	}
 
+	/*
+	 * Image authentication may still be running in the background,
+	 * overlapped with the loading of the images that followed.
+	 */
+	err = bl2_plat_handle_pending_image_auth();
+	if (err != 0) {
+		ERROR("BL2: Failure in pending image authentication (%i)\n", err);
+		plat_error_handler(err);
+	}
+
 	/*
 	 * Get information to pass to the next image.
 	 */
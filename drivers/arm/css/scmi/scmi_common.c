@@ -124,6 +124,8 @@ void scmi_send_sync_command(scmi_channel_t *ch)
 	if (SCMI_LOGGER)
 		log_scmi_req(mbx_mem, ch->info->scmi_md_mem);
 
+	trace_scmi_req(mbx_mem, ch->info->scmi_md_mem);
+
 	SCMI_MARK_CHANNEL_BUSY(mbx_mem->status);
 
 	/*
@@ -157,6 +159,8 @@ void scmi_send_sync_command(scmi_channel_t *ch)
 
 	if (SCMI_LOGGER)
 		log_scmi_rsp(mbx_mem, ch->info->scmi_md_mem);
+
+	trace_scmi_rsp(mbx_mem, ch->info->scmi_md_mem);
 }
 
 /*
@@ -19,5 +19,31 @@ void log_scmi_rsp(mailbox_mem_t *mbx_mem, uintptr_t md_addr);
 void log_scmi_notif(mailbox_mem_t *mbx_mem, uintptr_t md_addr);
 void log_scmi_ack(mailbox_mem_t *mbx_mem, uintptr_t md_addr);
 
+#ifndef SCMI_TRACE
+#define SCMI_TRACE	0
+#endif
+
+/*
+ * Latency tracing of the requests to the SCP, implemented by the platform
+ * and only available at runtime.
+ */
+#if (SCMI_TRACE == 1) && defined(IMAGE_BL31)
+void trace_scmi_init(void);
+void trace_scmi_req(mailbox_mem_t *mbx_mem, uintptr_t md_addr);
+void trace_scmi_rsp(mailbox_mem_t *mbx_mem, uintptr_t md_addr);
+#else
+static inline void trace_scmi_init(void)
+{
+}
+
+static inline void trace_scmi_req(mailbox_mem_t *mbx_mem, uintptr_t md_addr)
+{
+}
+
+static inline void trace_scmi_rsp(mailbox_mem_t *mbx_mem, uintptr_t md_addr)
+{
+}
+#endif
+
 #endif /* SCMI_LOGGER_H */
 
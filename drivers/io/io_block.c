@@ -6,6 +6,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include <platform_def.h>
@@ -171,6 +172,16 @@ static int block_seek(io_entity_t *entity, int mode, signed long long offset)
 	return 0;
 }
 
+static bool is_direct_read(const io_block_dev_spec_t *dev_spec,
+			   uintptr_t buffer)
+{
+	if (dev_spec->direct_align == 0U) {
+		return false;
+	}
+
+	return (buffer & (dev_spec->direct_align - 1U)) == 0U;
+}
+
 /*
  * This function allows the caller to read any number of bytes
  * from any position. It hides from the caller that the low level
@@ -296,7 +307,37 @@ static int block_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 		 */
 		lba = (cur->file_pos + cur->base) / block_size;
 
-		if ((skip + left) > buf->length) {
+		if ((skip == 0U) && (left >= block_size) &&
+		    is_direct_read(cur->dev_spec, buffer + count)) {
+			/*
+			 * Whole blocks landing at a suitably aligned
+			 * address are transferred by the low level
+			 * driver straight into the user buffer.
+			 */
+			request = left & ~(block_size - 1U);
+			if (request > cur->dev_spec->direct_max) {
+				request = cur->dev_spec->direct_max;
+			}
+
+			nbytes = ops->read(lba, buffer + count, request);
+			if (nbytes == 0U) {
+				return -EIO;
+			}
+
+			cur->file_pos += nbytes;
+			count += nbytes;
+			continue;
+		}
+
+		if ((skip != 0U) && ((skip + left) > block_size) &&
+		    (cur->dev_spec->direct_align != 0U)) {
+			/*
+			 * Only bounce the unaligned head block, so that
+			 * the next iteration starts on a block boundary
+			 * and can be read directly.
+			 */
+			request = block_size;
+		} else if ((skip + left) > buf->length) {
 			/*
 			 * The underlying read buffer is too small to
 			 * read all the required data - limit to just
@@ -519,6 +560,10 @@ static int block_dev_open(const uintptr_t dev_spec, io_dev_info_t **dev_info)
 	       (is_power_of_2(block_size) != 0U) &&
 	       ((buffer->offset % block_size) == 0U) &&
 	       ((buffer->length % block_size) == 0U));
+	assert((cur->dev_spec->direct_align == 0U) ||
+	       ((is_power_of_2(cur->dev_spec->direct_align) != 0U) &&
+		(cur->dev_spec->direct_max >= block_size) &&
+		((cur->dev_spec->direct_max % block_size) == 0U)));
 
 	*dev_info = info;	/* cast away const */
 	(void)block_size;
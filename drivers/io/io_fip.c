@@ -6,6 +6,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -25,6 +26,20 @@
 #define MAX_FIP_DEVICES		1
 #endif
 
+#ifndef MAX_FIP_FILES
+#define MAX_FIP_FILES		1
+#endif
+
+/*
+ * FIP_TOC_INDEX_SIZE is the number of ToC entries kept in the per device
+ * lookup index, set by the build option of the same name. 0 disables the
+ * index.
+ */
+#if FIP_TOC_INDEX_SIZE
+/* Number of ToC entries fetched from the backend by a single read */
+#define FIP_TOC_READ_ENTRIES	8
+#endif
+
 /* Useful for printing UUIDs when debugging.*/
 #define PRINT_UUID2(x)								\
 	"%08x-%04hx-%04hx-%02hhx%02hhx-%02hhx%02hhx%02hhx%02hhx%02hhx%02hhx",	\
@@ -38,25 +53,41 @@ typedef struct {
 	fip_toc_entry_t entry;
 } fip_file_state_t;
 
+#if FIP_TOC_INDEX_SIZE
+typedef struct {
+	uuid_t uuid;
+	uint64_t offset_address;
+	uint64_t size;
+} fip_toc_index_entry_t;
+#endif
+
 /*
  * Maintain dev_spec per FIP Device
- * TODO - Add backend handles and file state
- * per FIP device here once backends like io_memmap
- * can support multiple open files
+ * TODO - Add backend handles per FIP device here
+ * once backends like io_memmap can support
+ * multiple open files
  */
 typedef struct {
 	uintptr_t dev_spec;
 	uint16_t plat_toc_flag;
+#if FIP_TOC_INDEX_SIZE
+	/* ToC entries sorted by UUID, filled in by fip_dev_init() */
+	fip_toc_index_entry_t toc[FIP_TOC_INDEX_SIZE];
+	unsigned int toc_entries;
+	/* The index covers the whole ToC */
+	bool toc_valid;
+	uintptr_t toc_dev_handle;
+	uintptr_t toc_image_spec;
+#endif
 } fip_dev_state_t;
 
 /*
- * Only one file can be open across all FIP device
- * as backends like io_memmap don't support
- * multiple open files. The file state and
- * backend handle should be maintained per FIP device
- * if the same support is available in the backend
+ * The backend is opened only for the duration of a read, hence several
+ * files can be open at the same time, as long as they are read one after
+ * another. A file state is in use when its offset is not zero, since the
+ * header lives at offset zero.
  */
-static fip_file_state_t current_fip_file = {0};
+static fip_file_state_t fip_files[MAX_FIP_FILES];
 static uintptr_t backend_dev_handle;
 static uintptr_t backend_image_spec;
 
@@ -212,6 +243,97 @@ static int fip_dev_open(const uintptr_t dev_spec,
 }
 
 
+#if FIP_TOC_INDEX_SIZE
+/* Insert a ToC entry into the index, keeping it sorted by UUID */
+static void fip_toc_index_add(fip_dev_state_t *state,
+			      const fip_toc_entry_t *entry)
+{
+	unsigned int i = state->toc_entries;
+
+	assert(state->toc_entries < (unsigned int)FIP_TOC_INDEX_SIZE);
+
+	while ((i > 0U) &&
+	       (compare_uuids(&state->toc[i - 1U].uuid, &entry->uuid) > 0)) {
+		state->toc[i] = state->toc[i - 1U];
+		i--;
+	}
+
+	state->toc[i].uuid = entry->uuid;
+	state->toc[i].offset_address = entry->offset_address;
+	state->toc[i].size = entry->size;
+	state->toc_entries++;
+}
+
+static const fip_toc_index_entry_t *fip_toc_index_find(
+		const fip_dev_state_t *state, const uuid_t *uuid)
+{
+	unsigned int low = 0U, high = state->toc_entries, mid;
+	int cmp;
+
+	while (low < high) {
+		mid = low + ((high - low) / 2U);
+		cmp = compare_uuids(&state->toc[mid].uuid, uuid);
+		if (cmp == 0) {
+			return &state->toc[mid];
+		}
+
+		if (cmp < 0) {
+			low = mid + 1U;
+		} else {
+			high = mid;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Read the whole ToC and build the lookup index. Entries are fetched in
+ * batches, the backend is positioned right after the FIP header. If the
+ * ToC does not fit into the index, the index is left invalid and the
+ * files are looked up directly into the ToC.
+ */
+static int fip_toc_index_build(fip_dev_state_t *state, uintptr_t backend_handle)
+{
+	static const uuid_t uuid_null = { {0} }; /* Double braces for clang */
+	fip_toc_entry_t entries[FIP_TOC_READ_ENTRIES];
+	size_t bytes_read, i, n;
+	int result;
+
+	state->toc_entries = 0U;
+	state->toc_valid = false;
+
+	for (;;) {
+		result = io_read(backend_handle, (uintptr_t)entries,
+				 sizeof(entries), &bytes_read);
+		if (result != 0) {
+			WARN("Failed to read FIP (%i)\n", result);
+			return result;
+		}
+
+		n = bytes_read / sizeof(entries[0]);
+		if (n == 0U) {
+			WARN("Firmware Image Package ToC is not terminated\n");
+			return -ENOENT;
+		}
+
+		for (i = 0U; i < n; i++) {
+			if (compare_uuids(&entries[i].uuid, &uuid_null) == 0) {
+				state->toc_valid = true;
+				return 0;
+			}
+
+			if (state->toc_entries == (unsigned int)FIP_TOC_INDEX_SIZE) {
+				VERBOSE("FIP ToC index is full\n");
+				return 0;
+			}
+
+			fip_toc_index_add(state, &entries[i]);
+		}
+	}
+}
+#endif /* FIP_TOC_INDEX_SIZE */
+
 /* Do some basic package checks. */
 static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params)
 {
@@ -236,6 +358,17 @@ static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params)
 		goto fip_dev_init_exit;
 	}
 
+#if FIP_TOC_INDEX_SIZE
+	/* The package was already checked and indexed */
+	if (state->toc_valid &&
+	    (state->toc_dev_handle == backend_dev_handle) &&
+	    (state->toc_image_spec == backend_image_spec)) {
+		goto fip_dev_init_exit;
+	}
+
+	state->toc_valid = false;
+#endif
+
 	/* Attempt to access the FIP image */
 	result = io_open(backend_dev_handle, backend_image_spec,
 			 &backend_handle);
@@ -258,6 +391,17 @@ static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params)
 			 * bits [32-47] in fip header.
 			 */
 			state->plat_toc_flag = (header.flags >> 32) & 0xffff;
+
+#if FIP_TOC_INDEX_SIZE
+			/* The ToC directly follows the header */
+			result = fip_toc_index_build(state, backend_handle);
+			if (result != 0) {
+				result = -ENOENT;
+			} else {
+				state->toc_dev_handle = backend_dev_handle;
+				state->toc_image_spec = backend_image_spec;
+			}
+#endif
 		}
 	}
 
@@ -280,38 +424,35 @@ static int fip_dev_close(io_dev_info_t *dev_info)
 }
 
 
-/* Open a file for access from package. */
-static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
-			 io_entity_t *entity)
+static fip_file_state_t *allocate_file_state(void)
+{
+	unsigned int i;
+
+	for (i = 0U; i < (unsigned int)MAX_FIP_FILES; i++) {
+		if (fip_files[i].entry.offset_address == 0U) {
+			return &fip_files[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Look up a file directly into the ToC stored in the package */
+static int fip_toc_scan(const uuid_t *uuid, fip_toc_entry_t *entry)
 {
 	int result;
 	uintptr_t backend_handle;
-	const io_uuid_spec_t *uuid_spec = (io_uuid_spec_t *)spec;
 	static const uuid_t uuid_null = { {0} }; /* Double braces for clang */
 	size_t bytes_read;
 	int found_file = 0;
 
-	assert(uuid_spec != NULL);
-	assert(entity != NULL);
-
-	/* Can only have one file open at a time for the moment. We need to
-	 * track state like file cursor position. We know the header lives at
-	 * offset zero, so this entry should never be zero for an active file.
-	 * When the system supports dynamic memory allocation we can allow more
-	 * than one open file at a time if needed.
-	 */
-	if (current_fip_file.entry.offset_address != 0U) {
-		WARN("fip_file_open : Only one open file at a time.\n");
-		return -ENFILE;
-	}
-
 	/* Attempt to access the FIP image */
 	result = io_open(backend_dev_handle, backend_image_spec,
 			 &backend_handle);
 	if (result != 0) {
 		WARN("Failed to open Firmware Image Package (%i)\n", result);
 		result = -ENOENT;
-		goto fip_file_open_exit;
+		goto fip_toc_scan_exit;
 	}
 
 	/* Seek past the FIP header into the Table of Contents */
@@ -320,48 +461,95 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 	if (result != 0) {
 		WARN("fip_file_open: failed to seek\n");
 		result = -ENOENT;
-		goto fip_file_open_close;
+		goto fip_toc_scan_close;
 	}
 
-	found_file = 0;
 	do {
-		result = io_read(backend_handle,
-				 (uintptr_t)&current_fip_file.entry,
-				 sizeof(current_fip_file.entry),
-				 &bytes_read);
+		result = io_read(backend_handle, (uintptr_t)entry,
+				 sizeof(*entry), &bytes_read);
 		if (result == 0) {
-			if (compare_uuids(&current_fip_file.entry.uuid,
-					  &uuid_spec->uuid) == 0) {
+			if (compare_uuids(&entry->uuid, uuid) == 0) {
 				found_file = 1;
 			}
 		} else {
 			WARN("Failed to read FIP (%i)\n", result);
-			goto fip_file_open_close;
+			goto fip_toc_scan_close;
 		}
 	} while ((found_file == 0) &&
-			(compare_uuids(&current_fip_file.entry.uuid,
-				&uuid_null) != 0));
-
-	if (found_file == 1) {
-		/* All fine. Update entity info with file state and return. Set
-		 * the file position to 0. The 'current_fip_file.entry' holds
-		 * the base and size of the file.
-		 */
-		current_fip_file.file_pos = 0;
-		entity->info = (uintptr_t)&current_fip_file;
-	} else {
-		/* Did not find the file in the FIP. */
-		current_fip_file.entry.offset_address = 0;
+			(compare_uuids(&entry->uuid, &uuid_null) != 0));
+
+	if (found_file == 0) {
 		result = -ENOENT;
 	}
 
- fip_file_open_close:
+ fip_toc_scan_close:
 	io_close(backend_handle);
 
- fip_file_open_exit:
+ fip_toc_scan_exit:
 	return result;
 }
 
+/* Look up a file in the ToC index, or directly into the ToC */
+static int fip_toc_lookup(const fip_dev_state_t *state, const uuid_t *uuid,
+			  fip_toc_entry_t *entry)
+{
+#if FIP_TOC_INDEX_SIZE
+	const fip_toc_index_entry_t *index_entry;
+
+	if (state->toc_valid) {
+		index_entry = fip_toc_index_find(state, uuid);
+		if (index_entry == NULL) {
+			return -ENOENT;
+		}
+
+		entry->uuid = index_entry->uuid;
+		entry->offset_address = index_entry->offset_address;
+		entry->size = index_entry->size;
+		entry->flags = 0U;
+
+		return 0;
+	}
+#endif
+
+	return fip_toc_scan(uuid, entry);
+}
+
+/* Open a file for access from package. */
+static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
+			 io_entity_t *entity)
+{
+	int result;
+	const io_uuid_spec_t *uuid_spec = (io_uuid_spec_t *)spec;
+	fip_file_state_t *fp;
+
+	assert(dev_info != NULL);
+	assert(uuid_spec != NULL);
+	assert(entity != NULL);
+
+	fp = allocate_file_state();
+	if (fp == NULL) {
+		WARN("fip_file_open : Too many open files.\n");
+		return -ENFILE;
+	}
+
+	result = fip_toc_lookup((fip_dev_state_t *)dev_info->info,
+				&uuid_spec->uuid, &fp->entry);
+	if (result != 0) {
+		/* Did not find the file in the FIP. */
+		zeromem(fp, sizeof(*fp));
+		return result;
+	}
+
+	/* All fine. Update entity info with file state and return. Set
+	 * the file position to 0. The 'fp->entry' holds the base and size
+	 * of the file.
+	 */
+	fp->file_pos = 0;
+	entity->info = (uintptr_t)fp;
+
+	return 0;
+}
+
 
 /* Return the size of a file in package */
 static int fip_file_len(io_entity_t *entity, size_t *length)
@@ -434,11 +622,13 @@ static int fip_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 /* Close a file in package */
 static int fip_file_close(io_entity_t *entity)
 {
-	/* Clear our current file pointer.
+	assert(entity != NULL);
+
+	/* Release the file state.
 	 * If we had malloc() we would free() here.
 	 */
-	if (current_fip_file.entry.offset_address != 0U) {
-		zeromem(&current_fip_file, sizeof(current_fip_file));
+	if (entity->info != (uintptr_t)NULL) {
+		zeromem((void *)entity->info, sizeof(fip_file_state_t));
 	}
 
 	/* Clear the Entity info. */
@@ -30,6 +30,8 @@ static unsigned int mmc_ocr_value;
 static struct mmc_csd_emmc mmc_csd;
 static struct sd_switch_status sd_switch_func_status;
 static unsigned char mmc_ext_csd[512] __aligned(16);
+/* Read back while probing a bus timing, keeps mmc_ext_csd intact on failure */
+static unsigned char mmc_ext_csd_check[512] __aligned(16);
 static unsigned int mmc_flags;
 static struct mmc_device_info *mmc_dev_info;
 static unsigned int rca;
@@ -255,6 +257,36 @@ static int mmc_set_ios(unsigned int clk, unsigned int bus_width)
 	return ops->set_ios(clk, width);
 }
 
+static int mmc_read_ext_csd(unsigned char *ext_csd)
+{
+	int ret;
+
+	ret = ops->prepare(0, (uintptr_t)ext_csd, sizeof(mmc_ext_csd));
+	if (ret != 0) {
+		return ret;
+	}
+
+	/* MMC CMD8: SEND_EXT_CSD */
+	ret = mmc_send_cmd(MMC_CMD(8), 0, MMC_RESPONSE_R1, NULL);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = ops->read(0, (uintptr_t)ext_csd, sizeof(mmc_ext_csd));
+	if (ret != 0) {
+		return ret;
+	}
+
+	do {
+		ret = mmc_device_state();
+		if (ret < 0) {
+			return ret;
+		}
+	} while (ret != MMC_STATE_TRAN);
+
+	return 0;
+}
+
 static int mmc_fill_device_info(void)
 {
 	unsigned long long c_size;
@@ -268,31 +300,11 @@ static int mmc_fill_device_info(void)
 	case MMC_IS_EMMC:
 		mmc_dev_info->block_size = MMC_BLOCK_SIZE;
 
-		ret = ops->prepare(0, (uintptr_t)&mmc_ext_csd,
-				   sizeof(mmc_ext_csd));
+		ret = mmc_read_ext_csd(mmc_ext_csd);
 		if (ret != 0) {
 			return ret;
 		}
 
-		/* MMC CMD8: SEND_EXT_CSD */
-		ret = mmc_send_cmd(MMC_CMD(8), 0, MMC_RESPONSE_R1, NULL);
-		if (ret != 0) {
-			return ret;
-		}
-
-		ret = ops->read(0, (uintptr_t)&mmc_ext_csd,
-				sizeof(mmc_ext_csd));
-		if (ret != 0) {
-			return ret;
-		}
-
-		do {
-			ret = mmc_device_state();
-			if (ret < 0) {
-				return ret;
-			}
-		} while (ret != MMC_STATE_TRAN);
-
 		nb_blocks = (mmc_ext_csd[CMD_EXTCSD_SEC_CNT] << 0) |
 			    (mmc_ext_csd[CMD_EXTCSD_SEC_CNT + 1] << 8) |
 			    (mmc_ext_csd[CMD_EXTCSD_SEC_CNT + 2] << 16) |
@@ -365,6 +377,171 @@ static int mmc_fill_device_info(void)
 	return 0;
 }
 
+static const char *mmc_timing_name(unsigned int timing)
+{
+	switch (timing) {
+	case MMC_TIMING_HS:
+		return "HS52";
+	case MMC_TIMING_DDR52:
+		return "DDR52";
+	case MMC_TIMING_HS200:
+		return "HS200";
+	default:
+		return "legacy";
+	}
+}
+
+static bool mmc_emmc_timing_supported(unsigned int timing)
+{
+	unsigned int card_type = mmc_ext_csd[CMD_EXTCSD_DEVICE_TYPE];
+
+	if ((mmc_dev_info->timing_caps & MMC_TIMING_CAP(timing)) == 0U) {
+		return false;
+	}
+
+	switch (timing) {
+	case MMC_TIMING_HS:
+		return (card_type & EXT_CSD_CARD_TYPE_HS_52) != 0U;
+	case MMC_TIMING_DDR52:
+		return (card_type & EXT_CSD_CARD_TYPE_DDR_52) != 0U;
+	case MMC_TIMING_HS200:
+		return (card_type & EXT_CSD_CARD_TYPE_HS200) != 0U;
+	default:
+		return false;
+	}
+}
+
+static int mmc_host_set_timing(unsigned int timing, unsigned int freq)
+{
+	mmc_dev_info->timing = timing;
+	mmc_dev_info->max_bus_freq = freq;
+
+	return ops->set_timing(timing);
+}
+
+/*
+ * Switch both the device and the host to one of the eMMC high speed timings.
+ * DDR52 is entered from HS52 by switching the device to a DDR bus width.
+ */
+static int mmc_emmc_set_timing(unsigned int timing, unsigned int bus_width)
+{
+	unsigned int hs_timing = EXT_CSD_TIMING_HS;
+	unsigned int freq = MMC_HS_MAX_FREQ;
+	unsigned int ddr_width = MMC_BUS_WIDTH_DDR_8;
+	int ret;
+
+	if (timing == MMC_TIMING_HS200) {
+		hs_timing = EXT_CSD_TIMING_HS200;
+		freq = MMC_HS200_MAX_FREQ;
+	}
+
+	ret = mmc_set_ext_csd(CMD_EXTCSD_HS_TIMING, hs_timing);
+	if (ret != 0) {
+		return ret;
+	}
+
+	if (timing != MMC_TIMING_DDR52) {
+		ret = mmc_host_set_timing(timing, freq);
+	} else {
+		ret = mmc_host_set_timing(MMC_TIMING_HS, freq);
+	}
+	if (ret != 0) {
+		return ret;
+	}
+
+	if (timing == MMC_TIMING_DDR52) {
+		if (bus_width == MMC_BUS_WIDTH_4) {
+			ddr_width = MMC_BUS_WIDTH_DDR_4;
+		}
+
+		ret = mmc_set_ext_csd(CMD_EXTCSD_BUS_WIDTH, ddr_width);
+		if (ret != 0) {
+			return ret;
+		}
+
+		ret = mmc_host_set_timing(MMC_TIMING_DDR52, freq);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	/* Make sure the data path works at the new speed */
+	ret = mmc_read_ext_csd(mmc_ext_csd_check);
+	if (ret != 0) {
+		return ret;
+	}
+
+	if (mmc_ext_csd_check[CMD_EXTCSD_HS_TIMING] != hs_timing) {
+		return -EIO;
+	}
+
+	return 0;
+}
+
+/*
+ * Go back to the legacy timing. A DDR bus width is only valid in the HS
+ * timing, so the device is switched back to an SDR bus width first.
+ */
+static int mmc_emmc_set_legacy_timing(unsigned int clk, unsigned int bus_width)
+{
+	int ret;
+
+	ret = mmc_host_set_timing(MMC_TIMING_LEGACY, clk);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = mmc_set_ext_csd(CMD_EXTCSD_BUS_WIDTH, bus_width);
+	if (ret != 0) {
+		return ret;
+	}
+
+	return mmc_set_ext_csd(CMD_EXTCSD_HS_TIMING, EXT_CSD_TIMING_LEGACY);
+}
+
+/*
+ * Try the fastest timing supported by both the host and the device, falling
+ * back to the next one on failure.
+ */
+static int mmc_emmc_select_timing(unsigned int clk, unsigned int bus_width)
+{
+	static const unsigned int timings[] = {
+		MMC_TIMING_HS200,
+		MMC_TIMING_DDR52,
+		MMC_TIMING_HS,
+	};
+	unsigned int i;
+	int ret;
+
+	if ((ops->set_timing == NULL) || (mmc_csd.spec_vers != 4U)) {
+		return 0;
+	}
+
+	for (i = 0U; i < ARRAY_SIZE(timings); i++) {
+		if (!mmc_emmc_timing_supported(timings[i])) {
+			continue;
+		}
+
+		ret = mmc_emmc_set_timing(timings[i], bus_width);
+		if (ret == 0) {
+			INFO("eMMC: %s mode, %u Hz\n",
+			     mmc_timing_name(timings[i]),
+			     mmc_dev_info->max_bus_freq);
+			return 0;
+		}
+
+		WARN("eMMC: failed to enter %s mode (%d)\n",
+		     mmc_timing_name(timings[i]), ret);
+
+		ret = mmc_emmc_set_legacy_timing(clk, bus_width);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
 static int sd_switch(unsigned int mode, unsigned char group,
 		     unsigned char func)
 {
@@ -614,13 +791,27 @@ static int mmc_enumerate(unsigned int clk, unsigned int bus_width)
 
 		INFO("Switch to 50 MHz SD frequency (High Speed Mode)\n");
 		mmc_dev_info->max_bus_freq = 50000000U;
+		mmc_dev_info->timing = MMC_TIMING_HS;
 		ret = ops->set_ios(clk, bus_width);
+		if (ret != 0) {
+			return ret;
+		}
+
+		/* Make sure the data path works at the new speed */
+		ret = sd_switch(SD_SWITCH_FUNC_CHECK, 1U, 1U);
+		if (ret != 0) {
+			WARN("SD High Speed Mode failed, defaulting to 25 MHz SD frequency\n");
+			goto set_original_freq;
+		}
+	} else if (mmc_dev_info->mmc_dev_type == MMC_IS_EMMC) {
+		ret = mmc_emmc_select_timing(clk, bus_width);
 	}
 
 	return ret;
 
 set_original_freq:
 	mmc_dev_info->max_bus_freq = clk;
+	mmc_dev_info->timing = MMC_TIMING_LEGACY;
 	ret = ops->set_ios(clk, bus_width);
 
 	return ret;
@@ -887,6 +1078,7 @@ int mmc_init(const struct mmc_ops *ops_ptr, unsigned int clk,
 	ops = ops_ptr;
 	mmc_flags = flags;
 	mmc_dev_info = device_info;
+	mmc_dev_info->timing = MMC_TIMING_LEGACY;
 
 	return mmc_enumerate(clk, width);
 }
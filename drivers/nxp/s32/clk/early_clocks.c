@@ -9,6 +9,9 @@
 #include <drivers/scmi-msg.h>
 #include <s32_bl_common.h>
 #include <s32cc_clocks.h>
+#if (S32_CLK_SCRIPT == 1)
+#include <s32cc_clk_script.h>
+#endif
 
 #define CLK_INIT(ID)          \
 {                             \
@@ -165,6 +168,20 @@ int s32_a53_clock_setup(void)
 	return s32_enable_a53_clock();
 }
 
+/*
+ * With S32_CLK_SCRIPT, the clocks enabled by s32_periph_clock_init() are
+ * programmed in one go by replaying a sequence built from the same settings.
+ * Only the references are taken here, for the clocks to stay on.
+ */
+static int enable_boot_clock(struct clk *c)
+{
+#if (S32_CLK_SCRIPT == 1)
+	return s32gen1_enable_refs(c);
+#else
+	return s32gen1_enable(c, 1);
+#endif
+}
+
 static int enable_lin_clock(void)
 {
 	int ret;
@@ -187,7 +204,7 @@ static int enable_lin_clock(void)
 	if (rate != S32GEN1_LIN_BAUD_CLK_FREQ)
 		return -EINVAL;
 
-	return s32gen1_enable(&lin_baud, 1);
+	return enable_boot_clock(&lin_baud);
 }
 
 static int setup_periph_pll(void)
@@ -225,7 +242,7 @@ static int enable_sdhc_clock(void)
 	if (rate != sdhc_clk_freq)
 		return -EINVAL;
 
-	return s32gen1_enable(&sdhc, 1);
+	return enable_boot_clock(&sdhc);
 }
 
 static int enable_qspi_clock(void)
@@ -245,10 +262,10 @@ static int enable_qspi_clock(void)
 	if (rate != S32GEN1_QSPI_CLK_FREQ)
 		return -EINVAL;
 
-	return s32gen1_enable(&qspi, 1);
+	return enable_boot_clock(&qspi);
 }
 
-static int s32_set_ddr_clock_state(int enable)
+static int setup_ddr_clock(void)
 {
 	int ret;
 	unsigned long rate;
@@ -269,6 +286,17 @@ static int s32_set_ddr_clock_state(int enable)
 	if (rate != S32GEN1_DDR_FREQ)
 		return -EINVAL;
 
+	return 0;
+}
+
+static int s32_set_ddr_clock_state(int enable)
+{
+	int ret;
+
+	ret = setup_ddr_clock();
+	if (ret)
+		return ret;
+
 	return s32gen1_enable(&ddr, enable);
 }
 
@@ -290,6 +318,32 @@ int s32_reset_ddr_periph(void)
 	return ret;
 }
 
+int s32_assert_ddr_reset(void)
+{
+	int ret;
+
+	ret = plat_scmi_rstd_set_state(0, S32CC_SCMI_RST_DDR, true);
+	if (ret)
+		ERROR("Failed to assert DDR reset (%d)\n", ret);
+
+	return ret;
+}
+
+static int replay_boot_clock_script(void)
+{
+#if (S32_CLK_SCRIPT == 1)
+	int ret;
+
+	ret = s32_reg_script_run(s32_boot_clk_script, s32_boot_clk_script_len);
+	if (ret)
+		return ret;
+
+	/* Nothing read from the hardware before the replay holds anymore */
+	s32gen1_clk_invalidate_rates();
+#endif
+	return 0;
+}
+
 int s32_a53_clock_early_setup(void)
 {
 	int ret;
@@ -332,5 +386,13 @@ int s32_periph_clock_init(void)
 			return ret;
 	}
 
-	return s32_enable_ddr_clock();
+	ret = setup_ddr_clock();
+	if (ret)
+		return ret;
+
+	ret = enable_boot_clock(&ddr);
+	if (ret)
+		return ret;
+
+	return replay_boot_clock_script();
 }
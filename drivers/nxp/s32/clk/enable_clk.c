@@ -1363,6 +1363,22 @@ static const enable_clk_t enable_clbs[] = {
 	[s32gen1_pll_out_div_t] = enable_pll_div,
 };
 
+/*
+ * Set while taking the references of clocks whose hardware was programmed by
+ * other means, see s32gen1_enable_refs(). The links are still followed, to
+ * reach the partition tree.
+ */
+static bool refs_only;
+
+static enable_clk_t get_enable_clb(uint32_t index)
+{
+	if (refs_only && index != s32gen1_part_link_t &&
+	    index != s32gen1_part_block_link_t)
+		return no_enable;
+
+	return enable_clbs[index];
+}
+
 static enum en_order get_en_order(struct s32gen1_clk_obj *module, int enable)
 {
 	if (enable)
@@ -1380,9 +1396,17 @@ static int exec_cb_with_refcount(enable_clk_t en_cb, struct s32gen1_clk_obj *mod
 	if (!mod)
 		return 0;
 
-	/* Refcount will be updated as part of the recursivity */
-	if (leaf_node)
-		return en_cb(mod, priv, enable);
+	/*
+	 * Refcount will be updated as part of the recursivity.
+	 * The callback may reprogram the module, don't let it nor the
+	 * subsequent readers rely on a cached rate.
+	 */
+	if (leaf_node) {
+		s32gen1_clk_invalidate_rate(mod);
+		ret = en_cb(mod, priv, enable);
+		s32gen1_clk_invalidate_rate(mod);
+		return ret;
+	}
 
 	if (enable) {
 		if (!mod->refcount)
@@ -1441,10 +1465,10 @@ static int enable_module(struct s32gen1_clk_obj *module,
 	if (order == PARENT_FIRST) {
 		first_en = enable_module;
 		first_mod = parent;
-		second_en = enable_clbs[index];
+		second_en = get_enable_clb(index);
 		second_mod = module;
 	} else {
-		first_en = enable_clbs[index];
+		first_en = get_enable_clb(index);
 		first_mod = module;
 		second_en = enable_module;
 		second_mod = parent;
@@ -1499,3 +1523,13 @@ int s32gen1_enable(struct clk *c, int enable)
 	return ret;
 }
 
+int s32gen1_enable_refs(struct clk *c)
+{
+	int ret;
+
+	refs_only = true;
+	ret = s32gen1_enable(c, 1);
+	refs_only = false;
+
+	return ret;
+}
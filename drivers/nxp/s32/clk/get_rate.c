@@ -8,8 +8,38 @@
 #include <lib/utils_def.h>
 #include <s32_fp.h>
 #include <stdint.h>
+#include <string.h>
 #include <inttypes.h>
 
+/*
+ * Generation of the cached rates. Zero marks an invalid entry, while bumping
+ * the generation drops all the entries at once, e.g. after the clock tree was
+ * reprogrammed by a suspend/resume cycle.
+ */
+static uint32_t rate_cache_gen = 1U;
+
+#define RATES_CACHE_ENTRIES	(16U)
+
+/*
+ * Rate tables of the clocks with frequency scaling, as reported by
+ * s32gen1_get_rates(). A table is derived from the rate of the divider that
+ * scales the clock and from the rate of its parent, so it stays valid as
+ * long as both keep their rates. The entries are recycled in a round-robin
+ * fashion.
+ */
+struct rates_cache_entry {
+	struct s32gen1_clk *clk;
+	struct s32gen1_clk_obj *div;
+	uint32_t gen;
+	unsigned long prate;
+	unsigned long rate;
+	size_t nrates;
+	unsigned long rates[S32GEN1_MAX_NUM_FREQ];
+};
+
+static struct rates_cache_entry rates_cache[RATES_CACHE_ENTRIES];
+static size_t rates_cache_next;
+
 static inline bool is_div(struct s32gen1_clk_obj *module)
 {
 	if (!module)
@@ -629,14 +659,9 @@ static unsigned long get_cgm_div_freq(struct s32gen1_clk_obj *module,
 	return calc_cgm_div_freq(pfreq, cgm_addr, mux->index, div->index);
 }
 
-unsigned long get_module_rate(struct s32gen1_clk_obj *module,
-		      struct s32gen1_clk_priv *priv)
+static unsigned long compute_module_rate(struct s32gen1_clk_obj *module,
+					 struct s32gen1_clk_priv *priv)
 {
-	if (!module) {
-		ERROR("Invalid module\n");
-		return 0ul;
-	}
-
 	switch (module->type) {
 	case s32gen1_cgm_sw_ctrl_mux_t:
 	case s32gen1_shared_mux_t:
@@ -675,6 +700,54 @@ unsigned long get_module_rate(struct s32gen1_clk_obj *module,
 	return 0u;
 }
 
+/*
+ * Rates are cached per module. A module's rate only depends on its own
+ * settings and on the rate of its parent, hence an entry stays valid as long
+ * as the module isn't reconfigured and its parent keeps the same rate.
+ * Reconfiguring a module only drops its own entry, the modules below it will
+ * see a different parent rate and refresh theirs.
+ */
+unsigned long get_module_rate(struct s32gen1_clk_obj *module,
+		      struct s32gen1_clk_priv *priv)
+{
+	struct s32gen1_clk_obj *parent;
+	unsigned long prate = 0ul, rate;
+
+	if (!module) {
+		ERROR("Invalid module\n");
+		return 0ul;
+	}
+
+	parent = get_module_parent(module);
+	if (parent)
+		prate = get_module_rate(parent, priv);
+
+	if (module->rate_gen == rate_cache_gen && module->prate == prate)
+		return module->rate;
+
+	rate = compute_module_rate(module, priv);
+	if (rate) {
+		module->rate = rate;
+		module->prate = prate;
+		module->rate_gen = rate_cache_gen;
+	}
+
+	return rate;
+}
+
+void s32gen1_clk_invalidate_rate(struct s32gen1_clk_obj *module)
+{
+	if (module)
+		module->rate_gen = 0U;
+}
+
+void s32gen1_clk_invalidate_rates(void)
+{
+	rate_cache_gen++;
+	if (!rate_cache_gen)
+		rate_cache_gen = 1U;
+}
+
 static struct s32gen1_clk *get_leaf_clk(struct clk *c)
 {
 	struct s32gen1_clk *clk;
@@ -714,18 +787,100 @@ static int get_available_frequencies(struct s32gen1_clk_obj *module, struct s32g
 	}
 }
 
-static int get_clk_frequencies(struct s32gen1_clk_obj *module,
+/* The first divider above the clock that isn't shared with other clocks */
+static struct s32gen1_clk_obj *get_scaling_div(struct s32gen1_clk_obj *module)
+{
+	while (module) {
+		if (is_div(module) && module->refcount == 1)
+			return module;
+
+		module = get_module_parent(module);
+	}
+
+	return NULL;
+}
+
+static struct rates_cache_entry *find_cached_rates(struct s32gen1_clk *clk,
+						   struct s32gen1_clk_obj *div,
+						   unsigned long prate,
+						   unsigned long rate)
+{
+	struct rates_cache_entry *entry;
+	size_t i;
+
+	for (i = 0; i < ARRAY_SIZE(rates_cache); i++) {
+		entry = &rates_cache[i];
+
+		if (entry->clk == clk && entry->div == div &&
+		    entry->gen == rate_cache_gen && entry->prate == prate &&
+		    entry->rate == rate)
+			return entry;
+	}
+
+	return NULL;
+}
+
+static void cache_rates(struct s32gen1_clk *clk, struct s32gen1_clk_obj *div,
+			unsigned long prate, unsigned long rate,
+			struct s32gen1_clk_rates *clk_rates)
+{
+	struct rates_cache_entry *entry = NULL;
+	size_t i;
+
+	/* Replace the stale table of the same clock, if any */
+	for (i = 0; i < ARRAY_SIZE(rates_cache); i++) {
+		if (rates_cache[i].clk == clk) {
+			entry = &rates_cache[i];
+			break;
+		}
+	}
+
+	if (!entry) {
+		entry = &rates_cache[rates_cache_next];
+		rates_cache_next = (rates_cache_next + 1) %
+				   ARRAY_SIZE(rates_cache);
+	}
+
+	entry->clk = clk;
+	entry->div = div;
+	entry->gen = rate_cache_gen;
+	entry->prate = prate;
+	entry->rate = rate;
+	entry->nrates = *clk_rates->nrates;
+	memcpy(entry->rates, clk_rates->rates,
+	       entry->nrates * sizeof(entry->rates[0]));
+}
+
+static int get_clk_frequencies(struct s32gen1_clk *clk,
 	struct s32gen1_clk_priv *priv, struct s32gen1_clk_rates *clk_rates)
 {
-	struct s32gen1_clk_obj *parent = get_module_parent(module);
+	struct rates_cache_entry *entry;
+	struct s32gen1_clk_obj *div;
+	unsigned long prate, rate;
+	int ret;
 
-	if (!module)
+	div = get_scaling_div(&clk->desc);
+	if (!div)
 		return 0;
 
-	if (is_div(module) && module->refcount == 1)
-		return get_available_frequencies(module, priv, clk_rates);
+	prate = get_module_rate(get_module_parent(div), priv);
+	rate = get_module_rate(div, priv);
 
-	return get_clk_frequencies(parent, priv, clk_rates);
+	entry = find_cached_rates(clk, div, prate, rate);
+	if (entry) {
+		memcpy(clk_rates->rates, entry->rates,
+		       entry->nrates * sizeof(entry->rates[0]));
+		*clk_rates->nrates = entry->nrates;
+		return 0;
+	}
+
+	ret = get_available_frequencies(div, priv, clk_rates);
+	if (ret)
+		return ret;
+
+	cache_rates(clk, div, prate, rate, clk_rates);
+
+	return 0;
 }
 
 unsigned long s32gen1_get_rate(struct clk *c)
@@ -793,7 +948,7 @@ int s32gen1_get_rates(struct clk *c, struct s32gen1_clk_rates *clk_rates)
 	if (!clk->freq_scaling)
 		return 0;
 
-	ret = get_clk_frequencies(&clk->desc, priv, clk_rates);
+	ret = get_clk_frequencies(clk, priv, clk_rates);
 	if (ret)
 		WARN("Could not compute available rates for clock %" PRIu32 ".\n", c->id);
 
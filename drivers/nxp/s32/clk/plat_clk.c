@@ -190,7 +190,7 @@ static int bind_clk_provider(struct s32gen1_clk_driver *drv, void *fdt,
 {
 	struct dt_node_info info;
 
-	*node = fdt_node_offset_by_compatible(fdt, -1, compatible);
+	*node = dt_node_offset_by_compatible(fdt, -1, compatible);
 	if (*node == -1) {
 		ERROR("Failed to get '%s' node\n", compatible);
 		return -EIO;
@@ -323,7 +323,7 @@ int dt_init_plat_clk(void *fdt)
 	static struct s32gen1_clk_driver clk_drv;
 	int node;
 
-	node = fdt_node_offset_by_compatible(fdt, -1, "nxp,s32cc-clocking");
+	node = dt_node_offset_by_compatible(fdt, -1, "nxp,s32cc-clocking");
 	if (node == -1) {
 		ERROR("Failed to detect S32-GEN1 clock compatible.\n");
 		return -EIO;
@@ -232,6 +232,8 @@ static unsigned long set_part_block_link_freq(struct s32gen1_clk_obj *module,
 static unsigned long set_module_rate(struct s32gen1_clk_obj *module,
 				     unsigned long rate)
 {
+	s32gen1_clk_invalidate_rate(module);
+
 	switch (module->type) {
 	case s32gen1_fixed_clk_t:
 		return set_fixed_clk_freq(module, rate);
@@ -402,5 +404,7 @@ int s32gen1_set_parent(struct clk *c, struct clk *p)
 	}
 
 	mux->source_id = p->id;
+	s32gen1_clk_invalidate_rate(&mux->desc);
+
 	return 0;
 }
@@ -208,6 +208,52 @@ uint32_t load_dq_cfg(size_t size, const struct dqconf cfg[])
 	return NO_ERR;
 }
 
+#if (S32_DDR_FW_PACKED == 1)
+/*
+ * The PHY images are packed at build time by ddr_fw_pack.py into runs, each
+ * one introduced by a header halfword: either 'count' literal halfwords
+ * follow, or a single halfword to be written 'count' times.
+ */
+#define FW_RUN_FILL		0x8000U
+#define FW_RUN_COUNT_MASK	0x7FFFU
+
+/* Unpack image into memory at consecutive addresses */
+static uint32_t load_phy_image(uint32_t start_addr, size_t size,
+			       const uint16_t image[])
+{
+	const uint16_t *src = image, *end = image + size;
+	uintptr_t addr = (uintptr_t)start_addr;
+	uint16_t hdr, val;
+	size_t count;
+
+	while (src < end) {
+		hdr = *src++;
+		count = hdr & FW_RUN_COUNT_MASK;
+
+		if ((hdr & FW_RUN_FILL) != 0U) {
+			if (src == end)
+				return INVALID_IMAGE;
+
+			val = *src++;
+			for (; count > 0U; count--) {
+				mmio_write_32(addr, val);
+				addr += sizeof(uint32_t);
+			}
+			continue;
+		}
+
+		if ((size_t)(end - src) < count)
+			return INVALID_IMAGE;
+
+		for (; count > 0U; count--) {
+			mmio_write_32(addr, *src++);
+			addr += sizeof(uint32_t);
+		}
+	}
+
+	return NO_ERR;
+}
+#else
 /* Load image into memory at consecutive addresses */
 static uint32_t load_phy_image(uint32_t start_addr, size_t size,
 			       const uint16_t image[])
@@ -221,6 +267,7 @@ static uint32_t load_phy_image(uint32_t start_addr, size_t size,
 	}
 	return NO_ERR;
 }
+#endif
 
 /* Ensure optimal phy pll settings. */
 void set_optimal_pll(void)
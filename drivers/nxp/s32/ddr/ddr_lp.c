@@ -246,10 +246,25 @@ void ddrss_to_io_retention_mode(void)
 	ddrss_gpr_to_io_retention_mode();
 }
 
-/* Transition the DDR SubSystem from retention mode to normal mode. */
-uint32_t ddrss_to_normal_mode(uintptr_t csr_array)
+/*
+ * Reprogram the DDR SubSystem from a CSR/DDRC snapshot taken after a previous
+ * training. When coming out of retention, the DRAM content is preserved and
+ * the device is still in self-refresh, so both the DRAM initialization and the
+ * memory scrubbing are skipped.
+ *
+ * On cold boot, the PHY firmware doesn't run, hence nothing initializes the
+ * DRAM devices unless the controller does. ddrc_cfg skips the DRAM
+ * initialization, so it is re-enabled here: the controller then resets the
+ * devices, writes the mode registers from INIT3..INIT7 and runs the ZQ
+ * calibration. INIT6 and INIT7 come from the snapshot and carry the trained
+ * VrefCA/VrefDQ values. The ECC scrubber runs afterwards, exactly as after
+ * training.
+ */
+static uint32_t restore_trained_settings(uintptr_t csr_array,
+					 bool from_retention)
 {
 	uint32_t pwrctl, init0, ret;
+	uint8_t options = STORE_CSR_DISABLED | ADJUST_DDRC_DISABLED;
 
 	ret = load_register_cfg(ddrc_cfg_size, ddrc_cfg);
 	load_ddrc_regs(csr_array);
@@ -264,12 +279,19 @@ uint32_t ddrss_to_normal_mode(uintptr_t csr_array)
 	mmio_write_32(MICROCONT_MUX_SEL, LOCK_CSR_ACCESS);
 
 	init0 = mmio_read_32(DDRC_BASE_ADDR + OFFSET_DDRC_INIT0);
-	init0 |= SKIP_DRAM_INIT_MASK;
-	mmio_write_32(DDRC_BASE_ADDR + OFFSET_DDRC_INIT0, init0);
-
-	pwrctl = mmio_read_32(DDRC_BASE_ADDR + OFFSET_DDRC_PWRCTL);
-	mmio_write_32(DDRC_BASE_ADDR + OFFSET_DDRC_PWRCTL,
-		      pwrctl | SELFREF_SW_MASK);
+	if (from_retention) {
+		init0 |= SKIP_DRAM_INIT_MASK;
+		mmio_write_32(DDRC_BASE_ADDR + OFFSET_DDRC_INIT0, init0);
+
+		pwrctl = mmio_read_32(DDRC_BASE_ADDR + OFFSET_DDRC_PWRCTL);
+		mmio_write_32(DDRC_BASE_ADDR + OFFSET_DDRC_PWRCTL,
+			      pwrctl | SELFREF_SW_MASK);
+	} else {
+		init0 &= ~SKIP_DRAM_INIT_MASK;
+		mmio_write_32(DDRC_BASE_ADDR + OFFSET_DDRC_INIT0, init0);
+
+		options |= INIT_MEM_MASK;
+	}
 
 	/* Setup AXI ports parity */
 	ret = set_axi_parity();
@@ -294,6 +316,17 @@ uint32_t ddrss_to_normal_mode(uintptr_t csr_array)
 
 	mmio_write_32(MICROCONT_MUX_SEL, LOCK_CSR_ACCESS);
 
-	return post_train_setup(STORE_CSR_DISABLED | INIT_MEM_DISABLED |
-				ADJUST_DDRC_DISABLED);
+	return post_train_setup(options);
+}
+
+/* Transition the DDR SubSystem from retention mode to normal mode. */
+uint32_t ddrss_to_normal_mode(uintptr_t csr_array)
+{
+	return restore_trained_settings(csr_array, true);
+}
+
+/* Initialize the DDR SubSystem from previously stored training results. */
+uint32_t ddrss_init_from_snapshot(uintptr_t csr_array)
+{
+	return restore_trained_settings(csr_array, false);
 }
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <arch_helpers.h>
 #include <common/debug.h>
 #include <common/fdt_wrappers.h>
 #include <drivers/nxp/s32/hse/hse_core.h>
@@ -14,6 +15,7 @@
 #include <errno.h>
 #include <hse_interface.h>
 #include <lib/xlat_tables/xlat_tables_v2.h>
+#include <s32_bl_common.h>
 #include <s32cc_platform_def.h>
 #include <stdint.h>
 #include <string.h>
@@ -34,6 +36,10 @@ struct hse_descriptor {
  * struct hse_drvdata - HSE driver private data
  * @srv_desc[n].desc: service descriptor virtual address for channel n
  * @srv_desc[n].paddr: service descriptor physical address for channel n
+ * @queue[n].head: request in flight on channel n, followed by the queued ones
+ * @queue[n].tail: last request queued on channel n
+ * @done.head: oldest completed request not yet collected
+ * @done.tail: newest completed request not yet collected
  * @firmware_version: firmware version
  * @res_mem.paddr: reserved memory start offset
  * @res_mem.size: reserved memory size
@@ -44,6 +50,14 @@ struct hse_drvdata {
 		struct hse_descriptor *desc;
 		uintptr_t paddr;
 	} srv_desc[HSE_CHANNEL_NUM];
+	struct {
+		struct hse_req *head;
+		struct hse_req *tail;
+	} queue[HSE_CHANNEL_NUM];
+	struct {
+		struct hse_req *head;
+		struct hse_req *tail;
+	} done;
 	hseAttrFwVersion_t firmware_version;
 	struct {
 		uintptr_t paddr;
@@ -130,48 +144,278 @@ bool is_secboot_active(void)
 }
 
 /**
- * hse_srv_req_sync - initiate service request and wait for response
+ * hse_req_send - hand over a request to HSE
+ * @req: request at the head of its channel queue
+ *
+ * Return: 0 on success, specific errno code on error
+ */
+static int hse_req_send(struct hse_req *req)
+{
+	enum hse_ch_type channel = req->channel;
+
+	memset(drv.srv_desc[channel].desc, 0, sizeof(*drv.srv_desc[channel].desc));
+	memcpy(drv.srv_desc[channel].desc, &req->srv_desc, sizeof(req->srv_desc));
+
+	return hse_mu_msg_send(channel, drv.srv_desc[channel].paddr);
+}
+
+/**
+ * hse_req_complete - retire a request and start the next one on its channel
+ * @req: request at the head of its channel queue
+ * @status: completion status
+ */
+static void hse_req_complete(struct hse_req *req, int status)
+{
+	enum hse_ch_type channel = req->channel;
+	struct hse_req *next = req->next;
+
+	drv.queue[channel].head = next;
+	if (!next)
+		drv.queue[channel].tail = NULL;
+
+	req->status = status;
+	req->done = true;
+	req->next = NULL;
+
+	if (drv.done.tail)
+		drv.done.tail->next = req;
+	else
+		drv.done.head = req;
+	drv.done.tail = req;
+
+	if (next && hse_req_send(next))
+		hse_req_complete(next, -EIO);
+}
+
+/**
+ * hse_req_collect - remove a completed request from the completion list
+ * @req: completed request
+ */
+static void hse_req_collect(struct hse_req *req)
+{
+	struct hse_req **it = &drv.done.head;
+	struct hse_req *prev = NULL;
+
+	while (*it && *it != req) {
+		prev = *it;
+		it = &(*it)->next;
+	}
+
+	if (!*it)
+		return;
+
+	*it = req->next;
+	if (drv.done.tail == req)
+		drv.done.tail = prev;
+	req->next = NULL;
+}
+
+/**
+ * hse_srv_req_submit - queue a service request without waiting for it
  * @channel: selects channel for the service request
- * @srv_desc: address of service descriptor
+ * @srv_desc: address of service descriptor, copied into @req
+ * @req: request tracking structure, owned by the driver until completed
+ *
+ * Requests submitted on the same channel are handed over to HSE in order,
+ * one at a time. Requests on different channels are processed in parallel.
  *
  * Return: 0 on succes, specific errno code on error
  */
-int hse_srv_req_sync(enum hse_ch_type channel, const hseSrvDescriptor_t *srv_desc)
+int hse_srv_req_submit(enum hse_ch_type channel,
+		       const hseSrvDescriptor_t *srv_desc,
+		       struct hse_req *req)
 {
-	uint32_t srv_rsp;
-	bool is_pending = false;
 	int ret;
 
 	if (!drv.initialized)
 		return -EACCES;
 
-	if (!srv_desc || channel >= HSE_CHANNEL_NUM)
+	if (!srv_desc || !req || channel >= HSE_CHANNEL_NUM)
 		return -EINVAL;
 
-	memset(drv.srv_desc[channel].desc, 0, sizeof(*drv.srv_desc[channel].desc));
-	memcpy(drv.srv_desc[channel].desc, srv_desc, sizeof(*srv_desc));
+	memcpy(&req->srv_desc, srv_desc, sizeof(*srv_desc));
+	req->channel = channel;
+	req->status = 0;
+	req->done = false;
+	req->next = NULL;
+
+	if (drv.queue[channel].tail) {
+		drv.queue[channel].tail->next = req;
+		drv.queue[channel].tail = req;
+		return 0;
+	}
 
-	ret = hse_mu_msg_send(channel, drv.srv_desc[channel].paddr);
+	ret = hse_req_send(req);
 	if (ret)
 		return ret;
 
-	do {
-		ret = hse_mu_msg_pending(channel, &is_pending);
-		if (ret)
-			return ret;
+	drv.queue[channel].head = req;
+	drv.queue[channel].tail = req;
 
-	} while (!is_pending);
+	return 0;
+}
+
+/**
+ * hse_req_poll - collect the responses available on all channels
+ *
+ * A request is only retired once HSE has posted its response, as HSE owns
+ * the channel and its service descriptor until then. The MU accepted the
+ * channel when the request was sent, so an MU error on a busy channel means
+ * the driver state is corrupted and is fatal.
+ */
+static void hse_req_poll(void)
+{
+	struct hse_req *req;
+	bool is_pending;
+	uint32_t srv_rsp;
+	int ret;
+	uint8_t ch;
 
-	ret = hse_mu_msg_recv(channel, &srv_rsp);
+	for (ch = HSE_CHANNEL_ADMIN; ch < HSE_CHANNEL_NUM; ch++) {
+		req = drv.queue[ch].head;
+		if (!req)
+			continue;
+
+		ret = hse_mu_msg_pending(ch, &is_pending);
+		if (!ret && !is_pending)
+			continue;
+
+		if (!ret)
+			ret = hse_mu_msg_recv(ch, &srv_rsp);
+
+		/* HSE may still own the channel, the request can't be retired */
+		if (ret) {
+			ERROR("HSE MU channel %u lost (err %d).\n", ch, ret);
+			panic();
+		}
+
+		if (srv_rsp != HSE_SRV_RSP_OK) {
+			ERROR("HSE Service Request failed (service response: 0x%x).",
+			      srv_rsp);
+			ret = -EINVAL;
+		}
+
+		req->srv_rsp = srv_rsp;
+		hse_req_complete(req, ret);
+	}
+}
+
+/**
+ * hse_wait - wait for a submitted request to complete
+ * @req: request passed to hse_srv_req_submit()
+ *
+ * Return: 0 on succes, specific errno code on error
+ */
+int hse_wait(struct hse_req *req)
+{
+	if (!req)
+		return -EINVAL;
+
+	while (!req->done)
+		hse_req_poll();
+
+	hse_req_collect(req);
+
+	return req->status;
+}
+
+/**
+ * hse_wait_any - wait for any submitted request to complete
+ *
+ * Completed requests are returned in completion order, each one only once.
+ *
+ * Return: completed request, or NULL if no request is outstanding
+ */
+struct hse_req *hse_wait_any(void)
+{
+	struct hse_req *req;
+	uint8_t ch;
+
+	while (!drv.done.head) {
+		for (ch = HSE_CHANNEL_ADMIN; ch < HSE_CHANNEL_NUM; ch++)
+			if (drv.queue[ch].head)
+				break;
+
+		if (ch == HSE_CHANNEL_NUM)
+			return NULL;
+
+		hse_req_poll();
+	}
+
+	req = drv.done.head;
+	hse_req_collect(req);
+
+	return req;
+}
+
+/**
+ * hse_srv_req_sync - initiate service request and wait for response
+ * @channel: selects channel for the service request
+ * @srv_desc: address of service descriptor
+ *
+ * Return: 0 on succes, specific errno code on error
+ */
+int hse_srv_req_sync(enum hse_ch_type channel, const hseSrvDescriptor_t *srv_desc)
+{
+	struct hse_req req;
+	int ret;
+
+	ret = hse_srv_req_submit(channel, srv_desc, &req);
 	if (ret)
 		return ret;
 
-	if (srv_rsp == HSE_SRV_RSP_OK)
-		return 0;
+	return hse_wait(&req);
+}
+
+#if (S32_HSE_MEM_BENCH == 1)
+#define HSE_MEM_BENCH_SLOTS	(64U)
+#define HSE_MEM_BENCH_ROUNDS	(16U)
+
+/*
+ * Times the reserved memory allocator with the request sizes of the crypto
+ * library: lengths, digests, signatures and hash chunks. Every other block is
+ * released first, so that the allocations of the next round go through a
+ * fragmented pool. The pool is set up again for its actual users afterwards.
+ */
+static void hse_mem_bench(uintptr_t base, size_t size)
+{
+	static const size_t sizes[] = { 4U, 64U, 512U, 64U * 1024U };
+	uint64_t start, alloc_ticks = 0, free_ticks = 0;
+	void *ptrs[HSE_MEM_BENCH_SLOTS];
+	struct hse_mem_stats stats;
+	unsigned int round, i;
+
+	if (hse_mem_setup(base, size))
+		return;
+
+	for (round = 0; round < HSE_MEM_BENCH_ROUNDS; round++) {
+		start = read_cntpct_el0();
+		for (i = 0; i < ARRAY_SIZE(ptrs); i++)
+			ptrs[i] = hse_mem_alloc(sizes[(i + round) %
+						      ARRAY_SIZE(sizes)]);
+		alloc_ticks += read_cntpct_el0() - start;
+
+		start = read_cntpct_el0();
+		for (i = 1; i < ARRAY_SIZE(ptrs); i += 2)
+			hse_mem_free(ptrs[i]);
+		for (i = 0; i < ARRAY_SIZE(ptrs); i += 2)
+			hse_mem_free(ptrs[i]);
+		free_ticks += read_cntpct_el0() - start;
+	}
 
-	ERROR("HSE Service Request failed (service response: 0x%x).", srv_rsp);
-	return -EINVAL;
+	hse_mem_get_stats(&stats);
+
+	NOTICE("HSE: pool alloc %llu ns, free %llu ns, up to %u free blocks, %u failed allocations\n",
+	       s32_ticks_to_ns(alloc_ticks) /
+	       (HSE_MEM_BENCH_ROUNDS * HSE_MEM_BENCH_SLOTS),
+	       s32_ticks_to_ns(free_ticks) /
+	       (HSE_MEM_BENCH_ROUNDS * HSE_MEM_BENCH_SLOTS),
+	       stats.peak_free_blocks, stats.failed_allocs);
+
+	if (stats.used_blocks || stats.free_blocks != 1U)
+		WARN("HSE: pool not merged back after the benchmark\n");
 }
+#endif
 
 /**
  * hse_driver_init - initializes HSE driver internal resources
@@ -208,6 +452,10 @@ int hse_driver_init(void)
 	drv.res_mem.paddr = mapping.paddr;
 	drv.res_mem.size = mapping.size;
 
+#if (S32_HSE_MEM_BENCH == 1)
+	hse_mem_bench(drv.res_mem.paddr, drv.res_mem.size);
+#endif
+
 	err = hse_mem_setup(drv.res_mem.paddr, drv.res_mem.size);
 	if (err)
 		return err;
@@ -3,145 +3,402 @@
  * Copyright 2021-2024 NXP
  */
 
+#include <drivers/nxp/s32/hse/hse_mem.h>
 #include <errno.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <utils_def.h>
 
-#define HSE_NODE_SIZE    sizeof(struct node_data) /* memory block metadata */
+/*
+ * Two-level segregated fit (TLSF) allocator. Free blocks are kept in lists
+ * indexed by size class: the first level splits the sizes in powers of two,
+ * the second level splits each power of two in HSE_SL_COUNT linear ranges.
+ * Two bitmaps track the non-empty lists, so that both allocation and release
+ * take constant time. Every block records its physical predecessor, which
+ * allows merging free neighbours on release.
+ */
+#define HSE_ALIGN_LOG2		4U
+#define HSE_ALIGN		BIT_64(HSE_ALIGN_LOG2)
+
+#define HSE_SL_LOG2		3U
+#define HSE_SL_COUNT		BIT_32(HSE_SL_LOG2)
+#define HSE_FL_SHIFT		(HSE_SL_LOG2 + HSE_ALIGN_LOG2)
+#define HSE_FL_MAX		31U
+#define HSE_FL_COUNT		(HSE_FL_MAX - HSE_FL_SHIFT + 1U)
+#define HSE_SMALL_BLOCK		BIT_64(HSE_FL_SHIFT)
 
-struct node_data {
-	uint32_t size;
-	uint8_t used;
-	uint8_t reserved[3];
-	uint64_t next_offset;
-} __attribute__((packed));
+#define HSE_BLOCK_FREE		BIT_64(0)
+#define HSE_BLOCK_SIZE_MASK	(~(HSE_ALIGN - 1U))
 
-static struct node_data *mem_start;
+/* Largest pool and allocation, so that all sizes map to a valid class */
+#define HSE_POOL_MAX		BIT_64(HSE_FL_MAX)
+#define HSE_ALLOC_MAX		(HSE_POOL_MAX >> 1)
 
-static struct node_data *next_node(struct node_data *block)
+/**
+ * struct hse_block - memory block metadata
+ * @prev_phys: block located right before this one in memory
+ * @size: payload size, along with the HSE_BLOCK_FREE flag
+ * @next_free: next block in the same free list, valid for free blocks only
+ * @prev_free: previous block in the same free list, valid for free blocks only
+ */
+struct hse_block {
+	struct hse_block *prev_phys;
+	size_t size;
+	struct hse_block *next_free;
+	struct hse_block *prev_free;
+};
+
+/* The free list links overlap with the payload */
+#define HSE_BLOCK_OVERHEAD	offsetof(struct hse_block, next_free)
+#define HSE_BLOCK_MIN_SIZE	(sizeof(struct hse_block) - HSE_BLOCK_OVERHEAD)
+
+/**
+ * struct hse_pool - reserved memory pool state
+ * @fl_bitmap: first level lists with at least one free block
+ * @sl_bitmap[n]: second level lists of class n with at least one free block
+ * @free[n][m]: free list heads
+ * @stats: usage statistics, with S32_HSE_MEM_BENCH only
+ */
+struct hse_pool {
+	uint32_t fl_bitmap;
+	uint32_t sl_bitmap[HSE_FL_COUNT];
+	struct hse_block *free[HSE_FL_COUNT][HSE_SL_COUNT];
+#if (S32_HSE_MEM_BENCH == 1)
+	struct hse_mem_stats stats;
+#endif
+};
+
+static struct hse_pool pool;
+static bool pool_ready;
+
+static unsigned int hse_fls(size_t val)
 {
-	if (!block || !block->next_offset)
-		return NULL;
+	return (sizeof(unsigned long) * 8U) - 1U - __builtin_clzl(val);
+}
 
-	return (struct node_data *)((uint8_t *)mem_start + block->next_offset);
+static unsigned int hse_ffs(uint32_t val)
+{
+	return __builtin_ctz(val);
 }
 
-int hse_mem_setup(uintptr_t base_addr, size_t mem_size)
+static size_t block_size(const struct hse_block *block)
 {
-	struct node_data **mem =  &mem_start;
+	return block->size & HSE_BLOCK_SIZE_MASK;
+}
 
-	if (!base_addr || !mem_size)
-		return -EINVAL;
+static bool block_is_free(const struct hse_block *block)
+{
+	return (block->size & HSE_BLOCK_FREE) != 0U;
+}
 
-	*mem = (struct node_data *)base_addr;
-	(*mem)->size = mem_size - HSE_NODE_SIZE;
-	(*mem)->next_offset = 0;
-	(*mem)->used = false;
+static void *block_to_ptr(struct hse_block *block)
+{
+	return (uint8_t *)block + HSE_BLOCK_OVERHEAD;
+}
 
-	return 0;
+static struct hse_block *ptr_to_block(void *ptr)
+{
+	return (struct hse_block *)((uint8_t *)ptr - HSE_BLOCK_OVERHEAD);
 }
 
-void *hse_mem_alloc(size_t size)
+static struct hse_block *next_phys(struct hse_block *block)
 {
-	struct node_data *crt_block;
-	struct node_data *best_block;
-	struct node_data *alloc_block;
-	size_t best_block_size;
-	uint64_t mem_start_u64;
+	return (struct hse_block *)((uint8_t *)block_to_ptr(block) +
+				    block_size(block));
+}
 
-	/* align size to HSE_NODE_SIZE */
-	size = round_up(size, HSE_NODE_SIZE);
-	if (!size)
-		return NULL;
+#if (S32_HSE_MEM_BENCH == 1)
+static void stats_add_free_block(void)
+{
+	pool.stats.free_blocks++;
+	pool.stats.peak_free_blocks = MAX(pool.stats.peak_free_blocks,
+					  pool.stats.free_blocks);
+}
 
-	crt_block = mem_start;
-	best_block = NULL;
-	best_block_size = mem_start->size;
+static void stats_del_free_block(void)
+{
+	pool.stats.free_blocks--;
+}
 
-	while (crt_block) {
+static void stats_alloc(const struct hse_block *block)
+{
+	pool.stats.used_size += block_size(block) + HSE_BLOCK_OVERHEAD;
+	pool.stats.peak_used_size = MAX(pool.stats.peak_used_size,
+					pool.stats.used_size);
+	pool.stats.used_blocks++;
+}
 
-		if (crt_block->used) {
-			crt_block = next_node(crt_block);
-			continue;
-		}
+static void stats_release(const struct hse_block *block)
+{
+	pool.stats.used_size -= block_size(block) + HSE_BLOCK_OVERHEAD;
+	pool.stats.used_blocks--;
+}
 
-		if (crt_block->size == (size + HSE_NODE_SIZE)) {
-			best_block = crt_block;
-			break;
-		}
+static void stats_alloc_failed(void)
+{
+	pool.stats.failed_allocs++;
+}
+#else
+static inline void stats_add_free_block(void)
+{
+}
 
-		if ((crt_block->size >= (size + HSE_NODE_SIZE)) &&
-		    (crt_block->size <= best_block_size)) {
-			best_block = crt_block;
-			best_block_size = crt_block->size;
-		}
+static inline void stats_del_free_block(void)
+{
+}
 
-		crt_block = next_node(crt_block);
+static inline void stats_alloc(const struct hse_block *block)
+{
+}
+
+static inline void stats_release(const struct hse_block *block)
+{
+}
+
+static inline void stats_alloc_failed(void)
+{
+}
+#endif
+
+static void mapping_insert(size_t size, unsigned int *fl, unsigned int *sl)
+{
+	unsigned int msb;
+
+	if (size < HSE_SMALL_BLOCK) {
+		*fl = 0U;
+		*sl = size / (HSE_SMALL_BLOCK / HSE_SL_COUNT);
+		return;
+	}
+
+	msb = hse_fls(size);
+	*sl = (size >> (msb - HSE_SL_LOG2)) ^ HSE_SL_COUNT;
+	*fl = msb - HSE_FL_SHIFT + 1U;
+}
+
+/* Round up to the next class, so that any block from it fits the request */
+static void mapping_search(size_t size, unsigned int *fl, unsigned int *sl)
+{
+	if (size >= HSE_SMALL_BLOCK)
+		size += BIT_64(hse_fls(size) - HSE_SL_LOG2) - 1U;
+
+	mapping_insert(size, fl, sl);
+}
+
+static struct hse_block *find_suitable(unsigned int *fl, unsigned int *sl)
+{
+	uint32_t fl_map, sl_map;
+
+	sl_map = pool.sl_bitmap[*fl] & (~0U << *sl);
+	if (!sl_map) {
+		fl_map = pool.fl_bitmap & (~0U << (*fl + 1U));
+		if (!fl_map)
+			return NULL;
+
+		*fl = hse_ffs(fl_map);
+		sl_map = pool.sl_bitmap[*fl];
 	}
 
-	if (!best_block)
+	*sl = hse_ffs(sl_map);
+
+	return pool.free[*fl][*sl];
+}
+
+static void remove_free(struct hse_block *block)
+{
+	unsigned int fl, sl;
+
+	mapping_insert(block_size(block), &fl, &sl);
+
+	if (block->next_free)
+		block->next_free->prev_free = block->prev_free;
+	if (block->prev_free)
+		block->prev_free->next_free = block->next_free;
+
+	if (pool.free[fl][sl] == block) {
+		pool.free[fl][sl] = block->next_free;
+		if (!pool.free[fl][sl]) {
+			pool.sl_bitmap[fl] &= ~BIT_32(sl);
+			if (!pool.sl_bitmap[fl])
+				pool.fl_bitmap &= ~BIT_32(fl);
+		}
+	}
+
+	stats_del_free_block();
+}
+
+static void insert_free(struct hse_block *block)
+{
+	unsigned int fl, sl;
+
+	mapping_insert(block_size(block), &fl, &sl);
+
+	block->size |= HSE_BLOCK_FREE;
+	block->prev_free = NULL;
+	block->next_free = pool.free[fl][sl];
+	if (block->next_free)
+		block->next_free->prev_free = block;
+
+	pool.free[fl][sl] = block;
+	pool.sl_bitmap[fl] |= BIT_32(sl);
+	pool.fl_bitmap |= BIT_32(fl);
+
+	stats_add_free_block();
+}
+
+/* Give back the tail of @block, if large enough to hold another block */
+static void split(struct hse_block *block, size_t size)
+{
+	struct hse_block *rem;
+	size_t rem_size;
+
+	if (block_size(block) < size + sizeof(struct hse_block))
+		return;
+
+	rem_size = block_size(block) - size - HSE_BLOCK_OVERHEAD;
+	rem = (struct hse_block *)((uint8_t *)block_to_ptr(block) + size);
+	rem->prev_phys = block;
+	rem->size = rem_size;
+
+	block->size = size;
+	next_phys(rem)->prev_phys = rem;
+
+	insert_free(rem);
+}
+
+/* Absorb @next, the physical successor of @block, into @block */
+static void merge(struct hse_block *block, struct hse_block *next)
+{
+	block->size += HSE_BLOCK_OVERHEAD + block_size(next);
+	next_phys(block)->prev_phys = block;
+}
+
+int hse_mem_setup(uintptr_t base_addr, size_t mem_size)
+{
+	struct hse_block *block, *last;
+	uintptr_t start, end;
+
+	if (!base_addr || !mem_size || mem_size > HSE_POOL_MAX)
+		return -EINVAL;
+
+	start = round_up(base_addr, HSE_ALIGN);
+	end = round_down(base_addr + mem_size, HSE_ALIGN);
+	if (end <= start || end - start < 2U * sizeof(struct hse_block))
+		return -EINVAL;
+
+	pool = (struct hse_pool){0};
+
+	/*
+	 * A single free block spans the whole pool, followed by a zero-sized
+	 * used block which stops the merging at the end of the pool.
+	 */
+	block = (struct hse_block *)start;
+	block->prev_phys = NULL;
+	block->size = end - start - 2U * HSE_BLOCK_OVERHEAD;
+
+	last = next_phys(block);
+	last->prev_phys = block;
+	last->size = 0;
+
+	insert_free(block);
+
+#if (S32_HSE_MEM_BENCH == 1)
+	pool.stats.total_size = block_size(block);
+#endif
+	pool_ready = true;
+
+	return 0;
+}
+
+void *hse_mem_alloc(size_t size)
+{
+	struct hse_block *block;
+	unsigned int fl, sl;
+
+	if (!pool_ready || !size || size > HSE_ALLOC_MAX)
 		return NULL;
 
-	/* found a match, split a chunk of requested size and return it */
-	best_block->size = best_block->size - size - HSE_NODE_SIZE;
-	alloc_block = (struct node_data *)((uint8_t *)best_block +
-					   HSE_NODE_SIZE + best_block->size);
-	alloc_block->size = size;
-	alloc_block->used = true;
+	size = round_up(size, HSE_ALIGN);
+	if (size < HSE_BLOCK_MIN_SIZE)
+		size = HSE_BLOCK_MIN_SIZE;
+
+	mapping_search(size, &fl, &sl);
+
+	block = find_suitable(&fl, &sl);
+	if (!block) {
+		stats_alloc_failed();
+		return NULL;
+	}
 
-	mem_start_u64 = (uint64_t)mem_start;
+	remove_free(block);
+	block->size &= ~HSE_BLOCK_FREE;
+	split(block, size);
 
-	alloc_block->next_offset = best_block->next_offset;
-	best_block->next_offset = (uint64_t)alloc_block - mem_start_u64;
+	stats_alloc(block);
 
-	return (void *)((uint8_t *)alloc_block + HSE_NODE_SIZE);
+	return block_to_ptr(block);
 }
 
 void hse_mem_free(void *addr)
 {
-	struct node_data *prev_block;
-	struct node_data *next_block;
-	struct node_data *free_block;
+	struct hse_block *block, *prev, *next;
 
-	if (addr == NULL)
+	if (!addr || !pool_ready)
 		return;
 
-	/* get the node_data for the block to be freed */
-	free_block = (struct node_data *)((uint8_t *)addr - HSE_NODE_SIZE);
-	if (free_block == NULL)
+	block = ptr_to_block(addr);
+	if (block_is_free(block))
 		return;
 
-	next_block = mem_start;
+	stats_release(block);
 
-	free_block->used = false;
+	prev = block->prev_phys;
+	if (prev && block_is_free(prev)) {
+		remove_free(prev);
+		prev->size &= ~HSE_BLOCK_FREE;
+		merge(prev, block);
+		block = prev;
+	}
 
-	prev_block = NULL;
-	while ((next_block != NULL) && (next_block < free_block)) {
-		prev_block = next_block;
-		next_block = next_node(next_block);
+	next = next_phys(block);
+	if (block_is_free(next)) {
+		remove_free(next);
+		merge(block, next);
 	}
 
-	if (next_node(free_block) != NULL) {
-		if (!next_node(free_block)->used) {
-			free_block->size += next_node(free_block)->size;
-			free_block->size += HSE_NODE_SIZE;
+	insert_free(block);
+}
 
-			/* remove next_block from list */
-			free_block->next_offset = next_node(free_block)->next_offset;
-		}
-	}
+#if (S32_HSE_MEM_BENCH == 1)
+/**
+ * hse_mem_get_stats - get the reserved memory pool usage
+ * @stats: output statistics
+ *
+ * The size of the largest free block is looked up in the highest non-empty
+ * size class, so the call is not constant time.
+ */
+void hse_mem_get_stats(struct hse_mem_stats *stats)
+{
+	struct hse_block *block;
+	unsigned int fl, sl;
 
-	if (prev_block != NULL) {
-		if (!prev_block->used) {
-			prev_block->size += free_block->size + HSE_NODE_SIZE;
+	if (!stats)
+		return;
 
-			/* remove free_block from list */
-			prev_block->next_offset = free_block->next_offset;
-		}
-	}
+	*stats = pool.stats;
+	stats->largest_free = 0;
+
+	if (!pool.fl_bitmap)
+		return;
+
+	fl = hse_fls(pool.fl_bitmap);
+	sl = hse_fls(pool.sl_bitmap[fl]);
+
+	for (block = pool.free[fl][sl]; block; block = block->next_free)
+		stats->largest_free = MAX(stats->largest_free,
+					  block_size(block));
 }
+#endif
 
 void *hse_memcpy(void *dest, const void *src, size_t size)
 {
@@ -55,12 +55,12 @@ static int get_mu_node_enabled(void *fdt, int start_off)
 	if (offs >= 0)
 		return offs;
 
-	offs = fdt_node_offset_by_compatible(fdt, start_off, hse_mu_node_comp);
+	offs = dt_node_offset_by_compatible(fdt, start_off, hse_mu_node_comp);
 	while (offs != -FDT_ERR_NOTFOUND) {
 		if (fdt_get_status(offs) == DT_ENABLED)
 			break;
 
-		offs = fdt_node_offset_by_compatible(fdt, offs, hse_mu_node_comp);
+		offs = dt_node_offset_by_compatible(fdt, offs, hse_mu_node_comp);
 	}
 
 	return offs;
@@ -150,7 +150,7 @@ int map_hse_res_mem(struct hse_memmap *mapping)
 	if (!mem_region_phandle || len != sizeof(uint32_t))
 		return -ENOENT;
 
-	mem_region_offs = fdt_node_offset_by_phandle(fdt, fdt32_to_cpu(*mem_region_phandle));
+	mem_region_offs = dt_node_offset_by_phandle(fdt, fdt32_to_cpu(*mem_region_phandle));
 	if (mem_region_offs < 0)
 		return -ENOENT;
 
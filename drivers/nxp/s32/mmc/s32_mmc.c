@@ -8,12 +8,17 @@
 #include <errno.h>
 #include <platform_def.h>
 
+#include <arch_helpers.h>
 #include <s32_bl_common.h>
+#include <s32cc_dt.h>
 #include <drivers/delay_timer.h>
 #include <drivers/mmc.h>
+#include <drivers/nxp/s32/mmc/s32_mmc.h>
 #include <lib/utils.h>
 #include <lib/mmio.h>
 #include <lib/xlat_tables/xlat_tables_v2.h>
+#include <libfdt.h>
+#include <plat/common/platform.h>
 
 #define USDHC_DS_ADDR			(USDHC_BASE_ADDR + 0x0)
 #define USDHC_BLK_ATT			(USDHC_BASE_ADDR + 0x4)
@@ -33,14 +38,17 @@
 #define CMD_XFR_TYP_CMDINX(x)		(((x) & 0x3f) << 24)
 #define CMDINX_FROM_CMD_XFR_TYP(r)	(((r) >> 24) & 0x3f)
 #define USDHC_CMD_RSP(i)		(USDHC_BASE_ADDR + 0x10 + (i) * 0x4)
+#define USDHC_DATA_BUFF_ACC_PORT	(USDHC_BASE_ADDR + 0x20)
 
 #define USDHC_PRES_STATE		(USDHC_BASE_ADDR + 0x24)
 #define PRES_STATE_CIHB			BIT(0)
 #define PRES_STATE_CDIHB		BIT(1)
 #define PRES_STATE_DLA			BIT(2)
 #define PRES_STATE_SDSTB		BIT(3)
+#define PRES_STATE_BREN			BIT(11)
 
 #define USDHC_PROT_CTRL			(USDHC_BASE_ADDR + 0x28)
+#define PROT_CTRL_DMASEL_ADMA2		(0x2 << 8)
 #define PROT_CTRL_EMODE_LE		BIT(5)
 #define PROT_CTRL_DTW_4			BIT(1)
 #define PROT_CTRL_DTW_8			BIT(2)
@@ -66,6 +74,7 @@
 #define INT_STATUS_CEBE			BIT(18)
 #define INT_STATUS_CCE			BIT(17)
 #define INT_STATUS_CTOE			BIT(16)
+#define INT_STATUS_BRR			BIT(5)
 #define INT_STATUS_TC			BIT(1)
 #define INT_STATUS_CC			BIT(0)
 #define INT_STATUS_CMD_ERROR		(INT_STATUS_CIE | INT_STATUS_CEBE | \
@@ -77,7 +86,7 @@
 					 INT_STATUS_DATA_ERROR)
 
 #define USDHC_INT_STATUS_EN		(USDHC_BASE_ADDR + 0x34)
-#define INT_STATUS_EN_ENABLEMASK	INT_STATUS_CLEARMASK
+#define INT_STATUS_EN_ENABLEMASK	(INT_STATUS_CLEARMASK | INT_STATUS_BRR)
 
 #define USDHC_INT_SIGNAL_EN		(USDHC_BASE_ADDR + 0x38)
 
@@ -87,6 +96,14 @@
 #define WTMK_LVL_WR_WML(x)		(((x) & 0xff) << WTMK_LVL_WR_WML_SHIFT)
 
 #define USDHC_MIX_CTRL			(USDHC_BASE_ADDR + 0x48)
+#define MIX_CTRL_FBCLK_SEL		BIT(25)
+#define MIX_CTRL_AUTO_TUNE_EN		BIT(24)
+#define MIX_CTRL_SMP_CLK_SEL		BIT(23)
+#define MIX_CTRL_EXE_TUNE		BIT(22)
+#define MIX_CTRL_TUNING_MASK		(MIX_CTRL_FBCLK_SEL | \
+					 MIX_CTRL_AUTO_TUNE_EN | \
+					 MIX_CTRL_SMP_CLK_SEL | \
+					 MIX_CTRL_EXE_TUNE)
 #define MIX_CTRL_MSBSEL			BIT(5)
 #define MIX_CTRL_DTDSEL			BIT(4)
 #define MIX_CTRL_DDR_EN			BIT(3)
@@ -98,6 +115,7 @@
 #define MIX_CTRL_RESET_MASK		\
 	~(MIX_CTRL_MSBSEL | MIX_CTRL_DTDSEL | MIX_CTRL_BCEN | MIX_CTRL_DMAEN)
 
+#define USDHC_ADMA_SYS_ADDR		(USDHC_BASE_ADDR + 0x58)
 #define USDHC_DLL_CTRL			(USDHC_BASE_ADDR + 0x60)
 #define USDHC_CLK_TUNE_CTRL_STATUS	(USDHC_BASE_ADDR + 0x68)
 #define USDHC_MMC_BOOT			(USDHC_BASE_ADDR + 0xc4)
@@ -105,6 +123,18 @@
 #define USDHC_VEND_SPEC			(USDHC_BASE_ADDR + 0xc0)
 #define VEND_SPEC_INIT			(0x20007809)
 
+#define USDHC_TUNING_CTRL		(USDHC_BASE_ADDR + 0xcc)
+#define TUNING_CTRL_STD_TUNING_EN	BIT(24)
+#define TUNING_CTRL_STEP(x)		(((x) & 0x7) << 16)
+#define TUNING_CTRL_START_TAP(x)	((x) & 0x7f)
+
+/* SEND_TUNING_BLOCK for HS200, JEDEC 4.51 chapter 6.6.5.1 */
+#define MMC_CMD_SEND_TUNING_BLOCK	MMC_CMD(21)
+#define TUNING_BLOCK_SIZE_8BIT		(128)
+#define TUNING_BLOCK_SIZE_4BIT		(64)
+#define TUNING_MAX_LOOPS		(40)
+#define TUNING_TIMEOUT_US		(10000)
+
 /* These masks represent the commands which involve a data transfer. */
 #define ADTC_MASK_SD			(BIT(6) | BIT(18) | BIT(17) | BIT(24) | BIT(25))
 #define ADTC_MASK_MMC			(BIT(8) | BIT(18) | BIT(17) | BIT(24) | BIT(25))
@@ -114,6 +144,20 @@
 #define SD_FULL_SPEED_MODE_FREQUENCY	(25 * 1000 * 1000)
 #define MMC_FULL_SPEED_MODE_FREQUENCY	(26 * 1000 * 1000)
 
+/* 32-bit ADMA2 descriptor attributes */
+#define ADMA2_ATTR_VALID		BIT(0)
+#define ADMA2_ATTR_END			BIT(1)
+#define ADMA2_ATTR_ACT_TRAN		(0x2 << 4)
+
+struct s32_adma2_desc {
+	uint16_t attr;
+	uint16_t len;
+	uint32_t addr;
+};
+
+static struct s32_adma2_desc adma2_table[S32_MMC_ADMA2_DESC_NUM]
+	__aligned(CACHE_WRITEBACK_GRANULE);
+
 static struct mmc_device_info emmc_device_info = {
 	.mmc_dev_type = MMC_IS_EMMC,
 	.op_cond_period = 1,
@@ -127,8 +171,12 @@ static struct mmc_device_info sd_device_info = {
 
 struct s32_usdhc_device_data {
 	struct mmc_device_info *devinfo;
-	uint32_t prepare_ds_addr;
+	/* ADMA2 descriptor table of the next data transfer */
+	uint32_t prepare_adma_addr;
 	uint32_t prepare_blk_att;
+	/* Bus frequency limit from the "max-frequency" DT property */
+	unsigned int max_freq;
+	unsigned int timing_caps;
 };
 
 static struct s32_usdhc_device_data devdata;
@@ -163,7 +211,9 @@ static void s32_mmc_set_clk(uint64_t clk)
 	int div = 1;
 	unsigned long sdhc_clk_freq = get_sdhc_clk_freq();
 
-	assert(!(mmio_read_32(USDHC_MIX_CTRL) & MIX_CTRL_DDR_EN));
+	/* The card clock is further divided by 2 in DDR mode */
+	if (mmio_read_32(USDHC_MIX_CTRL) & MIX_CTRL_DDR_EN)
+		sdhc_clk_freq /= 2;
 
 	while (sdhc_clk_freq / (prediv * 16) > clk && prediv < 256)
 		prediv <<= 1;
@@ -196,6 +246,7 @@ static void s32_mmc_init(void)
 	mmio_write_32(USDHC_MMC_BOOT, 0);
 	mmio_write_32(USDHC_MIX_CTRL, 0);
 	mmio_write_32(USDHC_CLK_TUNE_CTRL_STATUS, 0);
+	mmio_write_32(USDHC_TUNING_CTRL, 0);
 	mmio_write_32(USDHC_VEND_SPEC, VEND_SPEC_INIT);
 	mmio_write_32(USDHC_DLL_CTRL, 0);
 
@@ -203,7 +254,8 @@ static void s32_mmc_init(void)
 
 	mmio_write_32(USDHC_INT_STATUS_EN, INT_STATUS_EN_ENABLEMASK);
 	mmio_write_32(USDHC_INT_SIGNAL_EN, 0);
-	mmio_write_32(USDHC_PROT_CTRL, PROT_CTRL_EMODE_LE);
+	mmio_write_32(USDHC_PROT_CTRL, PROT_CTRL_EMODE_LE |
+		      PROT_CTRL_DMASEL_ADMA2);
 
 	regdata = mmio_read_32(USDHC_SYS_CTRL);
 	regdata &= ~SYS_CTRL_DTOCV_MASK;
@@ -269,13 +321,14 @@ static int s32_mmc_send_cmd(struct mmc_cmd *cmd)
 	if (is_multiple_block_transfer(cmd->cmd_idx))
 		mix_ctrl |= MIX_CTRL_BCEN;
 
-	if (cmd->cmd_idx != MMC_CMD(55) && devdata.prepare_ds_addr) {
+	if (cmd->cmd_idx != MMC_CMD(55) && cmd->cmd_idx != MMC_CMD(23) &&
+	    devdata.prepare_adma_addr) {
 		if (BLKCNT_FROM_BLK_ATT(devdata.prepare_blk_att) > 1)
 			mix_ctrl |= MIX_CTRL_BCEN | MIX_CTRL_MSBSEL;
 		mmio_write_32(USDHC_MIX_CTRL, mix_ctrl);
-		mmio_write_32(USDHC_DS_ADDR, devdata.prepare_ds_addr);
+		mmio_write_32(USDHC_ADMA_SYS_ADDR, devdata.prepare_adma_addr);
 		mmio_write_32(USDHC_BLK_ATT, devdata.prepare_blk_att);
-		devdata.prepare_ds_addr = 0;
+		devdata.prepare_adma_addr = 0;
 	} else {
 		mmio_write_32(USDHC_MIX_CTRL, mix_ctrl);
 	}
@@ -320,11 +373,28 @@ cmd_error:
 	return -EIO;
 }
 
+/*
+ * Once the device info is filled in, the bus runs at the highest frequency
+ * supported by the device in its current mode, within the board limit.
+ */
+static unsigned int s32_mmc_bus_freq(unsigned int clk)
+{
+	unsigned int freq = clk;
+
+	if (devdata.devinfo->max_bus_freq)
+		freq = devdata.devinfo->max_bus_freq;
+
+	if (devdata.max_freq && freq > devdata.max_freq)
+		freq = devdata.max_freq;
+
+	return freq;
+}
+
 static int s32_mmc_set_ios(unsigned int clk, unsigned int width)
 {
 	uint32_t regdata;
 
-	s32_mmc_set_clk(clk);
+	s32_mmc_set_clk(s32_mmc_bus_freq(clk));
 
 	regdata = mmio_read_32(USDHC_PROT_CTRL);
 	regdata &= ~(PROT_CTRL_DTW_MASK);
@@ -337,26 +407,189 @@ static int s32_mmc_set_ios(unsigned int clk, unsigned int width)
 	return 0;
 }
 
-/* Normally we could simply write DS_ADDR and BLK_ATT here, but DS_ADDR gets
+static void s32_mmc_reset_lines(uint32_t mask)
+{
+	mmio_setbits_32(USDHC_SYS_CTRL, mask);
+	while (mmio_read_32(USDHC_SYS_CTRL) & mask)
+		;
+}
+
+/*
+ * Send one SEND_TUNING_BLOCK command, the tuning block is read through the
+ * data port. CRC errors are expected for the sampling points being outside of
+ * the data eye, they only advance the tuning.
+ */
+static int s32_mmc_send_tuning_block(uint32_t block_size)
+{
+	uint64_t timeout = timeout_init_us(TUNING_TIMEOUT_US);
+	uint32_t regdata, mix_ctrl, i;
+
+	mmio_write_32(USDHC_INT_STATUS, INT_STATUS_CLEARMASK | INT_STATUS_BRR);
+	while (mmio_read_32(USDHC_PRES_STATE) &
+	       (PRES_STATE_CDIHB | PRES_STATE_CIHB | PRES_STATE_DLA)) {
+		if (timeout_elapsed(timeout))
+			return -ETIMEDOUT;
+	}
+
+	mix_ctrl = mmio_read_32(USDHC_MIX_CTRL) & MIX_CTRL_RESET_MASK;
+	mmio_write_32(USDHC_MIX_CTRL, mix_ctrl | MIX_CTRL_DTDSEL);
+	mmio_write_32(USDHC_BLK_ATT, BLK_ATT_BLKCNT(1) |
+		      BLK_ATT_BLKSIZE(block_size));
+
+	mmio_write_32(USDHC_CMDARG, 0);
+	mmio_write_32(USDHC_CMD_XFR_TYP,
+		      CMD_XFR_TYP_CMDINX(MMC_CMD_SEND_TUNING_BLOCK) |
+		      CMD_XFR_TYP_RSPTYP_48 | CMD_XFR_TYP_CICEN |
+		      CMD_XFR_TYP_CCCEN | CMD_XFR_TYP_DPSEL);
+
+	do {
+		regdata = mmio_read_32(USDHC_INT_STATUS);
+		if (regdata & (INT_STATUS_CMD_ERROR | INT_STATUS_DATA_ERROR))
+			break;
+		if (timeout_elapsed(timeout)) {
+			regdata = INT_STATUS_DTOE;
+			break;
+		}
+	} while (!(regdata & INT_STATUS_BRR));
+
+	if (regdata & INT_STATUS_BRR) {
+		for (i = 0; i < block_size; i += sizeof(uint32_t))
+			(void)mmio_read_32(USDHC_DATA_BUFF_ACC_PORT);
+	} else {
+		s32_mmc_reset_lines(SYS_CTRL_RSTC | SYS_CTRL_RSTD);
+	}
+
+	mmio_write_32(USDHC_INT_STATUS, INT_STATUS_CLEARMASK | INT_STATUS_BRR);
+
+	return 0;
+}
+
+/* Standard tuning: the controller moves the sampling point on each block */
+static int s32_mmc_execute_tuning(void)
+{
+	uint32_t block_size = TUNING_BLOCK_SIZE_4BIT;
+	uint32_t regdata;
+	int i, ret;
+
+	if ((mmio_read_32(USDHC_PROT_CTRL) & PROT_CTRL_DTW_MASK) ==
+	    PROT_CTRL_DTW_8)
+		block_size = TUNING_BLOCK_SIZE_8BIT;
+
+	mmio_write_32(USDHC_TUNING_CTRL, TUNING_CTRL_STD_TUNING_EN |
+		      TUNING_CTRL_STEP(1) | TUNING_CTRL_START_TAP(1));
+	mmio_setbits_32(USDHC_MIX_CTRL, MIX_CTRL_EXE_TUNE |
+			MIX_CTRL_SMP_CLK_SEL | MIX_CTRL_FBCLK_SEL);
+
+	for (i = 0; i < TUNING_MAX_LOOPS; i++) {
+		ret = s32_mmc_send_tuning_block(block_size);
+		if (ret)
+			break;
+
+		if (!(mmio_read_32(USDHC_MIX_CTRL) & MIX_CTRL_EXE_TUNE))
+			break;
+	}
+
+	regdata = mmio_read_32(USDHC_MIX_CTRL);
+	if (ret || (regdata & MIX_CTRL_EXE_TUNE) ||
+	    !(regdata & MIX_CTRL_SMP_CLK_SEL)) {
+		mmio_clrbits_32(USDHC_MIX_CTRL, MIX_CTRL_TUNING_MASK);
+		mmio_write_32(USDHC_TUNING_CTRL, 0);
+		ERROR("uSDHC: tuning failed\n");
+		return -EIO;
+	}
+
+	mmio_setbits_32(USDHC_MIX_CTRL, MIX_CTRL_AUTO_TUNE_EN);
+
+	return 0;
+}
+
+static int s32_mmc_set_timing(unsigned int timing)
+{
+	uint32_t mix_ctrl;
+
+	if (timing != MMC_TIMING_LEGACY &&
+	    !(devdata.timing_caps & MMC_TIMING_CAP(timing)))
+		return -ENOTSUP;
+
+	/* Drop the previous tuning results, if any */
+	mix_ctrl = mmio_read_32(USDHC_MIX_CTRL);
+	mix_ctrl &= ~(MIX_CTRL_DDR_EN | MIX_CTRL_TUNING_MASK);
+	if (timing == MMC_TIMING_DDR52)
+		mix_ctrl |= MIX_CTRL_DDR_EN;
+	mmio_write_32(USDHC_MIX_CTRL, mix_ctrl);
+	mmio_write_32(USDHC_TUNING_CTRL, 0);
+	mmio_write_32(USDHC_CLK_TUNE_CTRL_STATUS, 0);
+
+	s32_mmc_set_clk(s32_mmc_bus_freq(devdata.devinfo->max_bus_freq));
+
+	if (timing == MMC_TIMING_HS200)
+		return s32_mmc_execute_tuning();
+
+	return 0;
+}
+
+/* Normally we could simply write ADMA_SYS_ADDR and BLK_ATT here, but they get
  * reset whenever a command is executed. And sometimes the sequence of
  * calls from the tf-a core is prepare() --> send_cmd(MMC_CMD(55)) -->
- * send_cmd(MMC_ACMD(x)). In this case DS_ADDR is reset by the time MMC_ACMD(x)
- * is executed. And since setting BLK_ATT requires certain bits to be set in
+ * send_cmd(MMC_ACMD(x)). In this case the DMA address is reset by the time
+ * MMC_ACMD(x) is executed. And since setting BLK_ATT requires certain bits to be set in
  * MIX_CTRL, and MIX_CTRL is configured in send_cmd(), the simplest solution
- * is to save the desired values for DS_ADDR and BLK_ATT and apply them right
- * before executing the command that needs them to be set.
+ * is to save the desired values for ADMA_SYS_ADDR and BLK_ATT and apply them
+ * right before executing the command that needs them to be set.
  */
 
+/*
+ * Describe the whole transfer in the ADMA2 descriptor table, so that
+ * multi-megabyte reads complete with a single CMD18, straight into the
+ * destination buffer.
+ */
+static int s32_mmc_adma2_fill(uintptr_t buf, size_t size)
+{
+	unsigned int i = 0;
+	size_t len;
+
+	if (!size || (buf & (S32_MMC_DMA_ALIGN - 1)) ||
+	    size > S32_MMC_MAX_XFER_SIZE ||
+	    buf + size - 1 > UINT32_MAX) {
+		ERROR("uSDHC: unsupported DMA buffer 0x%lx (0x%zx bytes)\n",
+		      buf, size);
+		return -EINVAL;
+	}
+
+	while (size) {
+		len = MIN(size, (size_t)S32_MMC_ADMA2_DESC_MAX_LEN);
+
+		adma2_table[i].attr = ADMA2_ATTR_VALID | ADMA2_ATTR_ACT_TRAN;
+		adma2_table[i].len = len;
+		adma2_table[i].addr = buf;
+
+		buf += len;
+		size -= len;
+		i++;
+	}
+
+	adma2_table[i - 1].attr |= ADMA2_ATTR_END;
+	flush_dcache_range((uintptr_t)adma2_table,
+			   i * sizeof(adma2_table[0]));
+
+	return 0;
+}
+
 static int s32_mmc_prepare(int lba, uintptr_t buf, size_t size)
 {
 	uint32_t block_size;
+	int ret;
 
 	if (size <= MMC_BLOCK_SIZE)
 		block_size = size;
 	else
 		block_size = MMC_BLOCK_SIZE;
 
-	devdata.prepare_ds_addr = buf;
+	ret = s32_mmc_adma2_fill(buf, size);
+	if (ret)
+		return ret;
+
+	devdata.prepare_adma_addr = (uintptr_t)adma2_table;
 	devdata.prepare_blk_att = BLK_ATT_BLKCNT(size / block_size) |
 				  BLK_ATT_BLKSIZE(block_size);
 
@@ -382,8 +615,88 @@ static const struct mmc_ops s32_mmc_ops = {
 	.prepare	= s32_mmc_prepare,
 	.read		= s32_mmc_read,
 	.write		= s32_mmc_write,
+	.set_timing	= s32_mmc_set_timing,
 };
 
+/*
+ * The eMMC bus timings are selected through the standard MMC DT properties
+ * of the uSDHC node. HS52 is always allowed, DDR52 requires "mmc-ddr-*" and
+ * HS200 requires "mmc-hs200-1_8v", with the I/O powered at 1.8V by the board
+ * (i.e. no "no-1-8-v"). "max-frequency" caps the bus frequency in all modes.
+ */
+static void s32_mmc_get_dt_caps(void)
+{
+	const fdt32_t *cuint;
+	void *fdt = NULL;
+	int node;
+
+	devdata.max_freq = 0;
+	devdata.timing_caps = MMC_TIMING_CAP(MMC_TIMING_HS);
+
+	if (dt_open_and_check() < 0)
+		return;
+
+	if (!fdt_get_address(&fdt))
+		return;
+
+	node = dt_node_offset_by_compatible(fdt, -1, "nxp,s32cc-usdhc");
+	if (node < 0)
+		return;
+
+	cuint = fdt_getprop(fdt, node, "max-frequency", NULL);
+	if (cuint)
+		devdata.max_freq = fdt32_to_cpu(*cuint);
+
+	if (fdt_getprop(fdt, node, "mmc-ddr-1_8v", NULL) ||
+	    fdt_getprop(fdt, node, "mmc-ddr-3_3v", NULL))
+		devdata.timing_caps |= MMC_TIMING_CAP(MMC_TIMING_DDR52);
+
+	if (fdt_getprop(fdt, node, "mmc-hs200-1_8v", NULL) &&
+	    !fdt_getprop(fdt, node, "no-1-8-v", NULL))
+		devdata.timing_caps |= MMC_TIMING_CAP(MMC_TIMING_HS200);
+
+	if (devdata.max_freq && devdata.max_freq < MMC_HS200_MAX_FREQ)
+		devdata.timing_caps &= ~MMC_TIMING_CAP(MMC_TIMING_HS200);
+}
+
+#if (S32_MMC_BENCH == 1)
+#define MMC_BENCH_BUF_SIZE	(8 * 1024)
+#define MMC_BENCH_ROUNDS	(16)
+
+static uint8_t mmc_bench_buf[MMC_BENCH_BUF_SIZE] __aligned(CACHE_WRITEBACK_GRANULE);
+
+/* Read throughput of the selected bus mode */
+static void s32_mmc_bench(void)
+{
+	static const char * const timings[] = {
+		[MMC_TIMING_LEGACY] = "legacy",
+		[MMC_TIMING_HS] = "HS",
+		[MMC_TIMING_DDR52] = "DDR52",
+		[MMC_TIMING_HS200] = "HS200",
+	};
+	struct mmc_device_info *info = devdata.devinfo;
+	uint64_t start, ticks;
+	unsigned int i;
+
+	start = read_cntpct_el0();
+	for (i = 0; i < MMC_BENCH_ROUNDS; i++) {
+		if (mmc_read_blocks(0, (uintptr_t)mmc_bench_buf,
+				    sizeof(mmc_bench_buf)) != sizeof(mmc_bench_buf)) {
+			ERROR("uSDHC: benchmark read failed\n");
+			return;
+		}
+	}
+	ticks = read_cntpct_el0() - start;
+
+	NOTICE("uSDHC: %s %s @ %u Hz: %llu KiB/s\n",
+	       info->mmc_dev_type == MMC_IS_EMMC ? "eMMC" : "SD",
+	       info->timing < ARRAY_SIZE(timings) ? timings[info->timing] : "?",
+	       s32_mmc_bus_freq(info->max_bus_freq),
+	       s32_ticks_to_kib_s(MMC_BENCH_ROUNDS * sizeof(mmc_bench_buf),
+				  ticks));
+}
+#endif
+
 static bool s32_is_card_emmc(void)
 {
 	struct mmc_cmd cmd;
@@ -411,7 +724,7 @@ static bool s32_is_card_emmc(void)
 
 int s32_mmc_register(void)
 {
-	unsigned int clk, bus_width;
+	unsigned int clk, bus_width, flags;
 	int result;
 
 	result = mmap_add_dynamic_region(USDHC_BASE_ADDR, USDHC_BASE_ADDR,
@@ -422,23 +735,35 @@ int s32_mmc_register(void)
 		panic();
 	}
 
+	s32_mmc_get_dt_caps();
 	s32_mmc_init();
 
-	devdata.prepare_ds_addr = 0;
+	devdata.prepare_adma_addr = 0;
 	devdata.prepare_blk_att = 0;
 
 	if (s32_is_card_emmc()) {
 		devdata.devinfo = &emmc_device_info;
 		bus_width = MMC_BUS_WIDTH_8;
 		clk = MMC_FULL_SPEED_MODE_FREQUENCY;
-		return mmc_init(&s32_mmc_ops, clk, bus_width,
-				0, devdata.devinfo);
+		/* Pre-defined multiple block reads, no CMD12 round-trip */
+		flags = MMC_FLAG_CMD23;
+	} else {
+		devdata.devinfo = &sd_device_info;
+		bus_width = MMC_BUS_WIDTH_4;
+		clk = SD_FULL_SPEED_MODE_FREQUENCY;
+		flags = MMC_FLAG_SD_CMD6;
 	}
 
-	devdata.devinfo = &sd_device_info;
-	bus_width = MMC_BUS_WIDTH_4;
-	clk = SD_FULL_SPEED_MODE_FREQUENCY;
+	devdata.devinfo->max_bus_freq = 0;
+	devdata.devinfo->timing_caps = devdata.timing_caps;
 
-	return mmc_init(&s32_mmc_ops, clk, bus_width,
-			MMC_FLAG_SD_CMD6, devdata.devinfo);
+	result = mmc_init(&s32_mmc_ops, clk, bus_width, flags, devdata.devinfo);
+	if (result)
+		return result;
+
+#if (S32_MMC_BENCH == 1)
+	s32_mmc_bench();
+#endif
+
+	return 0;
 }
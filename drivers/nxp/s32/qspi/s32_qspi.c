@@ -0,0 +1,447 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <platform_def.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <common/debug.h>
+#include <drivers/delay_timer.h>
+#include <drivers/nxp/s32/qspi/s32_qspi.h>
+#include <lib/mmio.h>
+#include <lib/utils_def.h>
+
+#define QSPI_MCR			(S32_QSPI_BASE + 0x0)
+#define MCR_SWRSTSD			BIT(0)
+#define MCR_SWRSTHD			BIT(1)
+#define MCR_DDR_EN			BIT(7)
+#define MCR_CLR_RXF			BIT(10)
+#define MCR_MDIS			BIT(14)
+
+#define QSPI_IPCR			(S32_QSPI_BASE + 0x8)
+#define IPCR_SEQID(x)			(((x) & 0xfU) << 24)
+#define IPCR_IDATSZ(x)			((x) & 0xffffU)
+
+#define QSPI_BUFCR(i)			(S32_QSPI_BASE + 0x10 + (i) * 0x4)
+#define BUFCR_INVALID_MSTRID		(0xeU)
+#define BUFCR_ADATSZ(x)			(((x) & 0xffU) << 8)
+#define BUF3CR_ALLMST			BIT(31)
+
+#define QSPI_BFGENCR			(S32_QSPI_BASE + 0x20)
+#define BFGENCR_SEQID(x)		(((x) & 0xfU) << 12)
+#define SEQID_FROM_BFGENCR(r)		(((r) >> 12) & 0xfU)
+
+#define QSPI_BUFIND(i)			(S32_QSPI_BASE + 0x30 + (i) * 0x4)
+#define QSPI_SFAR			(S32_QSPI_BASE + 0x100)
+
+#define QSPI_RBCT			(S32_QSPI_BASE + 0x110)
+#define RBCT_RXBRD_USEIPS		BIT(8)
+
+#define QSPI_SR				(S32_QSPI_BASE + 0x15c)
+#define SR_BUSY				BIT(0)
+
+#define QSPI_FR				(S32_QSPI_BASE + 0x160)
+#define FR_IPGEF			BIT(4)
+#define FR_IPIEF			BIT(6)
+#define FR_IPAEF			BIT(7)
+#define FR_IUEF				BIT(11)
+#define FR_IP_ERROR			(FR_IPGEF | FR_IPIEF | FR_IPAEF | FR_IUEF)
+
+#define QSPI_RBDR(i)			(S32_QSPI_BASE + 0x200 + (i) * 0x4)
+
+#define QSPI_LUTKEY			(S32_QSPI_BASE + 0x300)
+#define LUTKEY_VALUE			(0x5af05af0U)
+#define QSPI_LCKCR			(S32_QSPI_BASE + 0x304)
+#define LCKCR_LOCK			BIT(0)
+#define LCKCR_UNLOCK			BIT(1)
+#define QSPI_LUT(i)			(S32_QSPI_BASE + 0x310 + (i) * 0x4)
+#define QSPI_LUT_SEQ_REGS		(5U)
+
+/* LUT instructions */
+#define LUT_STOP			(0x0U)
+#define LUT_CMD				(0x1U)
+#define LUT_ADDR			(0x2U)
+#define LUT_DUMMY			(0x3U)
+#define LUT_READ			(0x7U)
+#define LUT_PAD_1			(0x0U)
+#define LUT_PAD_2			(0x1U)
+#define LUT_PAD_4			(0x2U)
+#define LUT_INSTR(op, pad, opr)		((uint16_t)(((op) << 10) | \
+						    ((pad) << 8) | (opr)))
+
+/*
+ * The BootROM sequences are left in place, the driver only uses the
+ * two sequences below.
+ */
+#define QSPI_SEQ_READ			(13U)
+#define QSPI_SEQ_CMD			(14U)
+
+#define QSPI_RX_BUF_SIZE		(128U)
+#define QSPI_AHB_BUF_SIZE		(1024U)
+#define QSPI_TIMEOUT_US			(10000U)
+
+/* SFDP (JESD216) */
+#define SPINOR_OP_RDSFDP		(0x5aU)
+#define SPINOR_OP_RDSR			(0x05U)
+#define SPINOR_OP_RDSR2			(0x35U)
+#define SPINOR_OP_RDSR2_3F		(0x3fU)
+#define SPINOR_OP_READ_FAST		(0x0bU)
+#define SFDP_SIGNATURE			(0x50444653U)
+#define SFDP_BFPT_ID			(0xff00U)
+#define SFDP_DUMMY_CYCLES		(8U)
+#define SPINOR_3B_ADDR_MAX_SIZE		(0x1000000U)
+#define BFPT_DWORDS			(16U)
+#define BFPT_DWORD(i)			((i) - 1U)
+#define BFPT_DW1_FAST_READ_1_1_2	BIT(16)
+#define BFPT_DW1_ADDR_BYTES(x)		(((x) >> 17) & 0x3U)
+#define BFPT_DW1_ADDR_3B		(0U)
+#define BFPT_DW1_ADDR_4B		(2U)
+#define BFPT_DW1_FAST_READ_1_2_2	BIT(20)
+#define BFPT_DW1_FAST_READ_1_4_4	BIT(21)
+#define BFPT_DW1_FAST_READ_1_1_4	BIT(22)
+#define BFPT_DW15_QER(x)		(((x) >> 20) & 0x7U)
+
+struct sfdp_header {
+	uint32_t signature;
+	uint8_t minor;
+	uint8_t major;
+	uint8_t nph;
+	uint8_t access;
+	/* First parameter header, always the BFPT */
+	uint8_t id_lsb;
+	uint8_t param_minor;
+	uint8_t param_major;
+	uint8_t length;
+	uint8_t ptp[3];
+	uint8_t id_msb;
+};
+
+struct qspi_read_op {
+	const char *name;
+	uint8_t opcode;
+	uint8_t addr_pad;
+	uint8_t data_pad;
+	uint8_t addr_bits;
+	uint8_t dummy;
+};
+
+/* Sequence used for the IP command reads, same as the AHB reads */
+static unsigned int read_seq;
+
+static void qspi_ahb_invalidate(void)
+{
+	uint32_t reset_mask = MCR_SWRSTHD | MCR_SWRSTSD;
+
+	mmio_clrbits_32(QSPI_MCR, MCR_MDIS);
+	mmio_setbits_32(QSPI_MCR, reset_mask);
+	mmio_setbits_32(QSPI_MCR, MCR_MDIS);
+	mmio_clrbits_32(QSPI_MCR, reset_mask);
+	mmio_clrbits_32(QSPI_MCR, MCR_MDIS);
+}
+
+static void qspi_lut_write(unsigned int seq, const uint16_t *instrs,
+			   unsigned int n)
+{
+	uint32_t regs[QSPI_LUT_SEQ_REGS] = {0};
+	unsigned int i;
+
+	/* Keep room for the STOP instruction */
+	assert(n < QSPI_LUT_SEQ_REGS * 2U);
+
+	for (i = 0; i < n; i++)
+		regs[i / 2U] |= (uint32_t)instrs[i] << ((i % 2U) * 16U);
+
+	mmio_write_32(QSPI_LUTKEY, LUTKEY_VALUE);
+	mmio_write_32(QSPI_LCKCR, LCKCR_UNLOCK);
+
+	for (i = 0; i < QSPI_LUT_SEQ_REGS; i++)
+		mmio_write_32(QSPI_LUT(seq * QSPI_LUT_SEQ_REGS + i), regs[i]);
+
+	mmio_write_32(QSPI_LUTKEY, LUTKEY_VALUE);
+	mmio_write_32(QSPI_LCKCR, LCKCR_LOCK);
+}
+
+static void qspi_lut_read_op(unsigned int seq, const struct qspi_read_op *op)
+{
+	uint16_t instrs[4];
+	unsigned int n = 0;
+
+	instrs[n++] = LUT_INSTR(LUT_CMD, LUT_PAD_1, op->opcode);
+	if (op->addr_bits)
+		instrs[n++] = LUT_INSTR(LUT_ADDR, op->addr_pad, op->addr_bits);
+	/* Mode clocks, if any, are issued as dummy cycles */
+	if (op->dummy)
+		instrs[n++] = LUT_INSTR(LUT_DUMMY, op->data_pad, op->dummy);
+	instrs[n++] = LUT_INSTR(LUT_READ, op->data_pad, 0);
+
+	qspi_lut_write(seq, instrs, n);
+}
+
+static int qspi_wait_idle(void)
+{
+	uint64_t timeout = timeout_init_us(QSPI_TIMEOUT_US);
+
+	while (mmio_read_32(QSPI_SR) & SR_BUSY) {
+		if (timeout_elapsed(timeout))
+			return -ETIMEDOUT;
+	}
+
+	return 0;
+}
+
+/* Read at most QSPI_RX_BUF_SIZE bytes through the IP RX buffer */
+static int qspi_ip_read(unsigned int seq, uint32_t addr, void *buf,
+			size_t len)
+{
+	uint8_t *dst = buf;
+	uint32_t word;
+	size_t i, n;
+	int ret;
+
+	assert(len && len <= QSPI_RX_BUF_SIZE);
+
+	ret = qspi_wait_idle();
+	if (ret)
+		return ret;
+
+	mmio_setbits_32(QSPI_MCR, MCR_CLR_RXF);
+	mmio_write_32(QSPI_FR, mmio_read_32(QSPI_FR));
+	mmio_write_32(QSPI_SFAR, S32_FLASH_BASE + addr);
+	mmio_write_32(QSPI_IPCR, IPCR_SEQID(seq) | IPCR_IDATSZ(len));
+
+	ret = qspi_wait_idle();
+	if (ret)
+		return ret;
+
+	if (mmio_read_32(QSPI_FR) & FR_IP_ERROR)
+		return -EIO;
+
+	for (i = 0; i < len; i += n) {
+		n = MIN(len - i, sizeof(word));
+		word = mmio_read_32(QSPI_RBDR(i / sizeof(word)));
+		memcpy(dst + i, &word, n);
+	}
+
+	return 0;
+}
+
+static int qspi_read_reg(uint8_t opcode, uint32_t addr, uint8_t addr_bits,
+			 uint8_t dummy, void *buf, size_t len)
+{
+	struct qspi_read_op op = {
+		.opcode = opcode,
+		.addr_pad = LUT_PAD_1,
+		.data_pad = LUT_PAD_1,
+		.addr_bits = addr_bits,
+		.dummy = dummy,
+	};
+
+	qspi_lut_read_op(QSPI_SEQ_CMD, &op);
+
+	return qspi_ip_read(QSPI_SEQ_CMD, addr, buf, len);
+}
+
+static int sfdp_read(uint32_t addr, void *buf, size_t len)
+{
+	return qspi_read_reg(SPINOR_OP_RDSFDP, addr, 24, SFDP_DUMMY_CYCLES,
+			     buf, len);
+}
+
+static int sfdp_read_bfpt(uint32_t *bfpt, unsigned int *dwords)
+{
+	struct sfdp_header hdr;
+	uint32_t ptp;
+	int ret;
+
+	ret = sfdp_read(0, &hdr, sizeof(hdr));
+	if (ret)
+		return ret;
+
+	if (hdr.signature != SFDP_SIGNATURE ||
+	    ((hdr.id_msb << 8) | hdr.id_lsb) != SFDP_BFPT_ID)
+		return -ENODEV;
+
+	ptp = hdr.ptp[0] | (hdr.ptp[1] << 8) | (hdr.ptp[2] << 16);
+	*dwords = MIN((unsigned int)hdr.length, BFPT_DWORDS);
+	if (*dwords < 4U)
+		return -EINVAL;
+
+	memset(bfpt, 0, BFPT_DWORDS * sizeof(*bfpt));
+
+	return sfdp_read(ptp, bfpt, *dwords * sizeof(*bfpt));
+}
+
+/* Quad reads need the Quad Enable bit, which is only checked, never set */
+static bool is_quad_enabled(const uint32_t *bfpt, unsigned int dwords)
+{
+	uint8_t sr[2] = {0};
+
+	if (dwords < 15U)
+		return false;
+
+	switch (BFPT_DW15_QER(bfpt[BFPT_DWORD(15)])) {
+	case 0:
+		/* No QE bit */
+		return true;
+	case 1:
+		if (qspi_read_reg(SPINOR_OP_RDSR, 0, 0, 0, sr, 2))
+			return false;
+		return sr[1] & BIT(1);
+	case 2:
+		if (qspi_read_reg(SPINOR_OP_RDSR, 0, 0, 0, sr, 1))
+			return false;
+		return sr[0] & BIT(6);
+	case 3:
+		if (qspi_read_reg(SPINOR_OP_RDSR2_3F, 0, 0, 0, sr, 1))
+			return false;
+		return sr[0] & BIT(7);
+	case 4:
+	case 5:
+		if (qspi_read_reg(SPINOR_OP_RDSR2, 0, 0, 0, sr, 1))
+			return false;
+		return sr[0] & BIT(1);
+	default:
+		return false;
+	}
+}
+
+/* 16-bit BFPT read settings: opcode, mode clocks, dummy clocks */
+static void bfpt_read_op(struct qspi_read_op *op, const char *name,
+			 uint16_t settings, uint8_t addr_pad, uint8_t data_pad)
+{
+	op->name = name;
+	op->opcode = settings >> 8;
+	op->dummy = ((settings >> 5) & 0x7U) + (settings & 0x1fU);
+	op->addr_pad = addr_pad;
+	op->data_pad = data_pad;
+}
+
+static int sfdp_get_read_op(struct qspi_read_op *op)
+{
+	uint32_t bfpt[BFPT_DWORDS];
+	unsigned int dwords;
+	uint64_t density;
+	uint32_t dw1, dw2;
+	bool quad;
+	int ret;
+
+	ret = sfdp_read_bfpt(bfpt, &dwords);
+	if (ret)
+		return ret;
+
+	dw1 = bfpt[BFPT_DWORD(1)];
+	dw2 = bfpt[BFPT_DWORD(2)];
+
+	if (dw2 & BIT(31))
+		density = BIT_64(dw2 & 0x7fffffffU) / 8U;
+	else
+		density = ((uint64_t)dw2 + 1U) / 8U;
+
+	switch (BFPT_DW1_ADDR_BYTES(dw1)) {
+	case BFPT_DW1_ADDR_3B:
+		op->addr_bits = 24;
+		break;
+	case BFPT_DW1_ADDR_4B:
+		op->addr_bits = 32;
+		break;
+	default:
+		/* 3 or 4 bytes, the mode switch is left to the BootROM setup */
+		if (density > SPINOR_3B_ADDR_MAX_SIZE)
+			return -ENOTSUP;
+		op->addr_bits = 24;
+		break;
+	}
+
+	quad = is_quad_enabled(bfpt, dwords);
+
+	if (quad && (dw1 & BFPT_DW1_FAST_READ_1_4_4))
+		bfpt_read_op(op, "1-4-4", bfpt[BFPT_DWORD(3)] >> 16,
+			     LUT_PAD_4, LUT_PAD_4);
+	else if (quad && (dw1 & BFPT_DW1_FAST_READ_1_1_4))
+		bfpt_read_op(op, "1-1-4", bfpt[BFPT_DWORD(3)] & 0xffffU,
+			     LUT_PAD_1, LUT_PAD_4);
+	else if (dw1 & BFPT_DW1_FAST_READ_1_2_2)
+		bfpt_read_op(op, "1-2-2", bfpt[BFPT_DWORD(4)] >> 16,
+			     LUT_PAD_2, LUT_PAD_2);
+	else if (dw1 & BFPT_DW1_FAST_READ_1_1_2)
+		bfpt_read_op(op, "1-1-2", bfpt[BFPT_DWORD(4)] & 0xffffU,
+			     LUT_PAD_1, LUT_PAD_2);
+	else
+		bfpt_read_op(op, "1-1-1", (SPINOR_OP_READ_FAST << 8) | 8U,
+			     LUT_PAD_1, LUT_PAD_1);
+
+	return 0;
+}
+
+static void qspi_ahb_buf_setup(void)
+{
+	unsigned int i;
+
+	/* A single prefetch buffer, shared by all masters, as large as it gets */
+	for (i = 0; i < 3U; i++) {
+		mmio_write_32(QSPI_BUFCR(i), BUFCR_INVALID_MSTRID);
+		mmio_write_32(QSPI_BUFIND(i), 0);
+	}
+
+	mmio_write_32(QSPI_BUFCR(3), BUF3CR_ALLMST |
+		      BUFCR_ADATSZ(QSPI_AHB_BUF_SIZE / 8U));
+}
+
+/*
+ * Switch the AHB reads to the fastest read sequence advertised through SFDP.
+ * An octal DDR setup done by the BootROM is already the fastest mode and is
+ * kept as it is, as well as any setup the SFDP tables can't describe.
+ */
+int s32_qspi_init(void)
+{
+	struct qspi_read_op op = {0};
+	int ret = 0;
+
+	mmio_setbits_32(QSPI_RBCT, RBCT_RXBRD_USEIPS);
+	read_seq = SEQID_FROM_BFGENCR(mmio_read_32(QSPI_BFGENCR));
+
+	if (mmio_read_32(QSPI_MCR) & MCR_DDR_EN) {
+		INFO("QSPI: keeping the BootROM DDR read sequence\n");
+	} else {
+		ret = sfdp_get_read_op(&op);
+		if (!ret) {
+			qspi_lut_read_op(QSPI_SEQ_READ, &op);
+			mmio_write_32(QSPI_BFGENCR, BFGENCR_SEQID(QSPI_SEQ_READ));
+			read_seq = QSPI_SEQ_READ;
+
+			INFO("QSPI: %s reads, opcode 0x%x, %u dummy cycles\n",
+			     op.name, op.opcode, op.dummy);
+		} else {
+			INFO("QSPI: keeping the BootROM read sequence (%d)\n",
+			     ret);
+		}
+	}
+
+	qspi_ahb_buf_setup();
+	qspi_ahb_invalidate();
+
+	return 0;
+}
+
+size_t s32_qspi_read(int lba, uintptr_t buf, size_t size)
+{
+	uint32_t addr = (uint32_t)lba * S32_QSPI_BLOCK_SIZE;
+	size_t done, len;
+
+	for (done = 0; done < size; done += len) {
+		len = MIN(size - done, (size_t)QSPI_RX_BUF_SIZE);
+
+		if (qspi_ip_read(read_seq, addr + done, (void *)(buf + done),
+				 len)) {
+			ERROR("QSPI: read at 0x%lx failed\n", addr + done);
+			return 0;
+		}
+	}
+
+	return size;
+}
@@ -3,9 +3,11 @@
  * Copyright 2024 NXP
  */
 
+#include <errno.h>
 #include <common/debug.h>
 #include <lib/mmio.h>
 #include <s32cc_bl_common.h>
+#include <s32cc_clocks.h>
 #include <drivers/nxp/s32/rtc/s32g/s32g_rtc.h>
 #include <lib/xlat_tables/xlat_tables_v2.h>
 
@@ -13,11 +15,21 @@
 #define S32G_RTC_BASE		(0x40060000ul)
 #define S32G_RTC_SIZE		(0x18)
 #define RTC_RTCC_OFFSET		0x4
+#define RTC_RTCC_CNTEN		BIT(31)
+#define RTC_RTCC_CLKSEL_OFFSET	12
+#define RTC_RTCC_CLKSEL_MASK	(0x3 << RTC_RTCC_CLKSEL_OFFSET)
+#define RTC_RTCC_DIV512EN	BIT(11)
+#define RTC_RTCC_DIV32EN	BIT(10)
 #define RTC_RTCS_OFFSET		0x8
 #define RTC_RTCS_RTCF		BIT(29)
+#define RTC_RTCCNT_OFFSET	0xC
 #define RTC_APIVAL_OFFSET	0x10
 #define RTC_RTCVAL_OFFSET	0x14
 
+#define RTC_CLKSEL_SIRC		0
+#define RTC_CLKSEL_FIRC		2
+#define RTC_SIRC_FREQ		(32000ul)
+
 static int s32g_rtc_init(void)
 {
 	size_t reg_size = round_up(S32G_RTC_SIZE, PAGE_SIZE);
@@ -26,6 +38,61 @@ static int s32g_rtc_init(void)
 	return s32_mmap_dynamic_region(S32G_RTC_BASE, reg_size, MT_DEVICE | MT_RW, &mmap_added);
 }
 
+static unsigned long get_rtc_freq(uint32_t rtcc)
+{
+	unsigned long freq;
+
+	switch ((rtcc & RTC_RTCC_CLKSEL_MASK) >> RTC_RTCC_CLKSEL_OFFSET) {
+	case RTC_CLKSEL_SIRC:
+		freq = RTC_SIRC_FREQ;
+		break;
+	case RTC_CLKSEL_FIRC:
+		freq = S32_FIRC_FREQ;
+		break;
+	default:
+		return 0;
+	}
+
+	if (rtcc & RTC_RTCC_DIV512EN)
+		freq /= 512;
+
+	if (rtcc & RTC_RTCC_DIV32EN)
+		freq /= 32;
+
+	return freq;
+}
+
+/*
+ * Time elapsed since the RTC counter reached RTCVAL, i.e. since the RTC
+ * wake-up event. Must be called before s32g_reset_rtc().
+ */
+int s32g_rtc_get_event_age(uint64_t *usec)
+{
+	const uint32_t rtc = S32G_RTC_BASE;
+	uint32_t rtcc, ticks;
+	unsigned long freq;
+	int ret;
+
+	ret = s32g_rtc_init();
+	if (ret)
+		return ret;
+
+	rtcc = mmio_read_32(rtc + RTC_RTCC_OFFSET);
+	if (!(rtcc & RTC_RTCC_CNTEN) ||
+	    !(mmio_read_32(rtc + RTC_RTCS_OFFSET) & RTC_RTCS_RTCF))
+		return -ENOENT;
+
+	freq = get_rtc_freq(rtcc);
+	if (!freq)
+		return -EINVAL;
+
+	ticks = mmio_read_32(rtc + RTC_RTCCNT_OFFSET) -
+		mmio_read_32(rtc + RTC_RTCVAL_OFFSET);
+	*usec = s32_cnt_to_us(ticks, freq);
+
+	return 0;
+}
+
 int s32g_reset_rtc(void)
 {
 	const uint32_t rtc = S32G_RTC_BASE;
@@ -136,30 +136,19 @@ static void s32_scmi_log_notif_ack(struct scmi_log_entry *entry, uintptr_t md_ad
 	s32_entry->plat_data.timestamps[TS_NOTIF_COUNT] = 0;
 }
 
-int log_scmi_plat_init(struct scmi_logger *logger)
+int s32_scmi_md_init(struct s32_stm *stm)
 {
-	int ret = 0, i;
 	uintptr_t base;
 	size_t size;
+	int ret, i;
 
-	assert(ARRAY_SIZE(scmi_log) >= PLATFORM_CORE_COUNT);
-
-	if (!logger)
-		return -EINVAL;
-
-	logger->get_entry = s32_get_log_entry;
-	logger->log_req_data = s32_scmi_log_req_data;
-	logger->log_rsp_data = s32_scmi_log_rsp_data;
-	logger->log_notif_data = s32_scmi_log_notif_data;
-	logger->log_notif_ack = s32_scmi_log_notif_ack;
-
-	ret = s32_stm_init(&timer);
+	ret = s32_stm_init(stm);
 	if (ret) {
 		ERROR("Failed to initialize STM timer.\n");
 		return ret;
 	}
 
-	if (!s32_stm_is_enabled(&timer)) {
+	if (!s32_stm_is_enabled(stm)) {
 		/**
 		 * If the timer was not yet enabled,
 		 * neither was the metadata initialised.
@@ -172,9 +161,24 @@ int log_scmi_plat_init(struct scmi_logger *logger)
 		scp_get_rx_md_info(&base, &size);
 		clear_mem(base, size);
 
-		s32_stm_enable(&timer, true);
+		s32_stm_enable(stm, true);
 	}
 
 	return 0;
 }
 
+int log_scmi_plat_init(struct scmi_logger *logger)
+{
+	assert(ARRAY_SIZE(scmi_log) >= PLATFORM_CORE_COUNT);
+
+	if (!logger)
+		return -EINVAL;
+
+	logger->get_entry = s32_get_log_entry;
+	logger->log_req_data = s32_scmi_log_req_data;
+	logger->log_rsp_data = s32_scmi_log_rsp_data;
+	logger->log_notif_data = s32_scmi_log_notif_data;
+	logger->log_notif_ack = s32_scmi_log_notif_ack;
+
+	return s32_scmi_md_init(&timer);
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <arch_helpers.h>
+#include <string.h>
+#include <common/debug.h>
+#include <lib/utils.h>
+#include <plat/common/platform.h>
+#include <arm/css/scmi/scmi_logger.h>
+#include <arm/css/scmi/scmi_private.h>
+#include <drivers/nxp/s32/stm/s32_stm.h>
+#include <s32cc_scmi_metadata.h>
+#include <s32cc_scmi_trace.h>
+
+CASSERT(sizeof(struct s32_scmi_trace) <= S32_SCMI_TRACE_SIZE,
+	assert_s32_scmi_trace_size);
+CASSERT(IS_POWER_OF_TWO(S32_SCMI_TRACE_RING_LEN),
+	assert_s32_scmi_trace_ring_len);
+
+static struct s32_stm timer;
+static bool trace_ready;
+
+static struct s32_scmi_trace *get_trace(void)
+{
+	return (struct s32_scmi_trace *)S32_SCMI_TRACE_MEM;
+}
+
+static unsigned int lat2bucket(uint32_t lat)
+{
+	unsigned int bucket = 0U;
+
+	if (lat)
+		bucket = 32U - __builtin_clz(lat);
+
+	return MIN(bucket, S32_SCMI_TRACE_BUCKETS - 1U);
+}
+
+static struct s32_scmi_trace_hist *get_hist(struct s32_scmi_trace_cpu *cpu,
+					    uint8_t protocol_id,
+					    uint8_t message_id)
+{
+	struct s32_scmi_trace_hist *hist;
+	unsigned int i;
+
+	for (i = 0U; i < S32_SCMI_TRACE_HIST_NUM; i++) {
+		hist = &cpu->hist[i];
+
+		if (!hist->used) {
+			hist->protocol_id = protocol_id;
+			hist->message_id = message_id;
+			hist->min = UINT32_MAX;
+			/* The IDs are set before the reader may pick them up */
+			dmbst();
+			hist->used = 1U;
+			return hist;
+		}
+
+		if (hist->protocol_id == protocol_id &&
+		    hist->message_id == message_id)
+			return hist;
+	}
+
+	return NULL;
+}
+
+static void update_hist(struct s32_scmi_trace_cpu *cpu,
+			const struct s32_scmi_trace_rec *rec)
+{
+	struct s32_scmi_trace_hist *hist;
+	uint32_t lat;
+
+	hist = get_hist(cpu, rec->protocol_id, rec->message_id);
+	if (!hist) {
+		cpu->hist_dropped++;
+		return;
+	}
+
+	lat = rec->ts[TS_AGENT_RSP_RX] - rec->ts[TS_AGENT_REQ_TX];
+
+	hist->buckets[lat2bucket(lat)]++;
+	hist->sum += lat;
+	hist->min = MIN(hist->min, lat);
+	hist->max = MAX(hist->max, lat);
+
+	if (!(rec->flags & S32_SCMI_TRACE_F_NO_PLAT_TS)) {
+		hist->plat_sum += rec->ts[TS_PLAT_RSP_TX] -
+				  rec->ts[TS_PLAT_REQ_RX];
+		hist->plat_count++;
+	}
+
+	hist->count++;
+}
+
+/*
+ * Only the current core writes to its ring, the sequence number tells a
+ * concurrent reader whether the record it copied is complete.
+ */
+static void add_record(struct s32_scmi_trace_cpu *cpu,
+		       const struct s32_scmi_trace_rec *rec)
+{
+	uint32_t head = cpu->head;
+	struct s32_scmi_trace_rec *slot;
+
+	slot = &cpu->ring[head & (S32_SCMI_TRACE_RING_LEN - 1U)];
+
+	slot->seq = 0U;
+	dmbst();
+
+	slot->protocol_id = rec->protocol_id;
+	slot->message_id = rec->message_id;
+	slot->flags = rec->flags;
+	slot->status = rec->status;
+	memcpy(slot->ts, rec->ts, sizeof(slot->ts));
+	dmbst();
+
+	slot->seq = head + 1U;
+	dmbst();
+
+	cpu->head = head + 1U;
+}
+
+void trace_scmi_init(void)
+{
+	struct s32_scmi_trace *trace = get_trace();
+
+	if (s32_scmi_md_init(&timer)) {
+		ERROR("Could not init SCMI trace.\n");
+		return;
+	}
+
+	zeromem(trace, sizeof(*trace));
+
+	trace->hdr.version = S32_SCMI_TRACE_VERSION;
+	trace->hdr.n_cpus = PLATFORM_CORE_COUNT;
+	trace->hdr.ring_len = S32_SCMI_TRACE_RING_LEN;
+	trace->hdr.hist_num = S32_SCMI_TRACE_HIST_NUM;
+	trace->hdr.buckets = S32_SCMI_TRACE_BUCKETS;
+	dmbst();
+	trace->hdr.magic = S32_SCMI_TRACE_MAGIC;
+
+	trace_ready = true;
+}
+
+void trace_scmi_req(mailbox_mem_t *mbx_mem, uintptr_t md_addr)
+{
+	struct s32_scmi_metadata *md = (struct s32_scmi_metadata *)md_addr;
+
+	if (!trace_ready || !md)
+		return;
+
+	/* Don't take the SCP timestamps of the previous request */
+	md->timestamps[TS_PLAT_REQ_RX] = 0U;
+	md->timestamps[TS_PLAT_RSP_TX] = 0U;
+	md->timestamps[TS_AGENT_REQ_TX] = s32_stm_get_count(&timer);
+}
+
+void trace_scmi_rsp(mailbox_mem_t *mbx_mem, uintptr_t md_addr)
+{
+	struct s32_scmi_metadata *md = (struct s32_scmi_metadata *)md_addr;
+	uint32_t timestamp = s32_stm_get_count(&timer);
+	unsigned int core = plat_my_core_pos();
+	struct s32_scmi_trace_cpu *cpu;
+	struct s32_scmi_trace_rec rec = {0};
+
+	if (!trace_ready || !md)
+		return;
+
+	if (core >= PLATFORM_CORE_COUNT)
+		return;
+
+	md->timestamps[TS_AGENT_RSP_RX] = timestamp;
+
+	rec.protocol_id = SCMI_MSG_GET_PROTO(mbx_mem->msg_header);
+	rec.message_id = SCMI_MSG_GET_MSG_ID(mbx_mem->msg_header);
+	/* The status follows the header in all the responses */
+	if (mbx_mem->len >= sizeof(mbx_mem->msg_header) + sizeof(int32_t))
+		rec.status = (int32_t)mbx_mem->payload[0];
+
+	rec.ts[TS_AGENT_REQ_TX] = md->timestamps[TS_AGENT_REQ_TX];
+	rec.ts[TS_PLAT_REQ_RX] = md->timestamps[TS_PLAT_REQ_RX];
+	rec.ts[TS_PLAT_RSP_TX] = md->timestamps[TS_PLAT_RSP_TX];
+	rec.ts[TS_AGENT_RSP_RX] = timestamp;
+
+	if (!rec.ts[TS_PLAT_REQ_RX] || !rec.ts[TS_PLAT_RSP_TX])
+		rec.flags |= S32_SCMI_TRACE_F_NO_PLAT_TS;
+
+	cpu = &get_trace()->cpu[core];
+
+	add_record(cpu, &rec);
+	update_hist(cpu, &rec);
+}
@@ -47,7 +47,7 @@ int s32_stm_init(struct s32_stm *stm)
 	if (fdt_get_address(&fdt) == 0)
 		return -EINVAL;
 
-	stm_node = fdt_node_offset_by_compatible(fdt, -1, "nxp,s32cc-stm-global");
+	stm_node = dt_node_offset_by_compatible(fdt, -1, "nxp,s32cc-stm-global");
 	if (stm_node == -1)
 		return -ENODEV;
 
@@ -27,6 +27,7 @@ static bool message_id_is_supported(size_t message_id);
 #pragma weak plat_scmi_perf_get_limits
 #pragma weak plat_scmi_perf_set_level
 #pragma weak plat_scmi_perf_get_level
+#pragma weak plat_scmi_perf_describe_fastchannel
 
 size_t plat_scmi_perf_domain_count(unsigned int agent_id __unused)
 {
@@ -106,6 +107,14 @@ int32_t plat_scmi_perf_get_level(unsigned int agent_id __unused,
 	return SCMI_NOT_SUPPORTED;
 }
 
+int32_t plat_scmi_perf_describe_fastchannel(unsigned int agent_id __unused,
+					    unsigned int domain_id __unused,
+					    unsigned int message_id __unused,
+					    struct scmi_perf_fastchannel *fc __unused)
+{
+	return SCMI_NOT_SUPPORTED;
+}
+
 
 static void report_version(struct scmi_msg *msg)
 {
@@ -149,12 +158,29 @@ static void report_attributes(struct scmi_msg *msg)
 	scmi_write_response(msg, &return_values, sizeof(return_values));
 }
 
+/* A message has a FastChannel if at least one domain provides it */
+static bool has_fastchannel(unsigned int agent_id, unsigned int message_id)
+{
+	size_t domain_count = plat_scmi_perf_domain_count(agent_id);
+	struct scmi_perf_fastchannel fc;
+	unsigned int domain_id;
+
+	for (domain_id = 0U; domain_id < domain_count; domain_id++) {
+		if (plat_scmi_perf_describe_fastchannel(agent_id, domain_id,
+							message_id, &fc) ==
+		    SCMI_SUCCESS)
+			return true;
+	}
+
+	return false;
+}
+
 static void report_message_attributes(struct scmi_msg *msg)
 {
 	struct scmi_protocol_message_attributes_a2p *in_args = (void *)msg->in;
 	struct scmi_protocol_message_attributes_p2a return_values = {
 		.status = SCMI_SUCCESS,
-		.attributes = 0U, /* FastChannels unsupported */
+		.attributes = 0U,
 	};
 
 	if (msg->in_size != sizeof(*in_args)) {
@@ -167,6 +193,9 @@ static void report_message_attributes(struct scmi_msg *msg)
 		return;
 	}
 
+	if (has_fastchannel(msg->agent_id, in_args->message_id))
+		return_values.attributes |= SCMI_PERF_MSG_ATTRIBUTES_FASTCHANNEL;
+
 	scmi_write_response(msg, &return_values, sizeof(return_values));
 }
 
@@ -368,6 +397,53 @@ static void scmi_performance_level_get(struct scmi_msg *msg)
 	scmi_write_response(msg, &return_values, sizeof(return_values));
 }
 
+static void scmi_performance_describe_fastchannel(struct scmi_msg *msg)
+{
+	const struct scmi_performance_describe_fc_a2p *in_args = (void *)msg->in;
+	struct scmi_performance_describe_fc_p2a return_values = {
+		.status = SCMI_SUCCESS,
+	};
+	struct scmi_perf_fastchannel fc = { 0 };
+	unsigned int domain_id = 0U;
+	int32_t status;
+
+	if (msg->in_size != sizeof(*in_args)) {
+		scmi_status_response(msg, SCMI_PROTOCOL_ERROR);
+		return;
+	}
+
+	domain_id = SPECULATION_SAFE_VALUE(in_args->domain_id);
+	if (domain_id >= plat_scmi_perf_domain_count(msg->agent_id)) {
+		scmi_status_response(msg, SCMI_NOT_FOUND);
+		return;
+	}
+
+	status = plat_scmi_perf_describe_fastchannel(msg->agent_id, domain_id,
+						     in_args->message_id, &fc);
+	if (status != SCMI_SUCCESS) {
+		scmi_status_response(msg, status);
+		return;
+	}
+
+	return_values.rate_limit = fc.rate_limit;
+	return_values.chan_addr_low = (uint32_t)fc.chan_addr;
+	return_values.chan_addr_high = (uint32_t)((uint64_t)fc.chan_addr >> 32);
+	return_values.chan_size = fc.chan_size;
+
+	if (fc.db_addr != 0U) {
+		return_values.attributes = SCMI_PERF_FC_ATTRIBUTES_DOORBELL |
+			(SCMI_PERF_FC_ATTRIBUTES_DB_WIDTH_32 <<
+			 SCMI_PERF_FC_ATTRIBUTES_DB_WIDTH_POS);
+		return_values.doorbell_addr_low = (uint32_t)fc.db_addr;
+		return_values.doorbell_addr_high =
+			(uint32_t)((uint64_t)fc.db_addr >> 32);
+		return_values.doorbell_set_mask_low = fc.db_set_mask;
+		return_values.doorbell_preserve_mask_low = fc.db_preserve_mask;
+	}
+
+	scmi_write_response(msg, &return_values, sizeof(return_values));
+}
+
 static const scmi_msg_handler_t scmi_perf_handler_table[] = {
 	[SCMI_PROTOCOL_VERSION] = report_version,
 	[SCMI_PROTOCOL_ATTRIBUTES] = report_attributes,
@@ -378,6 +454,7 @@ static const scmi_msg_handler_t scmi_perf_handler_table[] = {
 	[SCMI_PERFORMANCE_LIMITS_GET] = scmi_performance_limits_get,
 	[SCMI_PERFORMANCE_LEVEL_SET] = scmi_performance_level_set,
 	[SCMI_PERFORMANCE_LEVEL_GET] = scmi_performance_level_get,
+	[SCMI_PERFORMANCE_DESCRIBE_FASTCHANNEL] = scmi_performance_describe_fastchannel,
 
 };
 
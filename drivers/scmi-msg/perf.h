@@ -19,6 +19,7 @@ enum scmi_perf_command_id {
 	SCMI_PERFORMANCE_LIMITS_GET = 0x6,
 	SCMI_PERFORMANCE_LEVEL_SET = 0x7,
 	SCMI_PERFORMANCE_LEVEL_GET = 0x8,
+	SCMI_PERFORMANCE_DESCRIBE_FASTCHANNEL = 0xB,
 };
 
 /* Protocol attributes */
@@ -131,4 +132,34 @@ struct scmi_performance_level_get_p2a {
 	uint32_t performance_level;
 };
 
+/*
+ * Describe FastChannel
+ */
+#define SCMI_PERF_FC_ATTRIBUTES_DOORBELL		BIT_32(0)
+#define SCMI_PERF_FC_ATTRIBUTES_DB_WIDTH_POS		1
+#define SCMI_PERF_FC_ATTRIBUTES_DB_WIDTH_32		2U
+
+/* Message attributes */
+#define SCMI_PERF_MSG_ATTRIBUTES_FASTCHANNEL		BIT_32(0)
+
+struct scmi_performance_describe_fc_a2p {
+	uint32_t domain_id;
+	uint32_t message_id;
+};
+
+struct scmi_performance_describe_fc_p2a {
+	int32_t status;
+	uint32_t attributes;
+	uint32_t rate_limit;
+	uint32_t chan_addr_low;
+	uint32_t chan_addr_high;
+	uint32_t chan_size;
+	uint32_t doorbell_addr_low;
+	uint32_t doorbell_addr_high;
+	uint32_t doorbell_set_mask_low;
+	uint32_t doorbell_set_mask_high;
+	uint32_t doorbell_preserve_mask_low;
+	uint32_t doorbell_preserve_mask_high;
+};
+
 #endif /* SCMI_MSG_PERF_H */
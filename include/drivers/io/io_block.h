@@ -19,6 +19,14 @@ typedef struct io_block_dev_spec {
 	io_block_spec_t	buffer;
 	io_block_ops_t	ops;
 	size_t		block_size;
+	/*
+	 * Optional direct reads: when direct_align is non-zero, whole blocks
+	 * whose destination is aligned to direct_align bytes are read straight
+	 * into the caller's buffer, up to direct_max bytes per request, instead
+	 * of going through the bounce buffer.
+	 */
+	size_t		direct_align;
+	size_t		direct_max;
 } io_block_dev_spec_t;
 
 struct io_dev_connector;
@@ -60,10 +60,19 @@
 #define CMD_EXTCSD_PARTITION_CONFIG	179
 #define CMD_EXTCSD_BUS_WIDTH		183
 #define CMD_EXTCSD_HS_TIMING		185
+#define CMD_EXTCSD_DEVICE_TYPE		196
 #define CMD_EXTCSD_PART_SWITCH_TIME	199
 #define CMD_EXTCSD_SEC_CNT		212
 #define CMD_EXTCSD_BOOT_SIZE_MULT	226
 
+#define EXT_CSD_TIMING_LEGACY		U(0)
+#define EXT_CSD_TIMING_HS		U(1)
+#define EXT_CSD_TIMING_HS200		U(2)
+
+#define EXT_CSD_CARD_TYPE_HS_52		BIT(1)
+#define EXT_CSD_CARD_TYPE_DDR_52	(BIT(2) | BIT(3))
+#define EXT_CSD_CARD_TYPE_HS200		(BIT(4) | BIT(5))
+
 #define EXT_CSD_PART_CONFIG_ACC_MASK	GENMASK(2, 0)
 #define PART_CFG_BOOT_PARTITION1_ENABLE	(U(1) << 3)
 #define PART_CFG_BOOT_PARTITION1_ACCESS (U(1) << 0)
@@ -114,6 +123,16 @@
 #define MMC_FLAG_CMD23			(U(1) << 0)
 #define MMC_FLAG_SD_CMD6		(U(1) << 1)
 
+/* Bus timings, selected through mmc_ops.set_timing() */
+#define MMC_TIMING_LEGACY		U(0)
+#define MMC_TIMING_HS			U(1)	/* eMMC HS52 or SD High Speed */
+#define MMC_TIMING_DDR52		U(2)
+#define MMC_TIMING_HS200		U(3)
+#define MMC_TIMING_CAP(x)		BIT(x)
+
+#define MMC_HS_MAX_FREQ			(52 * 1000 * 1000)
+#define MMC_HS200_MAX_FREQ		(200 * 1000 * 1000)
+
 #define CMD8_CHECK_PATTERN		U(0xAA)
 #define VHS_2_7_3_6_V			BIT(8)
 
@@ -138,6 +157,11 @@ struct mmc_ops {
 	int (*prepare)(int lba, uintptr_t buf, size_t size);
 	int (*read)(int lba, uintptr_t buf, size_t size);
 	int (*write)(int lba, const uintptr_t buf, size_t size);
+	/*
+	 * Optional. Switch the host to one of the MMC_TIMING_* bus timings,
+	 * at the max_bus_freq of the device, and run the tuning if required.
+	 */
+	int (*set_timing)(unsigned int timing);
 };
 
 struct mmc_csd_emmc {
@@ -259,6 +283,10 @@ struct mmc_device_info {
 						 * 10ms by default
 						 */
 	enum mmc_device_type	mmc_dev_type;	/* Type of MMC */
+	unsigned int		timing_caps;	/* eMMC MMC_TIMING_CAP()s allowed
+						 * by the host, needs set_timing
+						 */
+	unsigned int		timing;		/* Current MMC_TIMING_* */
 };
 
 size_t mmc_read_blocks(int lba, uintptr_t buf, size_t size);
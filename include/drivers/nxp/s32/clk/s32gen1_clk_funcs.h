@@ -18,6 +18,11 @@ unsigned long s32gen1_set_rate(struct clk *c, unsigned long rate);
 int s32gen1_set_parent(struct clk *c, struct clk *p);
 int s32gen1_enable(struct clk *c, int enable);
 int s32gen1_disable(struct clk *c);
+/*
+ * Account for an enabled clock, as s32gen1_enable() does, without programming
+ * it. For clocks set up by a register script.
+ */
+int s32gen1_enable_refs(struct clk *c);
 int s32gen1_enable_cgm_mux(struct s32gen1_mux *mux,
 			   struct s32gen1_clk_priv *priv, int enable);
 int s32gen1_cgm_mux_to_safe(struct s32gen1_mux *mux,
@@ -28,6 +33,8 @@ unsigned long s32gen1_get_rate(struct clk *clk);
 int s32gen1_get_rates(struct clk *c, struct s32gen1_clk_rates *clk_rates);
 unsigned long get_module_rate(struct s32gen1_clk_obj *module,
 			      struct s32gen1_clk_priv *priv);
+void s32gen1_clk_invalidate_rate(struct s32gen1_clk_obj *module);
+void s32gen1_clk_invalidate_rates(void);
 unsigned long s32gen1_get_minrate(struct clk *c);
 unsigned long s32gen1_get_maxrate(struct clk *c);
 
@@ -268,6 +268,10 @@ enum s32gen1_part_block_type {
 struct s32gen1_clk_obj {
 	enum s32gen1_clkm_type type;
 	uint32_t refcount;
+	/* Rate cache, see get_module_rate() */
+	uint32_t rate_gen;
+	unsigned long prate;
+	unsigned long rate;
 };
 
 struct s32gen1_clk {
@@ -57,6 +57,9 @@ unsigned long s32gen1_scmi_clk_set_rate(struct clk *clk, unsigned long rate);
 int32_t plat_scmi_clock_agent_reset(unsigned int agent_id);
 int32_t plat_scmi_clocks_reset_agents(void);
 void update_a53_clk_state(bool enabled);
+#if (S32_CLK_RATE_BENCH == 1)
+void s32_scmi_clk_rate_bench(void);
+#endif
 
 #endif
 
@@ -14,6 +14,7 @@
 
 #define SCMI_PERF_SET_LIMITS   		BIT(31)
 #define SCMI_PERF_SET_LEVEL    		BIT(30)
+#define SCMI_PERF_FASTCHANNELS		BIT(27)
 
 #define S32GEN1_SCMI_MAX_LEVELS		S32GEN1_MAX_NUM_FREQ
 
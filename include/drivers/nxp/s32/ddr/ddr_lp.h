@@ -69,6 +69,12 @@ void ddrss_to_io_retention_mode(void);
 /* Transition the DDR SubSystem from retention mode to normal mode. */
 uint32_t ddrss_to_normal_mode(uintptr_t csr_array);
 
+/*
+ * Initialize the DDR SubSystem on cold boot by restoring the CSRs and DDRC
+ * registers captured by a previous training run, instead of training again.
+ */
+uint32_t ddrss_init_from_snapshot(uintptr_t csr_array);
+
 /* Store Configuration Status Registers. */
 void store_csr(uintptr_t store_at);
 
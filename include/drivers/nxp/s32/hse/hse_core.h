@@ -7,6 +7,7 @@
 #ifndef HSE_CORE_H
 #define HSE_CORE_H
 
+#include <stdbool.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <hse_interface.h>
@@ -15,14 +16,43 @@
  * enum hse_ch_type - channel type
  * @HSE_CHANNEL_ADMIN: restricted to administrative services
  * @HSE_CHANNEL_CRYPTO: channel available for crypto services
+ * @HSE_CHANNEL_CRYPTO_1: additional channel for parallel crypto services
+ * @HSE_CHANNEL_CRYPTO_2: additional channel for parallel crypto services
+ * @HSE_CHANNEL_CRYPTO_3: additional channel for parallel crypto services
  */
 enum hse_ch_type {
 	HSE_CHANNEL_ADMIN = 0u,
 	HSE_CHANNEL_CRYPTO,
+	HSE_CHANNEL_CRYPTO_1,
+	HSE_CHANNEL_CRYPTO_2,
+	HSE_CHANNEL_CRYPTO_3,
 	HSE_CHANNEL_NUM
 };
 
+/**
+ * struct hse_req - asynchronous service request
+ * @srv_desc: copy of the service descriptor
+ * @channel: channel the request was submitted on
+ * @srv_rsp: HSE service response, valid once completed
+ * @status: completion status, 0 on success or specific errno code
+ * @done: request has been completed
+ * @next: next request in the same queue, driver internal
+ */
+struct hse_req {
+	hseSrvDescriptor_t srv_desc;
+	enum hse_ch_type channel;
+	uint32_t srv_rsp;
+	int status;
+	bool done;
+	struct hse_req *next;
+};
+
 int hse_srv_req_sync(enum hse_ch_type channel, const hseSrvDescriptor_t *srv_desc);
+int hse_srv_req_submit(enum hse_ch_type channel,
+		       const hseSrvDescriptor_t *srv_desc,
+		       struct hse_req *req);
+int hse_wait(struct hse_req *req);
+struct hse_req *hse_wait_any(void);
 int hse_driver_init(void);
 bool is_secboot_active(void);
 
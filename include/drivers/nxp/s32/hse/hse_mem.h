@@ -9,10 +9,35 @@
 #include <stddef.h>
 #include <stdint.h>
 
+/**
+ * struct hse_mem_stats - reserved memory pool usage
+ * @total_size: usable size of the pool, in bytes
+ * @used_size: bytes taken by allocated blocks, metadata included
+ * @peak_used_size: highest value reached by @used_size
+ * @largest_free: largest block that can currently be allocated
+ * @used_blocks: number of allocated blocks
+ * @free_blocks: number of free blocks, a measure of fragmentation
+ * @peak_free_blocks: highest value reached by @free_blocks
+ * @failed_allocs: number of allocation requests that could not be served
+ */
+struct hse_mem_stats {
+	size_t total_size;
+	size_t used_size;
+	size_t peak_used_size;
+	size_t largest_free;
+	unsigned int used_blocks;
+	unsigned int free_blocks;
+	unsigned int peak_free_blocks;
+	unsigned int failed_allocs;
+};
+
 int hse_mem_setup(uintptr_t base_addr, size_t mem_size);
 void *hse_mem_alloc(size_t size);
 void hse_mem_free(void *addr);
 void *hse_memcpy(void *dest, const void *src, size_t size);
 uintptr_t hse_virt_to_phys(const void *addr);
+#if (S32_HSE_MEM_BENCH == 1)
+void hse_mem_get_stats(struct hse_mem_stats *stats);
+#endif
 
 #endif /* HSE_MEM_H */
@@ -7,6 +7,17 @@
 #ifndef S32_MMC_H
 #define S32_MMC_H
 
+/*
+ * Data transfers go through the uSDHC ADMA2 engine, one descriptor table
+ * covering a whole CMD18/CMD25 transfer.
+ */
+#define S32_MMC_ADMA2_DESC_NUM		(64U)
+#define S32_MMC_ADMA2_DESC_MAX_LEN	(0xfe00U)
+#define S32_MMC_MAX_XFER_SIZE		(S32_MMC_ADMA2_DESC_NUM * \
+					 S32_MMC_ADMA2_DESC_MAX_LEN)
+/* ADMA2 requires word aligned data buffers */
+#define S32_MMC_DMA_ALIGN		(4U)
+
 int s32_mmc_register(void);
 
 #endif /* S32_MMC_H */
@@ -0,0 +1,19 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef S32_QSPI_H
+#define S32_QSPI_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Granule of the IP command reads exposed through io_block */
+#define S32_QSPI_BLOCK_SIZE	(512U)
+
+int s32_qspi_init(void);
+size_t s32_qspi_read(int lba, uintptr_t buf, size_t size);
+
+#endif /* S32_QSPI_H */
@@ -6,6 +6,9 @@
 #ifndef _S32G_RTC_H_
 #define _S32G_RTC_H_
 
+#include <stdint.h>
+
 int s32g_reset_rtc(void);
+int s32g_rtc_get_event_age(uint64_t *usec);
 
 #endif
@@ -215,6 +215,40 @@ int32_t plat_scmi_perf_describe_levels(unsigned int agent_id,
 				    struct scmi_perf_level *levels,
 				    size_t *num_levels);
 
+/*
+ * struct scmi_perf_fastchannel - FastChannel of a performance domain message
+ *
+ * @chan_addr: Address of the shared memory cell holding the message data
+ * @chan_size: Byte size of the cell
+ * @rate_limit: Minimum interval between two updates, in microseconds
+ * @db_addr: Address of the doorbell register, or 0 if the server polls
+ * @db_set_mask: Bits to set in the doorbell register to ring it
+ * @db_preserve_mask: Doorbell register bits to preserve when ringing it
+ */
+struct scmi_perf_fastchannel {
+	uintptr_t chan_addr;
+	uint32_t chan_size;
+	uint32_t rate_limit;
+	uintptr_t db_addr;
+	uint32_t db_set_mask;
+	uint32_t db_preserve_mask;
+};
+
+/*
+ * Describe the FastChannel of a performance domain message
+ *
+ * @agent_id: SCMI agent ID
+ * @domain_id: SCMI performance domain ID
+ * @message_id: ID of the message the FastChannel replaces
+ * @fc: FastChannel description filled by the platform
+ * Return an SCMI compliant error code, SCMI_NOT_SUPPORTED if the message has
+ * no FastChannel
+ */
+int32_t plat_scmi_perf_describe_fastchannel(unsigned int agent_id,
+					    unsigned int domain_id,
+					    unsigned int message_id,
+					    struct scmi_perf_fastchannel *fc);
+
 /* Handlers for SCMI Reset Domain protocol services */
 
 /*
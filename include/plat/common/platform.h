@@ -273,6 +273,13 @@ int bl2_plat_handle_post_image_load(unsigned int image_id);
 /*******************************************************************************
  * Optional BL2 functions (may be overridden)
  ******************************************************************************/
+/*
+ * Platforms that authenticate the loaded images in the background must
+ * complete all pending authentications here, before BL2 hands over to them.
+ * See the porting guide for the full contract.
+ */
+int bl2_plat_handle_pending_image_auth(void);
+
 #if MEASURED_BOOT
 void bl2_plat_mboot_init(void);
 void bl2_plat_mboot_finish(void);
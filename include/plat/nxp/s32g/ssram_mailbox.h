@@ -1,5 +1,5 @@
 /*
- * Copyright 2020-2022 NXP
+ * Copyright 2020-2022, 2024 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -7,16 +7,36 @@
 #define SSRAM_MAILBOX_H
 
 #include <platform_def.h>
+#include <s32cc_reg_script.h>
 
 #define CSR_SETTING_OFFSET offsetof(struct s32g_ssram_mailbox, csr_settings)
 #define BL31SSRAM_CSR_BASE (BL31SSRAM_MAILBOX + CSR_SETTING_OFFSET)
 #define BL31SSRAM_CSR_SIZE (0x2CC)
 
+#define S32G_RESUME_PROFILE_MAGIC	(0x50525352U)	/* "RSRP" */
+#define S32G_RESUME_PROFILE_MAX_OPS	(128U)
+
 typedef void (*s32g_warm_entrypoint_t)(void);
 
+/*
+ * Register programming captured by BL31 when entering standby and replayed
+ * on the way back, see s32g_resume_profile.h. The first 'n_pre_ddr' ops are
+ * run by BL2 before the DDR leaves retention, the next 'n_post_ddr' ones by
+ * BL31.
+ */
+struct s32g_resume_profile {
+	uint32_t magic;
+	uint32_t crc;
+	uint16_t n_pre_ddr;
+	uint16_t n_post_ddr;
+	uint32_t reserved;
+	struct s32_reg_op ops[S32G_RESUME_PROFILE_MAX_OPS];
+};
+
 struct s32g_ssram_mailbox {
 	s32g_warm_entrypoint_t bl31_warm_entrypoint __aligned(2);
 	uint8_t csr_settings[BL31SSRAM_CSR_SIZE] __aligned(4);
+	struct s32g_resume_profile resume_profile __aligned(8);
 };
 
 #endif
@@ -0,0 +1,270 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <common/debug.h>
+#include <tf_lz4.h>
+
+/* LZ4 frame format, as produced by the lz4 command line tool */
+#define LZ4F_MAGIC		(0x184D2204U)
+#define LZ4F_FLG_VERSION_MASK	(0xC0U)
+#define LZ4F_FLG_VERSION	(0x40U)
+#define LZ4F_FLG_BLOCK_CSUM	(0x10U)
+#define LZ4F_FLG_CONTENT_SIZE	(0x08U)
+#define LZ4F_FLG_CONTENT_CSUM	(0x04U)
+#define LZ4F_FLG_DICT_ID	(0x01U)
+#define LZ4F_BLOCK_UNCOMPRESSED	(0x80000000U)
+#define LZ4F_BLOCK_SIZE_MASK	(0x7FFFFFFFU)
+
+/* LZ4 block format */
+#define LZ4_RUN_MASK		(0xFU)
+#define LZ4_MIN_MATCH		(4U)
+
+struct lz4_stream {
+	const uint8_t *ip;
+	const uint8_t *iend;
+	uint8_t *ostart;
+	uint8_t *op;
+	uint8_t *oend;
+};
+
+static uint32_t get_le32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+	       ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t get_le64(const uint8_t *p)
+{
+	return (uint64_t)get_le32(p) | ((uint64_t)get_le32(p + 4) << 32);
+}
+
+static bool in_avail(const struct lz4_stream *s, size_t len)
+{
+	return (size_t)(s->iend - s->ip) >= len;
+}
+
+static bool out_avail(const struct lz4_stream *s, size_t len)
+{
+	return (size_t)(s->oend - s->op) >= len;
+}
+
+static int read_length(const uint8_t **ip, const uint8_t *iend, size_t *len)
+{
+	uint8_t b;
+
+	do {
+		if (*ip >= iend)
+			return -EINVAL;
+
+		b = *(*ip)++;
+		*len += b;
+	} while (b == 0xFFU);
+
+	return 0;
+}
+
+/*
+ * Decode one compressed block. Matches may reach back into the previously
+ * decoded blocks, which covers both the linked and the independent block
+ * modes since the whole image is decoded into a single contiguous buffer.
+ */
+static int lz4_decode_block(struct lz4_stream *s, const uint8_t *bend)
+{
+	const uint8_t *ip = s->ip;
+	uint8_t *op = s->op;
+	const uint8_t *match;
+	size_t lit_len, match_len, offset;
+	uint8_t token;
+
+	while (ip < bend) {
+		token = *ip++;
+
+		lit_len = token >> 4;
+		if (lit_len == LZ4_RUN_MASK && read_length(&ip, bend, &lit_len))
+			return -EINVAL;
+
+		if ((size_t)(bend - ip) < lit_len ||
+		    (size_t)(s->oend - op) < lit_len)
+			return -EINVAL;
+
+		memcpy(op, ip, lit_len);
+		ip += lit_len;
+		op += lit_len;
+
+		/* The last sequence of a block carries literals only */
+		if (ip == bend)
+			break;
+
+		if (bend - ip < 2)
+			return -EINVAL;
+
+		offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+		ip += 2;
+		if (offset == 0U || offset > (size_t)(op - s->ostart))
+			return -EINVAL;
+
+		match_len = token & LZ4_RUN_MASK;
+		if (match_len == LZ4_RUN_MASK &&
+		    read_length(&ip, bend, &match_len))
+			return -EINVAL;
+		match_len += LZ4_MIN_MATCH;
+
+		if ((size_t)(s->oend - op) < match_len)
+			return -EINVAL;
+
+		match = op - offset;
+		if (offset >= match_len) {
+			memcpy(op, match, match_len);
+			op += match_len;
+		} else {
+			/* Overlapping copy, replicates the last offset bytes */
+			while (match_len-- != 0U)
+				*op++ = *match++;
+		}
+	}
+
+	s->ip = ip;
+	s->op = op;
+
+	return 0;
+}
+
+static int lz4_decode_frame(struct lz4_stream *s)
+{
+	uint64_t content_size = 0;
+	uint32_t block_size;
+	size_t block_csum;
+	uint8_t flg;
+	int ret;
+
+	/* Magic, FLG, BD */
+	if (!in_avail(s, 6) || get_le32(s->ip) != LZ4F_MAGIC) {
+		ERROR("LZ4: bad frame magic\n");
+		return -EINVAL;
+	}
+
+	flg = s->ip[4];
+	s->ip += 6;
+
+	if ((flg & LZ4F_FLG_VERSION_MASK) != LZ4F_FLG_VERSION) {
+		ERROR("LZ4: unsupported frame version\n");
+		return -EINVAL;
+	}
+
+	if (flg & LZ4F_FLG_DICT_ID) {
+		ERROR("LZ4: dictionaries are not supported\n");
+		return -ENOTSUP;
+	}
+
+	if (flg & LZ4F_FLG_CONTENT_SIZE) {
+		if (!in_avail(s, 8))
+			return -EINVAL;
+
+		content_size = get_le64(s->ip);
+		s->ip += 8;
+
+		if (!out_avail(s, content_size)) {
+			ERROR("LZ4: output buffer too small\n");
+			return -ENOMEM;
+		}
+	}
+
+	/* Header checksum */
+	if (!in_avail(s, 1))
+		return -EINVAL;
+	s->ip++;
+
+	block_csum = (flg & LZ4F_FLG_BLOCK_CSUM) ? 4U : 0U;
+
+	while (true) {
+		if (!in_avail(s, 4))
+			return -EINVAL;
+
+		block_size = get_le32(s->ip);
+		s->ip += 4;
+
+		/* End mark */
+		if (block_size == 0U)
+			break;
+
+		if (!in_avail(s, (block_size & LZ4F_BLOCK_SIZE_MASK) +
+			      block_csum))
+			return -EINVAL;
+
+		if (block_size & LZ4F_BLOCK_UNCOMPRESSED) {
+			block_size &= LZ4F_BLOCK_SIZE_MASK;
+			if (!out_avail(s, block_size))
+				return -ENOMEM;
+
+			memcpy(s->op, s->ip, block_size);
+			s->ip += block_size;
+			s->op += block_size;
+		} else {
+			ret = lz4_decode_block(s, s->ip + block_size);
+			if (ret)
+				return ret;
+		}
+
+		s->ip += block_csum;
+	}
+
+	/*
+	 * The image is authenticated in its compressed form, so the optional
+	 * checksums are skipped. The content size, when present, is still
+	 * checked to catch truncated output.
+	 */
+	if (flg & LZ4F_FLG_CONTENT_CSUM) {
+		if (!in_avail(s, 4))
+			return -EINVAL;
+		s->ip += 4;
+	}
+
+	if ((flg & LZ4F_FLG_CONTENT_SIZE) &&
+	    (uint64_t)(s->op - s->ostart) != content_size) {
+		ERROR("LZ4: content size mismatch\n");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/*
+ * unlz4 - decompress LZ4 frame data
+ * @in_buf: source of compressed input. Upon exit, the end of input.
+ * @in_len: length of in_buf
+ * @out_buf: destination of decompressed output. Upon exit, the end of output.
+ * @out_len: length of out_buf
+ * @work_buf: workspace (unused, LZ4 decodes straight into out_buf)
+ * @work_len: length of workspace
+ */
+int unlz4(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
+	  size_t out_len, uintptr_t work_buf, size_t work_len)
+{
+	struct lz4_stream s = {
+		.ip = (const uint8_t *)*in_buf,
+		.iend = (const uint8_t *)(*in_buf + in_len),
+		.ostart = (uint8_t *)*out_buf,
+		.op = (uint8_t *)*out_buf,
+		.oend = (uint8_t *)(*out_buf + out_len),
+	};
+	int ret;
+
+	(void)work_buf;
+	(void)work_len;
+
+	ret = lz4_decode_frame(&s);
+	if (ret)
+		return ret;
+
+	*in_buf = (uintptr_t)s.ip;
+	*out_buf = (uintptr_t)s.op;
+
+	return 0;
+}
@@ -348,6 +348,10 @@ NR_OF_FW_BANKS			:= 2
 # update metadata structure.
 NR_OF_IMAGES_IN_FW_BANK		:= 1
 
+# Build option to define the number of ToC entries the FIP driver indexes at
+# device init, 0 disables the index.
+FIP_TOC_INDEX_SIZE		:= 0
+
 # Disable Firmware update support by default
 PSA_FWU_SUPPORT			:= 0
 
@@ -12,6 +12,7 @@
 #include <errno.h>
 #include <common/debug.h>
 #include <lib/xlat_tables/xlat_tables_v2.h>
+#include <plat/common/platform.h>
 
 /**
  * container_of - cast a member of a structure out to the containing structure
@@ -51,6 +52,35 @@ static inline int s32_mmap_dynamic_region(unsigned long long base_pa, size_t siz
 	return 0;
 }
 
+/*
+ * Conversions of counter ticks, shared by the benchmarks and the timing
+ * traces. The s32_ticks_* helpers take Arm generic counter ticks.
+ */
+static inline unsigned long long s32_cnt_to_us(uint64_t cnt, uint64_t freq)
+{
+	return (cnt * 1000000U) / freq;
+}
+
+static inline unsigned long long s32_ticks_to_us(uint64_t ticks)
+{
+	return s32_cnt_to_us(ticks, plat_get_syscnt_freq2());
+}
+
+static inline unsigned long long s32_ticks_to_ns(uint64_t ticks)
+{
+	return (ticks * 1000000000U) / plat_get_syscnt_freq2();
+}
+
+/* Throughput, in KiB/s, of a transfer of @bytes that took @ticks */
+static inline unsigned long long s32_ticks_to_kib_s(uint64_t bytes,
+						    uint64_t ticks)
+{
+	if (!ticks)
+		return 0;
+
+	return (bytes / 1024U) * plat_get_syscnt_freq2() / ticks;
+}
+
 unsigned long get_sdhc_clk_freq(void);
 
 #endif /* S32_BL_COMMON_H */
@@ -41,6 +41,7 @@ extern const bool fip_location_mem;
 extern const unsigned long fip_mem_offset;
 
 bool is_lockstep_enabled(void);
+uint32_t assert_ddr_reset(void);
 
 void s32_early_plat_init(void);
 void s32_early_plat_setup(void);
@@ -75,6 +76,22 @@ static inline void hse_secboot_setup(void)
 }
 #endif
 
+#if TRUSTED_BOARD_BOOT && (S32_HSE_DEFERRED_AUTH == 1)
+/* Complete the image hashes still running on HSE */
+int s32_crypto_wait_deferred(void);
+/* Image the hashes submitted from now on belong to */
+void s32_crypto_set_image_id(unsigned int image_id);
+#else
+static inline int s32_crypto_wait_deferred(void)
+{
+	return 0;
+}
+
+static inline void s32_crypto_set_image_id(unsigned int image_id)
+{
+}
+#endif
+
 struct s32_i2c_driver *s32_add_i2c_module(void *fdt, int fdt_node);
 
 static inline bool is_scp_used(void)
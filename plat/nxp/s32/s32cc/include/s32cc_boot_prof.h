@@ -0,0 +1,104 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef S32CC_BOOT_PROF_H
+#define S32CC_BOOT_PROF_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+#include <platform_def.h>
+
+/*
+ * Boot profiling record, shared with the OS through a reserved-memory node
+ * and the S32_SIP_BOOT_PROF SMC. Timestamps are Arm generic counter ticks
+ * counted from the last reset, at the rate stored in the header.
+ *
+ * The marker IDs below are part of this ABI, do not renumber them.
+ */
+#define S32_BOOT_PROF_MAGIC		(0x46525042U)	/* "BPRF" */
+#define S32_BOOT_PROF_VERSION		(1U)
+
+/* The record describes a resume from standby instead of a cold boot */
+#define S32_BOOT_PROF_F_RESUME		BIT_32(0)
+/* Some markers were dropped, the record was full */
+#define S32_BOOT_PROF_F_OVERFLOW	BIT_32(1)
+
+/* Marker argument when none applies */
+#define S32_BOOT_ARG_NONE		(0xFFFFFFFFU)
+
+enum s32_boot_mark_id {
+	S32_BOOT_BL2_ENTRY = 0,
+	S32_BOOT_RESET_CAUSE = 1,	/* arg: enum reset_cause */
+	S32_BOOT_HSE_WAIT_START = 2,
+	S32_BOOT_HSE_WAIT_END = 3,
+	S32_BOOT_MMU_ENABLE = 4,
+	S32_BOOT_PMIC_START = 5,
+	S32_BOOT_PMIC_END = 6,
+	S32_BOOT_SRAM_CLEAR_START = 7,
+	S32_BOOT_SRAM_CLEAR_END = 8,
+	S32_BOOT_DDR_START = 9,
+	S32_BOOT_DDR_END = 10,
+	S32_BOOT_MMU_DDR = 11,
+	S32_BOOT_IMAGE_LOAD_START = 12,	/* arg: image ID */
+	S32_BOOT_IMAGE_LOAD_END = 13,	/* arg: image ID */
+	S32_BOOT_AUTH_WAIT_END = 14,	/* arg: image ID or S32_BOOT_ARG_NONE */
+	S32_BOOT_BL2_EXIT = 15,
+	S32_BOOT_BL31_ENTRY = 16,
+	S32_BOOT_BL31_EXIT = 17,
+	S32_BOOT_RESUME_DONE = 18,
+	S32_BOOT_WAKE_EVENT = 19,	/* arg: us since the RTC wake-up event */
+	S32_BOOT_RESUME_SCRIPT = 20,	/* arg: replayed register ops */
+	S32_BOOT_RESUME_DEFERRED = 21,	/* arg: replayed register ops */
+	S32_BOOT_CLK_START = 22,
+	S32_BOOT_CLK_END = 23,
+};
+
+#if (S32_BOOT_PROF == 1)
+#if !defined(S32_BOOT_PROF_BASE)
+#error "S32_BOOT_PROF needs a retained memory area (S32_BOOT_PROF_BASE)"
+#endif
+
+struct s32_boot_mark {
+	uint32_t id;
+	uint32_t arg;
+	uint64_t ts;
+};
+
+struct s32_boot_prof_hdr {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t flags;
+	uint32_t count;
+	uint32_t max_count;
+	uint64_t freq;
+	uint64_t reserved;
+};
+
+#define S32_BOOT_PROF_MAX_MARKS	\
+	((S32_BOOT_PROF_SIZE - sizeof(struct s32_boot_prof_hdr)) / \
+	 sizeof(struct s32_boot_mark))
+
+struct s32_boot_prof {
+	struct s32_boot_prof_hdr hdr;
+	struct s32_boot_mark marks[S32_BOOT_PROF_MAX_MARKS];
+};
+
+void s32_boot_prof_mark(enum s32_boot_mark_id id, uint32_t arg);
+/* Publish the markers collected by BL2 at S32_BOOT_PROF_BASE */
+void s32_boot_prof_commit(bool resume);
+#else
+static inline void s32_boot_prof_mark(enum s32_boot_mark_id id, uint32_t arg)
+{
+}
+
+static inline void s32_boot_prof_commit(bool resume)
+{
+}
+#endif
+
+#endif /* S32CC_BOOT_PROF_H */
@@ -0,0 +1,20 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef S32CC_CLK_SCRIPT_H
+#define S32CC_CLK_SCRIPT_H
+
+#include <s32cc_reg_script.h>
+
+/*
+ * Clock programming of s32_periph_clock_init(), generated at build time by
+ * tools/nxp/clk_script_gen/clk_script_gen.py for the FIP location and the
+ * clock frequencies of the board.
+ */
+extern const struct s32_reg_op s32_boot_clk_script[];
+extern const uint32_t s32_boot_clk_script_len;
+
+#endif /* S32CC_CLK_SCRIPT_H */
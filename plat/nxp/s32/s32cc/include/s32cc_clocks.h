@@ -95,6 +95,8 @@ enum s32_dfs_type {
 #define DFS_PORTRESET(dfs)	((S32_DFS_ADDR(dfs)) + DFS_PORTRESET_OFF)
 #define DFS_PORTSR_OFF		0xCul
 #define DFS_PORTSR(dfs)		((S32_DFS_ADDR(dfs)) + DFS_PORTSR_OFF)
+#define DFS_PORTOLSR_OFF	0x10ul
+#define DFS_PORTOLSR(dfs)	((S32_DFS_ADDR(dfs)) + DFS_PORTOLSR_OFF)
 #define DFS_CTL_OFF			0x18ul
 #define DFS_CTL(dfs)		((S32_DFS_ADDR(dfs)) + DFS_CTL_OFF)
 #define DFS_DVPORT0_OFF		0x1Cul
@@ -161,6 +163,7 @@ int s32_a53_clock_setup(void);
 int s32_periph_clock_init(void);
 int s32_enable_ddr_clock(void);
 int s32_reset_ddr_periph(void);
+int s32_assert_ddr_reset(void);
 
 #endif /* S32CC__S32_CLOCKS_H_ */
 
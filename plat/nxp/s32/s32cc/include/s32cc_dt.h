@@ -24,6 +24,13 @@ struct dt_node_info {
 int dt_open_and_check(void);
 int fdt_get_address(void **fdt_addr);
 uint8_t fdt_get_status(int node);
+/*
+ * Same as their libfdt counterparts, served from an index built by
+ * dt_open_and_check() when called on the BL2 DT.
+ */
+int dt_node_offset_by_compatible(const void *fdt, int startoffset,
+				 const char *compatible);
+int dt_node_offset_by_phandle(const void *fdt, uint32_t phandle);
 void dt_fill_device_info(struct dt_node_info *info, int node);
 int dt_enable_clocks(void *fdt, int node);
 int fdt_read_irq_cells(const fdt32_t *prop, int nr_cells);
@@ -19,4 +19,11 @@ int request_intr_type_el3(uint32_t id, interrupt_type_handler_t handler);
 
 void s32cc_el3_interrupt_config(void);
 
+/*
+ * Handler statistics of an EL3 interrupt, summed over all the cores. The
+ * handler durations are in generic counter ticks.
+ */
+int s32cc_el3_irq_get_stats(uint32_t id, uint64_t *count, uint64_t *max,
+			    uint64_t *avg);
+
 #endif
@@ -86,6 +86,9 @@
 #define S32_SRAM_BASE		0x34000000
 #define S32_SRAM_END		(S32_SRAM_BASE + S32_SRAM_SIZE)
 
+/* Start of the first 2GB bank of physical memory. */
+#define S32_DDR0_BASE		0x80000000
+
 /* Top of the first 2GB bank of physical memory. */
 #ifndef S32_PLATFORM_DDR0_END
 #define S32_DDR0_END		0xffffffff
@@ -135,12 +138,20 @@
 #define S32_MMC_BUFFER_SIZE	0x100000
 #define S32_MMC_BUFFER_BASE (S32_BL32_BASE - S32_MMC_BUFFER_SIZE)
 
+/*
+ * Compressed images are loaded here by BL2, then decompressed to their
+ * load address.
+ */
+#define S32_DECOMP_BUF_SIZE	(8 * SIZE_1M)
+#define S32_DECOMP_BUF_BASE	(S32_MMC_BUFFER_BASE - S32_DECOMP_BUF_SIZE)
+
 /* FIXME value randomly chosen; should probably be revisited */
 #define PLATFORM_STACK_SIZE		0x4000
 
 #define MAX_IO_HANDLES			4
 #define MAX_IO_DEVICES			3
 #define MAX_IO_BLOCK_DEVICES	1U
+#define MAX_FIP_FILES			2
 
 #ifndef PLAT_LOG_LEVEL_ASSERT
 #define PLAT_LOG_LEVEL_ASSERT		LOG_LEVEL_VERBOSE
@@ -168,6 +179,31 @@
 #endif /* S32_PLATFORM_OSPM_SCMI_MEM */
 #define S32_OSPM_SCMI_MEM_SIZE	(0x80U)
 
+/* The OSPM channels have consecutive shared memory windows */
+#define S32_OSPM_SCMI_CH_MEM(X)	((uintptr_t)S32_OSPM_SCMI_MEM + \
+				 (X) * S32_OSPM_SCMI_MEM_SIZE)
+#define S32_OSPM_SCMI_MEM_TOTAL_SIZE	(S32_OSPM_SCMI_MEM_SIZE * \
+					 S32_OSPM_SCMI_CHANNELS)
+
+/* SCMI performance FastChannels, right after the OSPM channels */
+#define S32_OSPM_SCMI_FC_MEM	S32_OSPM_SCMI_CH_MEM(S32_OSPM_SCMI_CHANNELS)
+#if (S32_SCMI_PERF_FC == 1)
+#define S32_OSPM_SCMI_FC_SIZE	(0x80U)
+#else
+#define S32_OSPM_SCMI_FC_SIZE	(0x0U)
+#endif
+
+/* SCMI latency trace exported to the OS, after the FastChannels */
+#define S32_SCMI_TRACE_MEM	(S32_OSPM_SCMI_FC_MEM + S32_OSPM_SCMI_FC_SIZE)
+#if (SCMI_TRACE == 1)
+#define S32_SCMI_TRACE_SIZE	(0x8000U)
+#else
+#define S32_SCMI_TRACE_SIZE	(0x0U)
+#endif
+#define S32_OSPM_SCMI_REGION_SIZE	(S32_OSPM_SCMI_MEM_TOTAL_SIZE + \
+					 S32_OSPM_SCMI_FC_SIZE + \
+					 S32_SCMI_TRACE_SIZE)
+
 #define S32_QSPI_BASE		(0x40134000ul)
 #define S32_QSPI_SIZE		(0x1000)
 
@@ -178,8 +214,14 @@
 
 #define MSCM_BASE_ADDR		(0x40198000U)
 #define MSCM_SIZE		(0xfa0u)
-
-#if (SCMI_LOGGER == 1)
+/* Interrupt Router CPU Interrupt Status/Generation registers */
+#define MSCM_IRCP_ISR(CPN, IRQ)	(MSCM_BASE_ADDR + MSCM_IRPC_OFFSET + \
+				 (CPN) * MSCM_CPN_SIZE + (IRQ) * 0x8U)
+#define MSCM_IRCP_IGR(CPN, IRQ)	(MSCM_IRCP_ISR(CPN, IRQ) + 0x4U)
+/* CPU to CPU interrupts #0..#2 are wired to GIC SPI 1..3 */
+#define MSCM_C2C_IRQ_INTID(IRQ)	(33U + (IRQ))
+
+#if (SCMI_LOGGER == 1) || (SCMI_TRACE == 1)
 #define STM6_BASE_ADDR          (0x40224000UL)
 #define STM6_SIZE               (0X3000)
 #endif
@@ -265,7 +307,7 @@
  */
 #define S32_SCP_SCMI_META_MEM		((uintptr_t)S32_SCP_SCMI_MEM + S32_SCP_SCMI_MEM_SIZE + \
 						S32_SCP_CH_MEM_SIZE)
-#if (SCMI_LOGGER == 1)
+#if (SCMI_LOGGER == 1) || (SCMI_TRACE == 1)
 #define S32_SCP_CH_META_SIZE		(128)
 #else
 #define S32_SCP_CH_META_SIZE		(0)
@@ -273,8 +315,8 @@
 
 #define S32_SCP_SCMI_META_ADDR(X)	(((uintptr_t)S32_SCP_SCMI_META_MEM + \
 						S32_SCP_CH_META_SIZE * (X)))
-/* Used by SCMI Logger, update these in case of metadata customization
- * in device tree.
+/* Used by SCMI Logger and trace, update these in case of metadata
+ * customization in device tree.
  */
 #define S32_SCP_PSCI_META			(S32_SCP_SCMI_META_ADDR(0))
 #define S32_SCP_OSPM_META			(S32_SCP_SCMI_META_ADDR(1))
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef S32CC_REG_SCRIPT_H
+#define S32CC_REG_SCRIPT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+
+/*
+ * Flat register programming sequence, replayed without any knowledge of the
+ * modules it configures. All the S32 peripherals are below 4 GiB and their
+ * registers are 32-bit aligned, so the two low bits of 'addr' hold the
+ * operation:
+ *  - S32_REG_OP_WRITE: replace the bits in 'mask' with 'value', a full mask
+ *    writes the register without reading it first;
+ *  - S32_REG_OP_POLL: wait until (register & mask) == value;
+ *  - S32_REG_OP_DELAY: wait for 'value' microseconds, 'addr' is ignored.
+ */
+#define S32_REG_OP_WRITE	(0U)
+#define S32_REG_OP_POLL		(1U)
+#define S32_REG_OP_DELAY	(2U)
+#define S32_REG_OP_MASK		(3U)
+
+/* Upper bound of a single poll operation */
+#define S32_REG_SCRIPT_TIMEOUT_US	(100000U)
+
+struct s32_reg_op {
+	uint32_t addr;
+	uint32_t mask;
+	uint32_t value;
+};
+
+/* Static initializers, for the scripts built ahead of time */
+#define S32_REG_OP(op, reg, msk, val)	\
+	{ .addr = (uint32_t)(reg) | (op), .mask = (msk), .value = (val) }
+#define S32_REG_WRITE(reg, val)	\
+	S32_REG_OP(S32_REG_OP_WRITE, reg, UINT32_MAX, val)
+#define S32_REG_CLRSET(reg, clr, set)	\
+	S32_REG_OP(S32_REG_OP_WRITE, reg, (clr) | (set), set)
+#define S32_REG_POLL(reg, msk, val)	\
+	S32_REG_OP(S32_REG_OP_POLL, reg, msk, (val) & (msk))
+
+struct s32_reg_script {
+	struct s32_reg_op *ops;
+	uint32_t len;
+	uint32_t max_len;
+	/* Some operations didn't fit, the script must not be replayed */
+	bool overflow;
+};
+
+void s32_reg_script_init(struct s32_reg_script *script,
+			 struct s32_reg_op *ops, uint32_t max_len);
+void s32_reg_script_write(struct s32_reg_script *script, uintptr_t addr,
+			  uint32_t value);
+void s32_reg_script_clrset(struct s32_reg_script *script, uintptr_t addr,
+			   uint32_t clr, uint32_t set);
+void s32_reg_script_poll(struct s32_reg_script *script, uintptr_t addr,
+			 uint32_t mask, uint32_t value);
+void s32_reg_script_delay(struct s32_reg_script *script, uint32_t usec);
+
+int s32_reg_script_run(const struct s32_reg_op *ops, uint32_t len);
+
+#endif /* S32CC_REG_SCRIPT_H */
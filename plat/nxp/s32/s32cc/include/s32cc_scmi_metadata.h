@@ -40,4 +40,12 @@ struct s32_scmi_metadata {
 	uint32_t timestamps[TS_COUNT];
 };
 
+struct s32_stm;
+
+/*
+ * Start the STM used as timebase for the metadata timestamps, clearing the
+ * metadata regions if the SCP has not started it already.
+ */
+int s32_scmi_md_init(struct s32_stm *stm);
+
 #endif /* S32CC_SCMI_METADATA_H */
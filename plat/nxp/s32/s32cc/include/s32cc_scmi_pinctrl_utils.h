@@ -7,12 +7,16 @@
 #define S32CC__S32_SCMI_PINCTRL_H_
 
 #include <lib/utils_def.h>
+#include "s32cc_pinctrl.h"
 
 int s32_scmi_pinctrl_set_mux(const uint16_t *pins, const uint16_t *funcs,
 			     const unsigned int no);
 int s32_scmi_pinctrl_set_pcf(const uint16_t *pins, const unsigned int no_pins,
 			     const uint32_t *configs,
 			     const unsigned int no_configs);
+/* Applies the mux and pad settings of several pins in a few SCMI exchanges */
+int s32_scmi_pinctrl_set_periph(const struct s32_pin_config *cfgs,
+				size_t no);
 
 #endif /* S32CC__S32_SCMI_PINCTRL_H_ */
 
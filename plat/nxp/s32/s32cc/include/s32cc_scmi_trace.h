@@ -0,0 +1,96 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef S32CC_SCMI_TRACE_H
+#define S32CC_SCMI_TRACE_H
+
+#include <stdint.h>
+
+#include <lib/utils_def.h>
+#include <platform_def.h>
+#include <s32cc_scmi_metadata.h>
+
+/*
+ * SCMI latency trace, shared with the OS through a reserved-memory node and
+ * the S32_SIP_SCMI_TRACE SMC. Each core owns a ring with its last requests
+ * to the SCP and a latency histogram per protocol and message ID. A core
+ * only ever writes its own area, so there is no locking between writers.
+ *
+ * Timestamps are raw STM counts, the timebase shared with the SCP
+ * (see s32cc_scmi_metadata.h).
+ *
+ * Reading a ring:
+ *  - read 'head', the number of records written so far;
+ *  - record i (head - S32_SCMI_TRACE_RING_LEN <= i < head) is at index
+ *    i % S32_SCMI_TRACE_RING_LEN and is valid if its 'seq' reads i + 1
+ *    both before and after copying it, otherwise it was overwritten.
+ *
+ * Histogram counters only grow, a reader may see them out of step by one
+ * sample. Bucket 0 counts zero tick latencies, bucket n > 0 counts latencies
+ * in [2^(n-1), 2^n) ticks, the last bucket also counts all longer ones.
+ */
+#define S32_SCMI_TRACE_MAGIC		(0x43525453U)	/* "STRC" */
+#define S32_SCMI_TRACE_VERSION		(1U)
+
+#define S32_SCMI_TRACE_RING_LEN		(32U)
+#define S32_SCMI_TRACE_HIST_NUM		(16U)
+#define S32_SCMI_TRACE_BUCKETS		(24U)
+
+/* The SCP did not fill in its own timestamps */
+#define S32_SCMI_TRACE_F_NO_PLAT_TS	BIT_32(0)
+
+struct s32_scmi_trace_rec {
+	uint32_t seq;
+	uint8_t protocol_id;
+	uint8_t message_id;
+	uint16_t flags;
+	int32_t status;
+	uint32_t ts[TS_COUNT];
+	uint32_t reserved;
+};
+
+struct s32_scmi_trace_hist {
+	uint8_t protocol_id;
+	uint8_t message_id;
+	uint16_t used;
+	uint32_t count;
+	/* Samples with the SCP timestamps, accounted in plat_sum */
+	uint32_t plat_count;
+	uint32_t min;
+	uint32_t max;
+	uint32_t reserved;
+	/* TS_AGENT_RSP_RX - TS_AGENT_REQ_TX */
+	uint64_t sum;
+	/* TS_PLAT_RSP_TX - TS_PLAT_REQ_RX */
+	uint64_t plat_sum;
+	uint32_t buckets[S32_SCMI_TRACE_BUCKETS];
+};
+
+struct s32_scmi_trace_cpu {
+	uint32_t head;
+	/* Samples dropped because all the histograms were in use */
+	uint32_t hist_dropped;
+	uint64_t reserved;
+	struct s32_scmi_trace_rec ring[S32_SCMI_TRACE_RING_LEN];
+	struct s32_scmi_trace_hist hist[S32_SCMI_TRACE_HIST_NUM];
+};
+
+struct s32_scmi_trace_hdr {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t n_cpus;
+	uint32_t ring_len;
+	uint32_t hist_num;
+	uint32_t buckets;
+	uint32_t reserved[3];
+};
+
+struct s32_scmi_trace {
+	struct s32_scmi_trace_hdr hdr;
+	struct s32_scmi_trace_cpu cpu[PLATFORM_CORE_COUNT];
+};
+
+#endif /* S32CC_SCMI_TRACE_H */
@@ -6,6 +6,8 @@
 #ifndef S32CC_SCP_SCMI_H
 #define S32CC_SCP_SCMI_H
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #define SCMI_PROTOCOL_ID_PINCTRL	(0x80u)
@@ -13,6 +15,7 @@
 #define SCMI_PROTOCOL_ID_NVMEM		(0x82u)
 
 #define S32_SCP_BUF_SIZE			(128)
+#define S32_SCP_SEQ_MAX_MSGS		(12)
 
 typedef enum scmi_ch_type {
 	PSCI = 0,
@@ -20,6 +23,19 @@ typedef enum scmi_ch_type {
 } scmi_ch_type_t;
 
 typedef int (*scmi_msg_callback_t)(void *payload);
+/* Called once the response of a posted request is in the agent's memory */
+typedef void (*scp_scmi_done_t)(uintptr_t scmi_mem);
+
+/*
+ * Sequence of independent SCMI requests, sent to the SCP one after the other
+ * over the caller's TX mailbox, which is held until the last one completes.
+ * Each request still waits for its response before the next one is posted.
+ */
+struct scp_scmi_seq {
+	uint64_t msgs[S32_SCP_SEQ_MAX_MSGS][S32_SCP_BUF_SIZE / sizeof(uint64_t)];
+	unsigned int n_msgs;
+	scmi_ch_type_t type;
+};
 
 int scp_scmi_dt_init(bool init_rx);
 void scp_scmi_init(bool request_irq);
@@ -27,6 +43,18 @@ int scp_get_rx_plat_irq(void);
 void scp_get_tx_md_info(uint32_t core, uintptr_t *base, size_t *size);
 void scp_get_rx_md_info(uintptr_t *base, size_t *size);
 int send_scmi_to_scp(uintptr_t scmi_mem, size_t scmi_mem_size, scmi_ch_type_t type);
+/*
+ * Forward an OSPM request without waiting for the SCP to answer. On success,
+ * done() is called, possibly from the SCP interrupt handler on another core.
+ */
+int post_scmi_to_scp(uintptr_t scmi_mem, size_t scmi_mem_size,
+		     scp_scmi_done_t done);
+void scp_scmi_seq_init(struct scp_scmi_seq *seq, scmi_ch_type_t type);
+/* Returns the payload of the new request or NULL if it cannot be added */
+void *scp_scmi_seq_add(struct scp_scmi_seq *seq, uint32_t proto,
+		       uint32_t msg_id, size_t payload_size);
+/* Returns the first transport error or failed SCMI status */
+int scp_scmi_seq_send(struct scp_scmi_seq *seq);
 void scp_set_core_reset_addr(uintptr_t addr);
 int scp_get_cpu_state(uint32_t core);
 int scp_cpu_on(uint32_t core);
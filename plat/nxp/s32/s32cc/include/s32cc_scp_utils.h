@@ -12,6 +12,7 @@
 int scp_a53_clock_setup(void);
 int scp_periph_clock_init(void);
 int scp_reset_ddr_periph(void);
+int scp_assert_ddr_reset(void);
 int scp_disable_ddr_periph(void);
 int scp_get_clear_reset_cause(enum reset_cause *cause);
 int scp_is_lockstep_enabled(bool *lockstep_en);
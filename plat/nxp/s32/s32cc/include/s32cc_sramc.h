@@ -23,6 +23,7 @@ struct sram_ctrl {
 	uint32_t min_sram_addr;
 	uint32_t max_sram_addr;
 	bool mmap_added;
+	bool init_pending;
 	/**
 	 * Translate an A53 SRAM address to SRAM controller offset
 	 * associated to that memory region.
@@ -32,7 +33,11 @@ struct sram_ctrl {
 };
 
 int s32_sram_clear(uintptr_t start, uintptr_t end);
+int s32_sram_clear_start(uintptr_t start, uintptr_t end);
+void s32_sram_clear_wait(void);
 void s32_ssram_clear(void);
+void s32_ssram_clear_start(void);
+void s32_ssram_clear_wait(void);
 void s32_get_sramc(struct sram_ctrl **ctrls, size_t *size);
 
 #endif
@@ -17,4 +17,12 @@ struct plat_io_policy {
 
 void s32_io_setup(void);
 
+/*
+ * Raw accesses to the boot device, outside of the FIP. Both the offset and the
+ * size must be multiples of the device block size. These can be used before
+ * s32_io_setup(), e.g. while the DDR is not yet available.
+ */
+int s32_storage_raw_read(size_t offset, uintptr_t buf, size_t size);
+int s32_storage_raw_write(size_t offset, uintptr_t buf, size_t size);
+
 #endif /* S32CC_STORAGE_H */
@@ -17,4 +17,16 @@ static inline bool is_plat_agent(unsigned int agent_id)
 	return agent_id == S32_SCMI_AGENT_PLAT;
 }
 
+/* Serialize the accesses to the SCMI server state */
+void s32_scmi_lock(void);
+void s32_scmi_unlock(void);
+
+#if (S32_SCMI_PERF_FC == 1)
+/*
+ * Publish the performance FastChannels of the OSPM agent and register the
+ * handler of their doorbell
+ */
+int s32_scmi_perf_fc_init(void);
+#endif
+
 #endif /* S32CC_SVC_H */
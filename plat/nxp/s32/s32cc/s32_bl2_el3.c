@@ -7,13 +7,18 @@
 
 #include <common/bl_common.h>
 #include <common/desc_image_load.h>
+#include <common/image_decompress.h>
 #include <common/fdt_wrappers.h>
 #include <ddr/ddr_density.h>
+#include <drivers/nxp/s32/hse/hse_mem.h>
 #include "ddr_utils.h"
 #include <inttypes.h>
 #include <lib/libfdt/libfdt.h>
 #include <lib/mmio.h>
 #include <lib/optee_utils.h>
+#if (S32_FIP_LZ4 == 1)
+#include <tf_lz4.h>
+#endif
 #include <lib/xlat_tables/xlat_tables_v2.h>
 #include <platform.h>
 #include <s32cc_bl_common.h>
@@ -48,6 +53,7 @@ void plat_ic_set_interrupt_pending(unsigned int id)
 #if (ERRATA_S32_050543 == 1)
 #include <dt-bindings/ddr-errata/s32-ddr-errata.h>
 #endif
+#include "s32cc_boot_prof.h"
 #include "s32cc_dt.h"
 #include "s32cc_clocks.h"
 #include "s32cc_mc_me.h"
@@ -55,7 +61,14 @@ void plat_ic_set_interrupt_pending(unsigned int id)
 #include "s32cc_sramc.h"
 #include "s32cc_storage.h"
 
-#define S32_FDT_UPDATES_SPACE		100U
+/*
+ * Extra OSPM SCMI channels and the perf FastChannels add a reserved memory
+ * node each
+ */
+#define S32_FDT_SCMI_CH_SPACE		128U
+#define S32_FDT_UPDATES_SPACE		(100U + S32_FDT_SCMI_CH_SPACE * \
+					 (S32_OSPM_SCMI_CHANNELS - 1U + \
+					  S32_SCMI_PERF_FC))
 
 #define PER_GROUP3_BASE		(0x40300000UL)
 #define FCCU_BASE_ADDR		(PER_GROUP3_BASE + 0x0000C000)
@@ -209,7 +222,7 @@ static const mmap_region_t s32_mmap[] = {
  */
 static const mmap_region_t dyn_ddr_regions[] = {
 	MAP_REGION_FLAT(S32_OSPM_SCMI_MEM,
-			MMU_ROUND_UP_TO_PAGE(S32_OSPM_SCMI_MEM_SIZE),
+			MMU_ROUND_UP_TO_PAGE(S32_OSPM_SCMI_REGION_SIZE),
 			MT_NON_CACHEABLE | MT_RW | MT_SECURE),
 	MAP_REGION2(BL33_DTB, BL33_DTB,
 		    MMU_ROUND_UP_TO_PAGE(BL33_MAX_DTB_SIZE),
@@ -718,6 +731,214 @@ static int ft_fixup_nvmem(void *blob)
 	return enable_scmi_nvmem_node(blob, 0);
 }
 
+#if (S32_OSPM_SCMI_CHANNELS > 1) || (S32_SCMI_PERF_FC == 1) || \
+	(S32_BOOT_PROF == 1) || (SCMI_TRACE == 1)
+static const char *resmem_node_path = "/reserved-memory";
+
+static int add_resmem_node(void *blob, const char *name, uintptr_t base,
+			   size_t size)
+{
+	int parent, nodeoff, ret;
+	char node_name[32];
+
+	parent = fdt_path_offset(blob, resmem_node_path);
+	if (parent < 0)
+		return parent;
+
+	ret = snprintf(node_name, sizeof(node_name), "%s@%lx", name,
+		       (unsigned long)base);
+	if (ret < 0 || ret >= sizeof(node_name))
+		return -EINVAL;
+
+	nodeoff = fdt_add_subnode(blob, parent, node_name);
+	if (nodeoff < 0)
+		return nodeoff;
+
+	ret = fdt_appendprop_addrrange(blob, parent, nodeoff, "reg", base,
+				       size);
+	if (ret)
+		return ret;
+
+	ret = fdt_setprop_empty(blob, nodeoff, "no-map");
+	if (ret)
+		return ret;
+
+	return nodeoff;
+}
+#endif
+
+#if (S32_SCMI_PERF_FC == 1)
+/* The agent maps the FastChannels, keep them out of the kernel's memory */
+static int ft_fixup_scmi_perf_fc(void *blob)
+{
+	int ret;
+
+	ret = add_resmem_node(blob, "scmi-fc", S32_OSPM_SCMI_FC_MEM,
+			      S32_OSPM_SCMI_FC_SIZE);
+	if (ret < 0) {
+		ERROR("Failed to reserve the SCMI perf FastChannels (%s)\n",
+		      fdt_strerror(ret));
+		return ret;
+	}
+
+	return 0;
+}
+#endif
+
+#if (S32_BOOT_PROF == 1)
+static int ft_fixup_boot_prof(void *blob)
+{
+	int nodeoff, ret;
+
+	nodeoff = add_resmem_node(blob, "boot-prof", S32_BOOT_PROF_BASE,
+				  S32_BOOT_PROF_SIZE);
+	if (nodeoff < 0) {
+		ERROR("Failed to reserve the boot profiling record (%s)\n",
+		      fdt_strerror(nodeoff));
+		return nodeoff;
+	}
+
+	ret = fdt_setprop_string(blob, nodeoff, "compatible",
+				 "nxp,s32cc-boot-profile");
+	if (ret) {
+		ERROR("Failed to set the boot profiling compatible (%s)\n",
+		      fdt_strerror(ret));
+		return ret;
+	}
+
+	return 0;
+}
+#endif
+
+#if (SCMI_TRACE == 1)
+static int ft_fixup_scmi_trace(void *blob)
+{
+	int nodeoff, ret;
+
+	nodeoff = add_resmem_node(blob, "scmi-trace", S32_SCMI_TRACE_MEM,
+				  S32_SCMI_TRACE_SIZE);
+	if (nodeoff < 0) {
+		ERROR("Failed to reserve the SCMI trace (%s)\n",
+		      fdt_strerror(nodeoff));
+		return nodeoff;
+	}
+
+	ret = fdt_setprop_string(blob, nodeoff, "compatible",
+				 "nxp,s32cc-scmi-trace");
+	if (ret) {
+		ERROR("Failed to set the SCMI trace compatible (%s)\n",
+		      fdt_strerror(ret));
+		return ret;
+	}
+
+	return 0;
+}
+#endif
+
+#if (S32_OSPM_SCMI_CHANNELS > 1)
+static const char *scmi_node_path = "/firmware/scmi";
+
+static bool is_scmi_ch_candidate(const void *blob, int nodeoff)
+{
+	const char *status = fdt_getprop(blob, nodeoff, "status", NULL);
+
+	if (status && strcmp(status, "okay"))
+		return false;
+
+	return !fdt_getprop(blob, nodeoff, "shmem", NULL);
+}
+
+static int add_scmi_shmem_node(void *blob, unsigned int ch, uint32_t *phandle)
+{
+	int nodeoff, ret;
+
+	nodeoff = add_resmem_node(blob, "shm", S32_OSPM_SCMI_CH_MEM(ch),
+				  S32_OSPM_SCMI_MEM_SIZE);
+	if (nodeoff < 0)
+		return nodeoff;
+
+	ret = fdt_setprop_string(blob, nodeoff, "compatible", "arm,scmi-shmem");
+	if (ret)
+		return ret;
+
+	ret = fdt_generate_phandle(blob, phandle);
+	if (ret)
+		return ret;
+
+	return fdt_setprop_u32(blob, nodeoff, "phandle", *phandle);
+}
+
+/*
+ * Give each SCMI protocol without a dedicated channel its own shared memory
+ * window, as long as there are OSPM channels left. The remaining protocols
+ * keep using the agent's default channel.
+ */
+static int ft_fixup_scmi_channels(void *blob)
+{
+	static const char compat[] = "arm,scmi-smc-param\0arm,scmi-smc";
+	uint32_t phandles[S32_OSPM_SCMI_CHANNELS];
+	unsigned int ch, n_ch = 0U;
+	int scmi, nodeoff, ret;
+
+	scmi = fdt_path_offset(blob, scmi_node_path);
+	if (scmi < 0) {
+		ERROR("Failed to get offset of '%s' node (%s)\n",
+		      scmi_node_path, fdt_strerror(scmi));
+		return scmi;
+	}
+
+	fdt_for_each_subnode(nodeoff, blob, scmi) {
+		if (is_scmi_ch_candidate(blob, nodeoff))
+			n_ch++;
+	}
+
+	n_ch = MIN(n_ch, S32_OSPM_SCMI_CHANNELS - 1U);
+
+	for (ch = 0U; ch < n_ch; ch++) {
+		ret = add_scmi_shmem_node(blob, ch + 1U, &phandles[ch]);
+		if (ret) {
+			ERROR("Failed to add OSPM SCMI channel %u (%s)\n",
+			      ch + 1U, fdt_strerror(ret));
+			return ret;
+		}
+	}
+
+	/* The new nodes moved the SCMI node */
+	scmi = fdt_path_offset(blob, scmi_node_path);
+	if (scmi < 0)
+		return scmi;
+
+	ch = 0U;
+	fdt_for_each_subnode(nodeoff, blob, scmi) {
+		if (ch == n_ch)
+			break;
+
+		if (!is_scmi_ch_candidate(blob, nodeoff))
+			continue;
+
+		ret = fdt_setprop_u32(blob, nodeoff, "shmem", phandles[ch]);
+		if (ret) {
+			ERROR("Failed to set shmem property of '%s' node (%s)\n",
+			      fdt_get_name(blob, nodeoff, NULL),
+			      fdt_strerror(ret));
+			return ret;
+		}
+
+		ch++;
+	}
+
+	/* Callers identify their channel through the SMC parameters */
+	ret = fdt_setprop(blob, scmi, "compatible", compat, sizeof(compat));
+	if (ret) {
+		ERROR("Failed to update the SCMI transport (%s)\n",
+		      fdt_strerror(ret));
+		return ret;
+	}
+
+	return 0;
+}
+#endif
+
 static int ft_fixup_serial(void *dtb)
 {
 	int offs, ret;
@@ -787,6 +1008,34 @@ int apply_bl2_fixups(void *blob)
 			goto out;
 	}
 
+#if (S32_OSPM_SCMI_CHANNELS > 1)
+	ret = ft_fixup_scmi_channels(blob);
+	if (ret)
+		goto out;
+#endif
+
+#if (S32_SCMI_PERF_FC == 1)
+	if (!is_scp_used()) {
+		ret = ft_fixup_scmi_perf_fc(blob);
+		if (ret)
+			goto out;
+	}
+#endif
+
+#if (S32_BOOT_PROF == 1)
+	ret = ft_fixup_boot_prof(blob);
+	if (ret)
+		goto out;
+#endif
+
+#if (SCMI_TRACE == 1)
+	if (is_scp_used()) {
+		ret = ft_fixup_scmi_trace(blob);
+		if (ret)
+			goto out;
+	}
+#endif
+
 out:
 	flush_dcache_range((uintptr_t)blob, size);
 	return ret;
@@ -805,9 +1054,37 @@ static struct image_info *s32_get_image_info(unsigned int image_id)
 	return &desc->image_info;
 }
 
+#if (S32_FIP_LZ4 == 1)
+static bool is_compressed_image(unsigned int image_id)
+{
+	switch (image_id) {
+	case BL32_IMAGE_ID:
+	case BL32_EXTRA1_IMAGE_ID:
+	case BL33_IMAGE_ID:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void bl2_plat_preload_setup(void)
+{
+	int ret;
+
+	ret = mmap_add_dynamic_region(S32_DECOMP_BUF_BASE, S32_DECOMP_BUF_BASE,
+				      S32_DECOMP_BUF_SIZE,
+				      MT_MEMORY | MT_RW | MT_SECURE);
+	if (ret)
+		plat_error_handler(ret);
+
+	image_decompress_init(S32_DECOMP_BUF_BASE, S32_DECOMP_BUF_SIZE, unlz4);
+}
+#endif
+
 int bl2_plat_handle_pre_image_load(unsigned int image_id)
 {
 	struct image_info *image_info;
+	int ret;
 
 	image_info = s32_get_image_info(image_id);
 
@@ -815,19 +1092,30 @@ int bl2_plat_handle_pre_image_load(unsigned int image_id)
 		return -EINVAL;
 	}
 
+	s32_boot_prof_mark(S32_BOOT_IMAGE_LOAD_START, image_id);
+	s32_crypto_set_image_id(image_id);
+
 	/*
 	 * BL32_IMAGE and BL32_EXTRA1_IMAGE use the same address
 	 * space. We skip the mapping for BL32_EXTRA1_IMAGE because
 	 * it has already been done during BL32_IMAGE loading.
 	 */
-	if (image_id == BL32_EXTRA1_IMAGE_ID) {
-		return 0;
+	if (image_id != BL32_EXTRA1_IMAGE_ID) {
+		ret = mmap_add_dynamic_region(image_info->image_base,
+				image_info->image_base,
+				MMU_ROUND_UP_TO_PAGE(image_info->image_max_size),
+				MT_MEMORY | MT_RW | MT_SECURE);
+		if (ret)
+			return ret;
 	}
 
-	return mmap_add_dynamic_region(image_info->image_base,
-			image_info->image_base,
-			MMU_ROUND_UP_TO_PAGE(image_info->image_max_size),
-			MT_MEMORY | MT_RW | MT_SECURE);
+#if (S32_FIP_LZ4 == 1)
+	/* Load the compressed payload into the scratch buffer */
+	if (is_compressed_image(image_id))
+		image_decompress_prepare(image_info);
+#endif
+
+	return 0;
 }
 
 int bl2_plat_handle_post_image_load(unsigned int image_id)
@@ -837,11 +1125,35 @@ int bl2_plat_handle_post_image_load(unsigned int image_id)
 	bl_mem_params_node_t *bl_mem_params = NULL;
 	bl_mem_params_node_t *pager_mem_params = NULL;
 
+	s32_boot_prof_mark(S32_BOOT_IMAGE_LOAD_END, image_id);
+
+#if (S32_FIP_LZ4 == 1)
+	if (is_compressed_image(image_id)) {
+		/* Only authenticated data is handed to the decompressor */
+		ret = s32_crypto_wait_deferred();
+		if (ret)
+			return ret;
+
+		s32_boot_prof_mark(S32_BOOT_AUTH_WAIT_END, image_id);
+
+		ret = image_decompress(s32_get_image_info(image_id));
+		if (ret)
+			return ret;
+	}
+#endif
+
 	if (image_id == BL33_IMAGE_ID) {
 		return bl2_copy_bl31_dtb();
 	}
 
 	if (image_id == BL32_IMAGE_ID) {
+		/* The OP-TEE header must be authenticated before parsing it */
+		ret = s32_crypto_wait_deferred();
+		if (ret)
+			return ret;
+
+		s32_boot_prof_mark(S32_BOOT_AUTH_WAIT_END, image_id);
+
 		bl_mem_params = get_bl_mem_params_node(image_id);
 		assert(bl_mem_params && "bl_mem_params cannot be NULL");
 
@@ -860,6 +1172,44 @@ int bl2_plat_handle_post_image_load(unsigned int image_id)
 	return 0;
 }
 
+#if TRUSTED_BOARD_BOOT && (S32_HSE_MEM_BENCH == 1)
+static void report_hse_mem_usage(void)
+{
+	struct hse_mem_stats stats;
+
+	hse_mem_get_stats(&stats);
+
+	NOTICE("HSE: pool peak usage %zu of %zu bytes, up to %u free blocks, %u failed allocations\n",
+	       stats.peak_used_size, stats.total_size,
+	       stats.peak_free_blocks, stats.failed_allocs);
+}
+#else
+static inline void report_hse_mem_usage(void)
+{
+}
+#endif
+
+int bl2_plat_handle_pending_image_auth(void)
+{
+	int ret;
+
+	ret = s32_crypto_wait_deferred();
+	s32_boot_prof_mark(S32_BOOT_AUTH_WAIT_END, S32_BOOT_ARG_NONE);
+
+	/* All the images are loaded, the HSE pool won't be used anymore */
+	report_hse_mem_usage();
+
+	return ret;
+}
+
+#if (S32_BOOT_PROF == 1)
+void bl2_el3_plat_prepare_exit(void)
+{
+	s32_boot_prof_mark(S32_BOOT_BL2_EXIT, S32_BOOT_ARG_NONE);
+	s32_boot_prof_commit(false);
+}
+#endif
+
 /**
  * Clear non-critical faults generated by SWT (software watchdog timer)
  * All SWT faults are placed in NCF_S1 (33-38)
@@ -14,6 +14,7 @@
 
 #include "platform_def.h"
 #include "s32cc_bl_common.h"
+#include "s32cc_boot_prof.h"
 #include "s32cc_clocks.h"
 #include "s32cc_dt.h"
 #include "s32cc_linflexuart.h"
@@ -24,12 +25,13 @@
 #include "s32cc_sramc.h"
 #include "s32cc_interrupt_mgmt.h"
 #include "s32cc_scp_scmi.h"
+#include "s32cc_svc.h"
 
 #define MMU_ROUND_UP_TO_4K(x)	\
 	(((x) & ~0xfffU) == (x) ? (x) : ((x) & ~0xfffU) + 0x1000U)
 
-/* Secondaries wake sgi + SCP IRQ + HSE IRQs */
-#define MAX_INTR_PROPS	(2 + HSE_MU_INST)
+/* Secondaries wake sgi + SCP IRQ + HSE IRQs + perf FastChannels doorbell */
+#define MAX_INTR_PROPS	(3 + HSE_MU_INST)
 
 IMPORT_SYM(uintptr_t, __RW_START__, BL31_RW_START);
 
@@ -59,7 +61,7 @@ static mmap_region_t dyn_regions[] = {
 			MMU_ROUND_UP_TO_4K(S32_BL33_IMAGE_SIZE),
 			MT_MEMORY | MT_RW, PAGE_SIZE),
 	MAP_REGION_FLAT(S32_OSPM_SCMI_MEM,
-			MMU_ROUND_UP_TO_PAGE(S32_OSPM_SCMI_MEM_SIZE),
+			MMU_ROUND_UP_TO_PAGE(S32_OSPM_SCMI_REGION_SIZE),
 			MT_NON_CACHEABLE | MT_RW | MT_SECURE),
 	/* SCP entries */
 	MAP_REGION_FLAT(MSCM_BASE_ADDR, MMU_ROUND_UP_TO_PAGE(MSCM_SIZE),
@@ -242,6 +244,8 @@ entry_point_info_t *bl31_plat_get_next_image_ep_info(uint32_t type)
 void bl31_early_platform_setup2(u_register_t arg0, u_register_t arg1,
 		u_register_t arg2, u_register_t arg3)
 {
+	s32_boot_prof_mark(S32_BOOT_BL31_ENTRY, S32_BOOT_ARG_NONE);
+
 	SET_PARAM_HEAD(&bl33_image_ep_info, PARAM_EP, VERSION_1, 0);
 	bl33_image_ep_info.pc = BL33_ENTRYPOINT;
 	bl33_image_ep_info.spsr = s32_get_spsr_for_bl33_entry();
@@ -386,6 +390,24 @@ static interrupt_prop_t *register_scp_notif_irq(interrupt_prop_t *itr,
 	return itr;
 }
 
+#if (S32_SCMI_PERF_FC == 1)
+static interrupt_prop_t *register_perf_fc_irq(interrupt_prop_t *itr,
+					      const interrupt_prop_t *end)
+{
+	interrupt_prop_t irq_prop = INTR_PROP_DESC(
+			MSCM_C2C_IRQ_INTID(S32_SCMI_PERF_FC_IRQ),
+			GIC_HIGHEST_SEC_PRIORITY,
+			INTR_GROUP0,
+			GIC_INTR_CFG_LEVEL);
+
+	itr = register_and_check_irq(itr, end, &irq_prop);
+	if (!itr)
+		ERROR("Failed to register perf FastChannels IRQ\n");
+
+	return itr;
+}
+#endif
+
 static interrupt_prop_t *register_hse_irqs(interrupt_prop_t *itr,
 					   const interrupt_prop_t *end)
 {
@@ -470,6 +492,11 @@ static void register_irqs(void)
 	if (has_hse)
 		itr = register_hse_irqs(itr, end);
 
+#if (S32_SCMI_PERF_FC == 1)
+	if (!is_scp_used())
+		itr = register_perf_fc_irq(itr, end);
+#endif
+
 	if (!itr)
 		return;
 
@@ -549,6 +576,11 @@ void bl31_plat_arch_setup(void)
 	if (is_scp_used())
 		scp_scmi_init(true);
 
+#if (S32_SCMI_PERF_FC == 1)
+	if (!is_scp_used() && s32_scmi_perf_fc_init())
+		ERROR("Failed to set up the perf FastChannels\n");
+#endif
+
 	register_irqs();
 }
 
@@ -561,6 +593,8 @@ void bl31_plat_runtime_setup(void)
 {
 	int rx_irq_num = scp_get_rx_plat_irq();
 
+	s32_boot_prof_mark(S32_BOOT_BL31_EXIT, S32_BOOT_ARG_NONE);
+
 	if (is_scp_used()) {
 		s32cc_el3_interrupt_config();
 
@@ -576,6 +610,16 @@ void bl31_plat_runtime_setup(void)
 	} else {
 		/* Mark A53 clock as enabled */
 		update_a53_clk_state(true);
+
+#if (S32_CLK_RATE_BENCH == 1)
+		s32_scmi_clk_rate_bench();
+#endif
+
+#if (S32_SCMI_PERF_FC == 1)
+		s32cc_el3_interrupt_config();
+		plat_ic_set_spi_routing(MSCM_C2C_IRQ_INTID(S32_SCMI_PERF_FC_IRQ),
+					INTR_ROUTING_MODE_ANY, read_mpidr());
+#endif
 	}
 }
 
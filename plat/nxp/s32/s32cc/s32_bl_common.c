@@ -13,6 +13,7 @@
 #include <inttypes.h>
 #include "platform_def.h"
 #include "s32cc_bl_common.h"
+#include "s32cc_boot_prof.h"
 #include "s32cc_clocks.h"
 #include <dt-bindings/clock/s32gen1-clock-freq.h>
 #if (ERRATA_S32_050543 == 1)
@@ -125,6 +126,21 @@ void ddrss_gpr_to_io_retention_mode(void)
 	}
 }
 
+uint32_t assert_ddr_reset(void)
+{
+	int ret;
+
+	if (!is_scp_used())
+		ret = s32_assert_ddr_reset();
+	else
+		ret = scp_assert_ddr_reset();
+
+	if (ret < 0)
+		ret = -ret;
+
+	return ret;
+}
+
 uint32_t deassert_ddr_reset(void)
 {
 	int ret;
@@ -174,6 +190,9 @@ void s32_early_plat_setup(void)
 	if (s32_el3_mmu_fixup(NULL, 0))
 		panic();
 
+	s32_boot_prof_mark(S32_BOOT_MMU_ENABLE, S32_BOOT_ARG_NONE);
+
+	s32_boot_prof_mark(S32_BOOT_CLK_START, S32_BOOT_ARG_NONE);
 	if (!is_scp_used())
 		ret = s32_periph_clock_init();
 	else
@@ -183,6 +202,7 @@ void s32_early_plat_setup(void)
 		ERROR("Failed to enable BL2 periph clocks\n");
 		panic();
 	}
+	s32_boot_prof_mark(S32_BOOT_CLK_END, S32_BOOT_ARG_NONE);
 }
 
 void plat_ea_handler(unsigned int ea_reason, uint64_t syndrome, void *cookie,
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <arch_helpers.h>
+#include <lib/utils.h>
+#include <plat/common/platform.h>
+#include <string.h>
+
+#include "s32cc_boot_prof.h"
+
+CASSERT(sizeof(struct s32_boot_prof) <= S32_BOOT_PROF_SIZE,
+	assert_s32_boot_prof_size);
+
+#if defined(IMAGE_BL2)
+/*
+ * The standby RAM is initialized only after a few markers were taken, so BL2
+ * collects them in its own memory and publishes them before leaving.
+ */
+static struct s32_boot_prof bl2_prof;
+
+static struct s32_boot_prof *get_prof(void)
+{
+	return &bl2_prof;
+}
+#else
+static struct s32_boot_prof *get_prof(void)
+{
+	return (struct s32_boot_prof *)S32_BOOT_PROF_BASE;
+}
+#endif
+
+static void init_prof(struct s32_boot_prof *prof)
+{
+	zeromem(prof, sizeof(*prof));
+
+	prof->hdr.magic = S32_BOOT_PROF_MAGIC;
+	prof->hdr.version = S32_BOOT_PROF_VERSION;
+	prof->hdr.max_count = S32_BOOT_PROF_MAX_MARKS;
+	prof->hdr.freq = plat_get_syscnt_freq2();
+}
+
+void s32_boot_prof_mark(enum s32_boot_mark_id id, uint32_t arg)
+{
+	uint64_t ts = read_cntpct_el0();
+	struct s32_boot_prof *prof = get_prof();
+	struct s32_boot_mark *mark;
+
+#if defined(IMAGE_BL2)
+	if (prof->hdr.magic != S32_BOOT_PROF_MAGIC)
+		init_prof(prof);
+#else
+	/* Nothing to append to if BL2 didn't publish a record */
+	if (prof->hdr.magic != S32_BOOT_PROF_MAGIC)
+		return;
+#endif
+
+	if (prof->hdr.count >= S32_BOOT_PROF_MAX_MARKS) {
+		prof->hdr.flags |= S32_BOOT_PROF_F_OVERFLOW;
+		return;
+	}
+
+	mark = &prof->marks[prof->hdr.count];
+	mark->id = id;
+	mark->arg = arg;
+	mark->ts = ts;
+	prof->hdr.count++;
+}
+
+#if defined(IMAGE_BL2)
+void s32_boot_prof_commit(bool resume)
+{
+	struct s32_boot_prof *prof = get_prof();
+
+	if (prof->hdr.magic != S32_BOOT_PROF_MAGIC)
+		init_prof(prof);
+
+	if (resume)
+		prof->hdr.flags |= S32_BOOT_PROF_F_RESUME;
+
+	memcpy((void *)S32_BOOT_PROF_BASE, prof, sizeof(*prof));
+
+	/* BL31 starts with the MMU and the caches off */
+	flush_dcache_range(S32_BOOT_PROF_BASE, sizeof(*prof));
+}
+#endif
@@ -9,7 +9,6 @@ include lib/libc/libc.mk
 include lib/libfdt/libfdt.mk
 include lib/xlat_tables_v2/xlat_tables.mk
 include make_helpers/build_macros.mk
-include plat/nxp/s32/s32cc/s32_ddr.mk
 
 ERRATA_A53_855873	:= 1
 ERRATA_A53_836870	:= 1
@@ -29,6 +28,8 @@ S32_PLAT	:= plat/nxp/s32
 S32CC_PLAT	:= plat/nxp/s32/s32cc
 S32_DRIVERS	:= drivers/nxp/s32
 
+include plat/nxp/s32/s32cc/s32_ddr.mk
+
 ifneq ($(S32_PLAT_SOC),)
 $(eval $(call add_define_val,PLAT_$(S32_PLAT_SOC)))
 endif
@@ -75,11 +76,141 @@ $(eval $(call add_define_val,S32CC_SCMI_NVMEM_FIXUP,$(S32CC_SCMI_NVMEM_FIXUP)))
 SCMI_LOGGER ?= 0
 $(eval $(call add_define_val,SCMI_LOGGER,$(SCMI_LOGGER)))
 
+# Trace the latency of the SCMI requests sent to the SCP from BL31, in per-core
+# rings and histograms exported to the OS (reserved-memory node and SiP SMC)
+SCMI_TRACE ?= 0
+$(eval $(call add_define_val,SCMI_TRACE,$(SCMI_TRACE)))
+
 # Use split SCMI channels (PSCI and OSPM) for AP to SCP communication, instead of
 # one channel per core. Can be either 0 (disabled) or 1 (enabled).
 S32CC_SCMI_SPLIT_CHAN	?= 0
 $(eval $(call add_define_val,S32CC_SCMI_SPLIT_CHAN,$(S32CC_SCMI_SPLIT_CHAN)))
 
+# Don't wait in EL3 for the SCP to answer the OSPM requests forwarded to it
+# when the agent asks for a completion interrupt ("a2p" interrupt of the
+# "arm,scmi-smc" node). The SCP signals the responses through the OSPM RX
+# doorbell. Needs the OSPM requests on their own channel.
+S32_SCMI_ASYNC		?= 0
+$(eval $(call add_define_val,S32_SCMI_ASYNC,$(S32_SCMI_ASYNC)))
+
+# First SCP firmware implementation version (SCMI BASE
+# DISCOVER_IMPLEMENTATION_VERSION) raising the OSPM RX doorbell for the
+# requests flagged for an interrupt. BL31 reads the version at boot and keeps
+# forwarding the OSPM requests synchronously to older firmware.
+S32_SCMI_ASYNC_SCP_VERSION	?=
+
+ifeq (${S32_SCMI_ASYNC},1)
+ifneq (${S32CC_SCMI_SPLIT_CHAN},1)
+$(error S32_SCMI_ASYNC needs S32CC_SCMI_SPLIT_CHAN=1)
+endif
+ifeq (${S32_SCMI_ASYNC_SCP_VERSION},)
+$(error S32_SCMI_ASYNC needs S32_SCMI_ASYNC_SCP_VERSION)
+endif
+$(eval $(call add_define_val,S32_SCMI_ASYNC_SCP_VERSION,$(S32_SCMI_ASYNC_SCP_VERSION)))
+endif
+
+# Number of OSPM SCMI channels served by BL31, each with its own shared memory
+# window. With more than one channel, BL2 assigns the extra windows to SCMI
+# protocols in the DT and switches the agent to the "arm,scmi-smc-param"
+# transport, so that the caller identifies its window in x1/x2.
+S32_OSPM_SCMI_CHANNELS	?= 1
+$(eval $(call add_define_val,S32_OSPM_SCMI_CHANNELS,$(S32_OSPM_SCMI_CHANNELS)))
+
+# Expose SCMI performance FastChannels to the OSPM agent. Level and limit
+# requests are written to shared memory cells and signaled through the MSCM
+# core-to-core interrupt S32_SCMI_PERF_FC_IRQ targeting A53_0, which must not
+# be used by any other component (e.g. IPCF). Ignored when an SCP is used.
+S32_SCMI_PERF_FC	?= 0
+$(eval $(call add_define_val,S32_SCMI_PERF_FC,$(S32_SCMI_PERF_FC)))
+S32_SCMI_PERF_FC_IRQ	?= 0
+$(eval $(call add_define_val,S32_SCMI_PERF_FC_IRQ,$(S32_SCMI_PERF_FC_IRQ)))
+
+# Measure the SCMI clock rate query latency at boot, with and without the
+# clock rate cache. Ignored when an SCP is used.
+S32_CLK_RATE_BENCH	?= 0
+$(eval $(call add_define_val,S32_CLK_RATE_BENCH,$(S32_CLK_RATE_BENCH)))
+
+# Report the read throughput of the uSDHC bus mode selected at boot
+S32_MMC_BENCH		?= 0
+$(eval $(call add_define_val,S32_MMC_BENCH,$(S32_MMC_BENCH)))
+
+# Load the FIP from QSPI through IP command reads, straight into the image
+# load addresses, instead of CPU reads over the AHB window
+S32_QSPI_IP_READ	?= 0
+$(eval $(call add_define_val,S32_QSPI_IP_READ,$(S32_QSPI_IP_READ)))
+
+# Report the FIP read throughput from QSPI
+S32_QSPI_BENCH		?= 0
+$(eval $(call add_define_val,S32_QSPI_BENCH,$(S32_QSPI_BENCH)))
+
+# Store BL32 and BL33 LZ4-compressed in the FIP and let BL2 decompress them
+# into their load addresses. Requires the lz4 host tool.
+S32_FIP_LZ4		?= 0
+$(eval $(call add_define_val,S32_FIP_LZ4,$(S32_FIP_LZ4)))
+
+ifeq (${S32_FIP_LZ4},1)
+include lib/lz4/lz4.mk
+
+BL2_SOURCES		+= common/image_decompress.c \
+			   $(LZ4_SOURCES)
+
+BL32_PRE_TOOL_FILTER		:= LZ4
+BL32_EXTRA1_PRE_TOOL_FILTER	:= LZ4
+BL33_PRE_TOOL_FILTER		:= LZ4
+endif
+
+# With TRUSTED_BOARD_BOOT, let HSE hash the images it can read in place in the
+# background while BL2 loads the next ones. The image hash check then succeeds
+# as soon as the hash is queued: BL2 waits for the results before using an
+# image's content and before handing over to any image, and fails the boot
+# if one of them doesn't match.
+S32_HSE_DEFERRED_AUTH	?= 0
+$(eval $(call add_define_val,S32_HSE_DEFERRED_AUTH,$(S32_HSE_DEFERRED_AUTH)))
+
+# Track the usage and fragmentation of the HSE reserved memory pool: time the
+# allocator on a synthetic workload when the pool is set up, and report the
+# high-water mark of the pool once BL2 has loaded all the images.
+# Needs TRUSTED_BOARD_BOOT.
+S32_HSE_MEM_BENCH	?= 0
+$(eval $(call add_define_val,S32_HSE_MEM_BENCH,$(S32_HSE_MEM_BENCH)))
+
+# Record timestamped boot markers from BL2 and BL31 and publish them to the
+# OS (reserved-memory node and SiP SMC). Needs a retained memory area,
+# currently the S32G standby RAM.
+S32_BOOT_PROF		?= 0
+$(eval $(call add_define_val,S32_BOOT_PROF,$(S32_BOOT_PROF)))
+
+ifeq (${S32_BOOT_PROF},1)
+BL2_SOURCES		+= ${S32CC_PLAT}/s32_boot_prof.c
+BL31_SOURCES		+= ${S32CC_PLAT}/s32_boot_prof.c
+endif
+
+ifeq (${SCMI_TRACE},1)
+BL31_SOURCES		+= ${S32_DRIVERS}/scmi_logger/s32_scmi_trace.c
+endif
+
+# Program the BL2 boot clocks (peripheral PLL and DFS, LINFLEX, SDHC or QSPI,
+# DDR) by replaying a register sequence computed at build time by
+# tools/nxp/clk_script_gen/clk_script_gen.py, instead of resolving the clock
+# tree at runtime. S32G only, needs FIP_LOCATION.
+S32_CLK_SCRIPT		?= 0
+$(eval $(call add_define_val,S32_CLK_SCRIPT,$(S32_CLK_SCRIPT)))
+
+# Count the EL3 interrupts and time their handlers, per interrupt. The
+# statistics can be queried from the normal world through a SiP SMC.
+S32_IRQ_STATS		?= 0
+$(eval $(call add_define_val,S32_IRQ_STATS,$(S32_IRQ_STATS)))
+
+# PSCI CPU_ON without waiting for the target core: a core turned off without
+# being reset waits in a WFE holding pen instead of a WFI loop woken by an
+# SGI, and initializes its own GIC redistributor.
+S32_FAST_CPU_ON		?= 0
+$(eval $(call add_define_val,S32_FAST_CPU_ON,$(S32_FAST_CPU_ON)))
+
+# Report the PSCI CPU_ON latency, as seen by the caller and the target core
+S32_CPU_ON_BENCH	?= 0
+$(eval $(call add_define_val,S32_CPU_ON_BENCH,$(S32_CPU_ON_BENCH)))
+
 RESET_TO_BL2		:= 1
 
 PLAT_INCLUDES 	+= \
@@ -149,6 +280,7 @@ BL2_SOURCES += \
 			drivers/partition/partition.c \
 			drivers/partition/gpt.c \
 			${S32_DRIVERS}/mmc/s32_mmc.c \
+			${S32_DRIVERS}/qspi/s32_qspi.c \
 			${S32_DRIVERS}/scmi_logger/s32_scmi_logger.c \
 			lib/optee/optee_utils.c \
 			${S32CC_PLAT}/s32_bl2_el3.c \
@@ -301,6 +433,9 @@ FIP_ALIGN := 16
 FIP_MAXIMUM_SIZE	:= 0x300000
 $(eval $(call add_define,FIP_MAXIMUM_SIZE))
 
+# Index the FIP ToC once instead of reading it back on every image load
+FIP_TOC_INDEX_SIZE	:= 32
+
 BL2_W_DTB		:= ${BUILD_PLAT}/bl2_w_dtb.bin
 BL2_W_DTB_S32		:= ${BUILD_PLAT}/bl2_w_dtb.s32
 BL2_BIN			:= $(strip $(call IMG_BIN,bl2))
@@ -454,14 +589,28 @@ call_mkimage: ${BL2_W_DTB} ${MKIMAGE_FIP_CONF_FILE}
 	${ECHO} "S32_BL33_AT_EL2           = ${S32_BL33_AT_EL2}"
 	${ECHO} "S32_SAVE_CNTVCT           = ${S32_SAVE_CNTVCT}"
 	${ECHO} "SCMI_LOGGER               = ${SCMI_LOGGER}"
+	${ECHO} "SCMI_TRACE                = ${SCMI_TRACE}"
+	${ECHO} "S32_IRQ_STATS             = ${S32_IRQ_STATS}"
+	${ECHO} "S32_FAST_CPU_ON           = ${S32_FAST_CPU_ON}"
+	${ECHO} "S32_CPU_ON_BENCH          = ${S32_CPU_ON_BENCH}"
 	${ECHO} "S32CC_USE_SCMI_PINCTRL    = ${S32CC_USE_SCMI_PINCTRL}"
 	${ECHO} "S32CC_USE_SCMI_NVMEM      = ${S32CC_USE_SCMI_NVMEM}"
 	${ECHO} "S32CC_SCMI_GPIO_FIXUP     = ${S32CC_SCMI_GPIO_FIXUP}"
 	${ECHO} "S32CC_SCMI_NVMEM_FIXUP    = ${S32CC_SCMI_NVMEM_FIXUP}"
 	${ECHO} "S32CC_SCMI_SPLIT_CHAN     = ${S32CC_SCMI_SPLIT_CHAN}"
+	${ECHO} "S32_SCMI_ASYNC            = ${S32_SCMI_ASYNC}"
+	${ECHO} "S32_SCMI_ASYNC_SCP_VERSION = ${S32_SCMI_ASYNC_SCP_VERSION}"
+	${ECHO} "S32_OSPM_SCMI_CHANNELS    = ${S32_OSPM_SCMI_CHANNELS}"
+	${ECHO} "S32_SCMI_PERF_FC          = ${S32_SCMI_PERF_FC}"
 	${ECHO} "S32_USE_LINFLEX_IN_BL31   = ${S32_USE_LINFLEX_IN_BL31}"
 	${ECHO} "S32_SET_NEAREST_FREQ      = ${S32_SET_NEAREST_FREQ}"
+	${ECHO} "S32_CLK_SCRIPT            = ${S32_CLK_SCRIPT}"
+	${ECHO} "S32_HSE_DEFERRED_AUTH     = ${S32_HSE_DEFERRED_AUTH}"
+	${ECHO} "S32_HSE_MEM_BENCH         = ${S32_HSE_MEM_BENCH}"
 	${ECHO} "S32_LINFLEX_BAUDRATE      = ${S32_LINFLEX_BAUDRATE}"
+ifneq ($(S32_DDR_TRAIN_CACHE),)
+	${ECHO} "S32_DDR_TRAIN_CACHE       = ${S32_DDR_TRAIN_CACHE}"
+endif
 
 	${ECHO} "==================================="
 
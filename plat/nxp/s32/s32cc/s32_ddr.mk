@@ -1,5 +1,5 @@
 #
-# Copyright 2022-2023 NXP
+# Copyright 2022-2024 NXP
 #
 # SPDX-License-Identifier: BSD-3-Clause
 #
@@ -15,9 +15,40 @@ COMMON_DDR_DRV	= ${DDR_DRV}
 PLAT_DDR_DRV	= ${DDR_DRV}/${S32_PLAT_SOC}/${PLAT_BOARD}
 endif
 
+DDR_FW_SRCS := \
+	${COMMON_DDR_DRV}/imem_cfg.c \
+	${PLAT_DDR_DRV}/dmem_cfg.c \
+
+# Store the PHY firmware images run-length packed in BL2, see
+# tools/nxp/ddr_fw_pack/ddr_fw_pack.py. Not available with CUSTOM_DDR_DRV,
+# whose load_phy_image() expects the plain tables.
+ifneq (${CUSTOM_DDR_DRV},)
+S32_DDR_FW_PACKED	:= 0
+else
+S32_DDR_FW_PACKED	?= 1
+endif
+$(eval $(call add_define_val,S32_DDR_FW_PACKED,$(S32_DDR_FW_PACKED)))
+
+ifeq (${S32_DDR_FW_PACKED},1)
+DDR_FW_PACK		:= tools/nxp/ddr_fw_pack/ddr_fw_pack.py
+DDR_FW_PACK_DIR		:= ${BUILD_PLAT}/ddr_fw
+
+DDR_DRV_SRCS += \
+	$(patsubst %.c,${DDR_FW_PACK_DIR}/%_packed.c,$(notdir ${DDR_FW_SRCS}))
+
+${DDR_FW_PACK_DIR}/imem_cfg_packed.c: ${COMMON_DDR_DRV}/imem_cfg.c ${DDR_FW_PACK}
+${DDR_FW_PACK_DIR}/dmem_cfg_packed.c: ${PLAT_DDR_DRV}/dmem_cfg.c ${DDR_FW_PACK}
+
+${DDR_FW_PACK_DIR}/%_packed.c:
+	${Q}mkdir -p $(dir $@)
+	${ECHO} "  PACK    $@"
+	${Q}${PYTHON} ${DDR_FW_PACK} $(firstword $^) $@
+else
+DDR_DRV_SRCS += ${DDR_FW_SRCS}
+endif
+
 DDR_DRV_SRCS += \
 	${PLAT_DDR_DRV}/ddrc_cfg.c \
-	${PLAT_DDR_DRV}/dmem_cfg.c \
 	${PLAT_DDR_DRV}/dq_swap_cfg.c \
 	${PLAT_DDR_DRV}/phy_cfg.c \
 	${PLAT_DDR_DRV}/pie_cfg.c \
@@ -26,7 +57,6 @@ DDR_DRV_SRCS += \
 	${COMMON_DDR_DRV}/ddr_lp.c \
 	${COMMON_DDR_DRV}/ddr_lp_csr.c \
 	${COMMON_DDR_DRV}/ddrss_cfg.c \
-	${COMMON_DDR_DRV}/imem_cfg.c \
 	${DDR_DRV}/ddr_density.c \
 
 # If CUSTOM_DDR_DRV is set, this target modifies the ddr_utils.h file
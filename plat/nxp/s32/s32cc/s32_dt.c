@@ -16,6 +16,30 @@
 #include <s32cc_bl_common.h>
 #include <s32cc_dt.h>
 
+/*
+ * Upper bound of the DT nodes with a 'compatible' or a 'phandle' property.
+ * If the DT has more, the lookups go through libfdt.
+ */
+#define DT_INDEX_MAX_NODES	(256U)
+
+struct dt_index_node {
+	int offset;
+	uint32_t phandle;
+	/* 'compatible' string list, relative to the DT base */
+	uint32_t compat;
+	uint16_t compat_len;
+	uint8_t status;
+};
+
+/*
+ * Built in a single pass over the DT, in offset order. The BL2 DT is never
+ * modified, the fixups are applied on the copy passed to BL33, so the index
+ * doesn't need to be updated once built.
+ */
+static struct dt_index_node dt_index[DT_INDEX_MAX_NODES];
+static size_t dt_index_len;
+static bool dt_index_valid;
+
 static int fdt_checked;
 
 static void *get_fdt(void)
@@ -23,12 +47,119 @@ static void *get_fdt(void)
 	return (void *)get_bl2_dtb_base();
 }
 
+static uint8_t get_status(const char *status, int len)
+{
+	if ((status == NULL) || (strncmp(status, "okay", (size_t)len) == 0))
+		return DT_ENABLED;
+
+	return DT_DISABLED;
+}
+
+static void index_node(const void *fdt, int node,
+		       struct dt_index_node *entry)
+{
+	const char *name, *status = NULL;
+	const void *val;
+	int prop, len, status_len = 0;
+
+	entry->offset = node;
+	entry->phandle = 0U;
+	entry->compat = 0U;
+	entry->compat_len = 0U;
+
+	fdt_for_each_property_offset(prop, fdt, node) {
+		val = fdt_getprop_by_offset(fdt, prop, &name, &len);
+		if (!val)
+			continue;
+
+		if (!strcmp(name, "compatible") && len > 0 &&
+		    len <= UINT16_MAX) {
+			entry->compat = (uintptr_t)val - (uintptr_t)fdt;
+			entry->compat_len = (uint16_t)len;
+		} else if (!strcmp(name, "status")) {
+			status = val;
+			status_len = len;
+		} else if ((!strcmp(name, "phandle") ||
+			    !strcmp(name, "linux,phandle")) &&
+			   len == (int)sizeof(fdt32_t) && !entry->phandle) {
+			entry->phandle = fdt32_to_cpu(*(const fdt32_t *)val);
+		}
+	}
+
+	entry->status = get_status(status, status_len);
+}
+
+static void dt_index_build(const void *fdt)
+{
+	struct dt_index_node entry;
+	int node;
+
+	dt_index_len = 0U;
+
+	for (node = fdt_next_node(fdt, -1, NULL);
+	     node >= 0;
+	     node = fdt_next_node(fdt, node, NULL)) {
+		index_node(fdt, node, &entry);
+		if (!entry.compat_len && !entry.phandle)
+			continue;
+
+		if (dt_index_len == ARRAY_SIZE(dt_index)) {
+			WARN("Too many DT nodes to index\n");
+			return;
+		}
+
+		dt_index[dt_index_len++] = entry;
+	}
+
+	if (node != -FDT_ERR_NOTFOUND)
+		return;
+
+	dt_index_valid = true;
+}
+
+static bool use_dt_index(const void *fdt)
+{
+	return dt_index_valid && fdt == get_fdt();
+}
+
+/* First index entry with an offset greater than 'offset' */
+static size_t dt_index_next(int offset)
+{
+	size_t low = 0U, high = dt_index_len, mid;
+
+	while (low < high) {
+		mid = low + (high - low) / 2U;
+		if (dt_index[mid].offset <= offset)
+			low = mid + 1U;
+		else
+			high = mid;
+	}
+
+	return low;
+}
+
+static const struct dt_index_node *dt_index_find(int offset)
+{
+	size_t i = dt_index_next(offset - 1);
+
+	if (i < dt_index_len && dt_index[i].offset == offset)
+		return &dt_index[i];
+
+	return NULL;
+}
+
 int dt_open_and_check(void)
 {
-	int ret = fdt_check_header(get_fdt());
+	int ret;
+
+	if (fdt_checked == 1)
+		return 0;
 
-	if (ret == 0)
+	ret = fdt_check_header(get_fdt());
+	if (ret == 0) {
+		dt_index_build(get_fdt());
 		fdt_checked = 1;
+	}
 
 	return ret;
 }
@@ -43,17 +174,60 @@ int fdt_get_address(void **fdt_addr)
 
 uint8_t fdt_get_status(int node)
 {
-	uint8_t status = DT_DISABLED;
-	int len;
+	const struct dt_index_node *entry;
 	const char *cchar;
+	int len = 0;
+
+	if (dt_index_valid) {
+		entry = dt_index_find(node);
+		if (entry)
+			return entry->status;
+	}
 
 	cchar = fdt_getprop(get_fdt(), node, "status", &len);
-	if ((cchar == NULL) ||
-			(strncmp(cchar, "okay", (size_t)len) == 0)) {
-		status = DT_ENABLED;
+
+	return get_status(cchar, len);
+}
+
+int dt_node_offset_by_compatible(const void *fdt, int startoffset,
+				 const char *compatible)
+{
+	const struct dt_index_node *entry;
+	size_t i;
+
+	if (!use_dt_index(fdt))
+		return fdt_node_offset_by_compatible(fdt, startoffset,
+						     compatible);
+
+	for (i = dt_index_next(startoffset); i < dt_index_len; i++) {
+		entry = &dt_index[i];
+		if (!entry->compat_len)
+			continue;
+
+		if (fdt_stringlist_contains((const char *)fdt + entry->compat,
+					    entry->compat_len, compatible))
+			return entry->offset;
+	}
+
+	return -FDT_ERR_NOTFOUND;
+}
+
+int dt_node_offset_by_phandle(const void *fdt, uint32_t phandle)
+{
+	size_t i;
+
+	if (!use_dt_index(fdt))
+		return fdt_node_offset_by_phandle(fdt, phandle);
+
+	if ((phandle == 0U) || (phandle == UINT32_MAX))
+		return -FDT_ERR_BADPHANDLE;
+
+	for (i = 0U; i < dt_index_len; i++) {
+		if (dt_index[i].phandle == phandle)
+			return dt_index[i].offset;
 	}
 
-	return status;
+	return -FDT_ERR_NOTFOUND;
 }
 
 int dt_enable_clocks(void *fdt_addr, int node)
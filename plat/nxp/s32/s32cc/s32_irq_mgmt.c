@@ -1,70 +1,137 @@
 /*
- * Copyright 2022-2023 NXP
+ * Copyright 2022-2024 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
  * This is based on plat/nxp/common/setup/ls_interrupt_mgmt.c
  */
+#include <arch_helpers.h>
 #include <bl31/interrupt_mgmt.h>
 #include <common/debug.h>
+#include <drivers/arm/gic_common.h>
+#include <lib/utils_def.h>
 #include <plat/common/platform.h>
 
 #include <platform_def.h>
 #include <assert.h>
+#include <s32cc_interrupt_mgmt.h>
+
+typedef struct s32_irq_stats {
+	uint64_t count;
+	uint64_t total;
+	uint64_t max;
+} s32_irq_stats_t;
 
 typedef struct s32_irq {
 	uint32_t id;
 	interrupt_type_handler_t handler;
+#if (S32_IRQ_STATS == 1)
+	/* Each core only updates its own counters */
+	s32_irq_stats_t stats[PLATFORM_CORE_COUNT];
+#endif
 } s32_irq_t;
 
+/* Index + 1 in s32_irq_map of the handler of each INTID, 0 if none */
+static uint8_t s32_irq_slot[MAX_SPI_ID + 1U];
 static s32_irq_t s32_irq_map[S32CC_MAX_IRQ_NUM];
 static unsigned int irq_count;
 
-static interrupt_type_handler_t get_irq_handler(uint32_t id)
+CASSERT(S32CC_MAX_IRQ_NUM < UINT8_MAX, assert_s32cc_max_irq_num);
+
+static s32_irq_t *get_irq(uint32_t id)
 {
-	unsigned int i;
+	uint8_t slot;
 
-	for (i = 0; i < irq_count; i++) {
-		if (id == s32_irq_map[i].id)
-			return s32_irq_map[i].handler;
-	}
+	if (id >= ARRAY_SIZE(s32_irq_slot))
+		return NULL;
+
+	slot = s32_irq_slot[id];
+	if (!slot)
+		return NULL;
 
-	return NULL;
+	return &s32_irq_map[slot - 1U];
 }
 
 static int set_irq_handler(uint32_t id, interrupt_type_handler_t handler)
 {
-	if (irq_count >= S32CC_MAX_IRQ_NUM || !handler) {
+	if (irq_count >= S32CC_MAX_IRQ_NUM || !handler ||
+	    id >= ARRAY_SIZE(s32_irq_slot)) {
 		return -EINVAL;
 	}
 
 	s32_irq_map[irq_count].id = id;
-	s32_irq_map[irq_count++].handler = handler;
+	s32_irq_map[irq_count].handler = handler;
+	s32_irq_slot[id] = ++irq_count;
 
 	return 0;
 }
 
 int request_intr_type_el3(uint32_t id, interrupt_type_handler_t handler)
 {
-	if (get_irq_handler(id) != NULL) {
+	if (get_irq(id) != NULL) {
 		return -EALREADY;
 	}
 
 	return set_irq_handler(id, handler);
 }
 
+#if (S32_IRQ_STATS == 1)
+static void update_irq_stats(s32_irq_t *irq, uint64_t ticks)
+{
+	s32_irq_stats_t *stats = &irq->stats[plat_my_core_pos()];
+
+	stats->count++;
+	stats->total += ticks;
+	if (ticks > stats->max)
+		stats->max = ticks;
+}
+
+int s32cc_el3_irq_get_stats(uint32_t id, uint64_t *count, uint64_t *max,
+			    uint64_t *avg)
+{
+	s32_irq_t *irq = get_irq(id);
+	uint64_t total = 0U;
+	unsigned int i;
+
+	if (!irq || !count || !max || !avg)
+		return -EINVAL;
+
+	*count = 0U;
+	*max = 0U;
+
+	for (i = 0; i < ARRAY_SIZE(irq->stats); i++) {
+		*count += irq->stats[i].count;
+		total += irq->stats[i].total;
+		*max = MAX(*max, irq->stats[i].max);
+	}
+
+	*avg = *count ? total / *count : 0U;
+
+	return 0;
+}
+#endif
+
 static uint64_t s32cc_el3_irq_handler(uint32_t id, uint32_t flags,
 				      void *handle, void *cookie)
 {
 	uint32_t intr_id;
-	interrupt_type_handler_t handler;
+	s32_irq_t *irq;
+#if (S32_IRQ_STATS == 1)
+	uint64_t start;
+#endif
 
 	intr_id = plat_ic_acknowledge_interrupt();
 	intr_id = plat_ic_get_interrupt_id(intr_id);
 
-	handler = get_irq_handler(intr_id);
-	if (handler != NULL) {
-		handler(intr_id, flags, handle, cookie);
+	irq = get_irq(intr_id);
+	if (irq != NULL) {
+#if (S32_IRQ_STATS == 1)
+		start = read_cntpct_el0();
+		irq->handler(intr_id, flags, handle, cookie);
+		update_irq_stats(irq, read_cntpct_el0() - start);
+#else
+		irq->handler(intr_id, flags, handle, cookie);
+#endif
 	}
 
 	/*
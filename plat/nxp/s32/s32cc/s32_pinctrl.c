@@ -288,32 +288,6 @@ int s32_get_pin_addr(uint16_t pin, uintptr_t *pin_addr)
 
 }
 
-static int
-s32_configure_peripheral_pinctrl_scmi(const struct s32_peripheral_config *c)
-{
-	const struct s32_pin_config *cfg;
-	unsigned int i;
-	int ret = 0;
-
-	for (i = 0; i < c->no_configs; i++) {
-		cfg = &c->configs[i];
-
-		if (cfg->no_configs > UINT32_MAX)
-			return -EOVERFLOW;
-
-		ret = s32_scmi_pinctrl_set_mux(&cfg->pin, &cfg->function, 1);
-		if (ret)
-			return ret;
-
-		ret = s32_scmi_pinctrl_set_pcf(&cfg->pin, 1, cfg->configs,
-					       cfg->no_configs);
-		if (ret)
-			return ret;
-	}
-
-	return 0;
-}
-
 int s32_configure_peripheral_pinctrl(const struct s32_peripheral_config *cfg)
 {
 	unsigned int i;
@@ -321,7 +295,8 @@ int s32_configure_peripheral_pinctrl(const struct s32_peripheral_config *cfg)
 	int ret;
 
 	if (is_pinctrl_over_scmi_used()) {
-		return s32_configure_peripheral_pinctrl_scmi(cfg);
+		return s32_scmi_pinctrl_set_periph(cfg->configs,
+						   cfg->no_configs);
 	}
 
 	ret = s32_mmap_siul2_regions();
@@ -23,6 +23,7 @@
 #include <common/debug.h>	/* printing macros such as INFO() */
 #include <drivers/arm/gicv3.h>
 #include <plat/common/platform.h>
+#include <s32cc_boot_prof.h>
 #include <s32cc_scp_scmi.h>
 
 /* See firmware-design, psci-lib-integration-guide for details */
@@ -41,8 +42,126 @@ static bool is_core_in_secondary_cluster(int pos)
 	return (pos >= PLATFORM_CORE_COUNT / 2);
 }
 
+#if (S32_CPU_ON_BENCH == 1)
+/* PSCI_CPU_ON request timestamps, in generic counter ticks */
+struct cpu_on_bench {
+	uint64_t start;
+} __aligned(CACHE_WRITEBACK_GRANULE);
+
+static struct cpu_on_bench cpu_on_bench[PLATFORM_CORE_COUNT];
+
+static void cpu_on_bench_start(unsigned int pos)
+{
+	cpu_on_bench[pos].start = read_cntpct_el0();
+}
+
+/* Time spent by the caller in PSCI_CPU_ON */
+static void cpu_on_bench_caller_done(unsigned int pos)
+{
+	uint64_t ticks = read_cntpct_el0() - cpu_on_bench[pos].start;
+
+	NOTICE("CPU_ON %u: caller released after %llu us\n", pos,
+	       s32_ticks_to_us(ticks));
+}
+
+/* Time from the PSCI_CPU_ON request until the target runs its finisher */
+static void cpu_on_bench_target_done(unsigned int pos)
+{
+	uint64_t ticks = read_cntpct_el0() - cpu_on_bench[pos].start;
+
+	NOTICE("CPU_ON %u: core up after %llu us\n", pos,
+	       s32_ticks_to_us(ticks));
+}
+#else
+static void cpu_on_bench_start(unsigned int pos)
+{
+}
+
+static void cpu_on_bench_caller_done(unsigned int pos)
+{
+}
+
+static void cpu_on_bench_target_done(unsigned int pos)
+{
+}
+#endif
+
+static void online_core_caiu(int pos)
+{
+	if (is_core_in_secondary_cluster(pos) &&
+	    !ncore_is_caiu_online(A53_CLUSTER1_CAIU))
+		ncore_caiu_online(A53_CLUSTER1_CAIU);
+
+	if (!is_core_in_secondary_cluster(pos) &&
+	    !ncore_is_caiu_online(A53_CLUSTER0_CAIU))
+		ncore_caiu_online(A53_CLUSTER0_CAIU);
+}
+
+#if (S32_FAST_CPU_ON == 1)
+#define CPU_PEN_IDLE		(0U)
+#define CPU_PEN_GO		(1U)
+
+/*
+ * Generic timer event stream period in the holding pen, 2^(n + 1) counter
+ * ticks. It bounds the wake-up latency should the SEV of the releasing core
+ * not reach the pen, e.g. across clusters.
+ */
+#define CPU_PEN_EVNTI		(7U)
+
+/*
+ * Holding pen mailbox of a core turned off without being reset. The core
+ * polls it with its data cache off, so each mailbox gets a cache line of its
+ * own, cleaned to memory by the releasing core.
+ *
+ * A PSCI_CPU_ON may come as soon as the core is marked off, before it enters
+ * the pen, so the pen never resets the mailbox. The core does it once on,
+ * whether it left the pen or came out of reset.
+ */
+struct cpu_pen {
+	volatile uint32_t state;
+} __aligned(CACHE_WRITEBACK_GRANULE);
+
+static struct cpu_pen cpu_pens[PLATFORM_CORE_COUNT];
+
+static void set_cpu_pen(unsigned int pos, uint32_t state)
+{
+	cpu_pens[pos].state = state;
+	/* Completes with a DSB, the new state is visible to the pen */
+	flush_dcache_range((uintptr_t)&cpu_pens[pos], sizeof(cpu_pens[pos]));
+}
+
+static uint32_t get_cpu_pen(unsigned int pos)
+{
+	inv_dcache_range((uintptr_t)&cpu_pens[pos], sizeof(cpu_pens[pos]));
+	return cpu_pens[pos].state;
+}
+
+static void release_cpu_pen(unsigned int pos)
+{
+	set_cpu_pen(pos, CPU_PEN_GO);
+	sev();
+}
+
+static void cpu_pen_wait(unsigned int pos)
+{
+	u_register_t cnthctl = read_cnthctl_el2();
+
+	write_cnthctl_el2((cnthctl & ~(EVNTI_MASK << EVNTI_SHIFT)) |
+			  EVNTEN_BIT | (CPU_PEN_EVNTI << EVNTI_SHIFT));
+	isb();
+
+	while (get_cpu_pen(pos) != CPU_PEN_GO)
+		wfe();
+
+	write_cnthctl_el2(cnthctl);
+	isb();
+}
+
 /** Executed by the primary core as part of the PSCI_CPU_ON call,
  *  e.g. during Linux kernel boot.
+ *
+ *  The target completes its bring-up on its own, GIC redistributor included,
+ *  the caller doesn't wait for it.
  */
 static int s32_pwr_domain_on(u_register_t mpidr)
 {
@@ -54,6 +173,48 @@ static int s32_pwr_domain_on(u_register_t mpidr)
 	if (pos < 0)
 		return PSCI_E_INTERN_FAIL;
 
+	cpu_on_bench_start(pos);
+
+	dsbsy();
+
+	if (is_scp_used()) {
+		ret = scp_cpu_on(pos);
+		if (ret)
+			return PSCI_E_INVALID_PARAMS;
+	} else if (is_a53_core_in_reset(pos)) {
+		s32_set_core_entrypoint(pos, core_start_addr);
+		s32_kick_secondary_ca53_core(pos);
+	}
+
+	VERBOSE("S32 TF-A: %s: booting up core %d\n", __func__, pos);
+
+	online_core_caiu(pos);
+
+	update_core_state(pos, CPU_ON, CPU_ON);
+
+	/* Only matters if the core waits in the holding pen */
+	release_cpu_pen(pos);
+
+	cpu_on_bench_caller_done(pos);
+
+	return PSCI_E_SUCCESS;
+}
+#else
+/** Executed by the primary core as part of the PSCI_CPU_ON call,
+ *  e.g. during Linux kernel boot.
+ */
+static int s32_pwr_domain_on(u_register_t mpidr)
+{
+	int pos;
+	int ret;
+	uintptr_t core_start_addr = (uintptr_t)&plat_secondary_cold_boot_setup;
+
+	pos = plat_core_pos_by_mpidr(mpidr);
+	if (pos < 0)
+		return PSCI_E_INTERN_FAIL;
+
+	cpu_on_bench_start(pos);
+
 	dsbsy();
 
 	if (is_scp_used()) {
@@ -79,13 +240,7 @@ static int s32_pwr_domain_on(u_register_t mpidr)
 	NOTICE("S32 TF-A: %s: booting up core %d (%u)\n", __func__, pos,
 	       get_core_state(pos, CPU_USE_WFI_FOR_SLEEP));
 
-	if (is_core_in_secondary_cluster(pos) &&
-	    !ncore_is_caiu_online(A53_CLUSTER1_CAIU))
-		ncore_caiu_online(A53_CLUSTER1_CAIU);
-
-	if (!is_core_in_secondary_cluster(pos) &&
-	    !ncore_is_caiu_online(A53_CLUSTER0_CAIU))
-		ncore_caiu_online(A53_CLUSTER0_CAIU);
+	online_core_caiu(pos);
 
 	update_core_state(pos, CPU_ON, CPU_ON);
 
@@ -97,6 +252,8 @@ static int s32_pwr_domain_on(u_register_t mpidr)
 		plat_ic_raise_el3_sgi(S32_SECONDARY_WAKE_SGI, mpidr);
 	}
 
+	cpu_on_bench_caller_done(pos);
+
 	return PSCI_E_SUCCESS;
 }
 
@@ -141,6 +298,7 @@ static void sleep_wfi_loop(void)
 
 	gicv3_disable_interrupt(S32_SECONDARY_WAKE_SGI, pos);
 }
+#endif
 
 /** Executed by the woken (secondary) core after it exits the wfi holding pen
  *  during cold boot.
@@ -150,6 +308,11 @@ static void s32_pwr_domain_on_finish(const psci_power_state_t *target_state)
 	unsigned int pos = plat_my_core_pos();
 	NOTICE("S32 TF-A: %s: cpu %d running\n", __func__, pos);
 
+#if (S32_FAST_CPU_ON == 1)
+	set_cpu_pen(pos, CPU_PEN_IDLE);
+	gicv3_rdistif_init(pos);
+#endif
+
 	update_core_state(pos, CPU_USE_WFI_FOR_SLEEP, 0);
 	if (!get_core_state(pos, CPUIF_EN)) {
 		gicv3_cpuif_enable(pos);
@@ -159,6 +322,8 @@ static void s32_pwr_domain_on_finish(const psci_power_state_t *target_state)
 #if (S32_SAVE_CNTVCT == 1) && (S32_BL33_AT_EL2 == 1)
 	init_cntvoff_el2();
 #endif
+
+	cpu_on_bench_target_done(pos);
 }
 
 #if defined(PLAT_s32g2) || defined(PLAT_s32g3)
@@ -176,6 +341,8 @@ static void s32g_pwr_domain_suspend_finish(
 #if (S32_SAVE_CNTVCT == 1) && (S32_BL33_AT_EL2 == 1)
 	init_cntvoff_el2();
 #endif
+
+	s32_boot_prof_mark(S32_BOOT_RESUME_DONE, S32_BOOT_ARG_NONE);
 }
 
 static void s32g_pwr_domain_suspend(const psci_power_state_t *target_state)
@@ -231,7 +398,11 @@ static void __dead2 s32_pwr_domain_pwr_down_wfi(
 				plat_panic_handler();
 			}
 		}
+#if (S32_FAST_CPU_ON == 1)
+		cpu_pen_wait(pos);
+#else
 		sleep_wfi_loop();
+#endif
 		plat_secondary_cold_boot_setup();
 	}
 
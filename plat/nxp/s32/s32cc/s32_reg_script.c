@@ -0,0 +1,114 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <assert.h>
+#include <errno.h>
+#include <common/debug.h>
+#include <drivers/delay_timer.h>
+#include <lib/mmio.h>
+
+#include "s32cc_reg_script.h"
+
+void s32_reg_script_init(struct s32_reg_script *script,
+			 struct s32_reg_op *ops, uint32_t max_len)
+{
+	script->ops = ops;
+	script->len = 0U;
+	script->max_len = max_len;
+	script->overflow = false;
+}
+
+static void add_op(struct s32_reg_script *script, uintptr_t addr,
+		   uint32_t op, uint32_t mask, uint32_t value)
+{
+	struct s32_reg_op *entry;
+
+	assert(addr <= UINT32_MAX);
+	assert(!(addr & S32_REG_OP_MASK));
+
+	if (script->len >= script->max_len) {
+		script->overflow = true;
+		return;
+	}
+
+	entry = &script->ops[script->len++];
+	entry->addr = (uint32_t)addr | op;
+	entry->mask = mask;
+	entry->value = value;
+}
+
+void s32_reg_script_write(struct s32_reg_script *script, uintptr_t addr,
+			  uint32_t value)
+{
+	add_op(script, addr, S32_REG_OP_WRITE, UINT32_MAX, value);
+}
+
+void s32_reg_script_clrset(struct s32_reg_script *script, uintptr_t addr,
+			   uint32_t clr, uint32_t set)
+{
+	add_op(script, addr, S32_REG_OP_WRITE, clr | set, set);
+}
+
+void s32_reg_script_poll(struct s32_reg_script *script, uintptr_t addr,
+			 uint32_t mask, uint32_t value)
+{
+	add_op(script, addr, S32_REG_OP_POLL, mask, value & mask);
+}
+
+void s32_reg_script_delay(struct s32_reg_script *script, uint32_t usec)
+{
+	add_op(script, 0U, S32_REG_OP_DELAY, 0U, usec);
+}
+
+static int poll_reg(uintptr_t addr, uint32_t mask, uint32_t value)
+{
+	uint64_t timeout = timeout_init_us(S32_REG_SCRIPT_TIMEOUT_US);
+
+	while ((mmio_read_32(addr) & mask) != value) {
+		if (timeout_elapsed(timeout))
+			return -ETIMEDOUT;
+	}
+
+	return 0;
+}
+
+int s32_reg_script_run(const struct s32_reg_op *ops, uint32_t len)
+{
+	const struct s32_reg_op *entry;
+	uintptr_t addr;
+	uint32_t i;
+	int ret;
+
+	for (i = 0U; i < len; i++) {
+		entry = &ops[i];
+		addr = entry->addr & ~S32_REG_OP_MASK;
+
+		switch (entry->addr & S32_REG_OP_MASK) {
+		case S32_REG_OP_WRITE:
+			if (entry->mask == UINT32_MAX)
+				mmio_write_32(addr, entry->value);
+			else
+				mmio_clrsetbits_32(addr, entry->mask,
+						   entry->value);
+			break;
+		case S32_REG_OP_POLL:
+			ret = poll_reg(addr, entry->mask, entry->value);
+			if (ret) {
+				ERROR("Register script: 0x%lx timed out (op %u)\n",
+				      addr, i);
+				return ret;
+			}
+			break;
+		case S32_REG_OP_DELAY:
+			udelay(entry->value);
+			break;
+		default:
+			ERROR("Register script: invalid op %u\n", i);
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
@@ -3,7 +3,9 @@
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <arch_helpers.h>
 #include <cdefs.h>
+#include <clk/s32gen1_clk_funcs.h>
 #include <clk/s32gen1_scmi_clk.h>
 #include <common/debug.h>
 #include <drivers/scmi-msg.h>
@@ -11,7 +13,10 @@
 #include <dt-bindings/clock/s32cc-scmi-clock.h>
 #include <errno.h>
 #include <lib/utils_def.h>
+#include <plat/common/platform.h>
+#include <s32_bl_common.h>
 #include <s32cc_svc.h>
+#include <string.h>
 
 #ifndef S32GEN1_CLK_MAX_AGENTS
 #define S32GEN1_CLK_MAX_AGENTS	2
@@ -163,27 +168,44 @@ int32_t plat_scmi_clock_rates_array(unsigned int agent_id, unsigned int scmi_id,
 				    unsigned long *rates, size_t *nb_elts,
 				    uint32_t start_idx)
 {
+	unsigned long clk_rates[S32GEN1_MAX_NUM_FREQ];
 	struct clk_driver *drv;
+	size_t capacity = 0;
+	size_t nrates = 0;
 	struct clk clk;
 	int ret;
 
 	if (!are_agent_clk_valid(agent_id, scmi_id))
 		return SCMI_INVALID_PARAMETERS;
 
-	*nb_elts = 0;
+	/* Room in @rates, when the caller asks for the rates themselves */
+	if (rates)
+		capacity = *nb_elts;
 
-	if (rates == NULL)
-		return SCMI_SUCCESS;
+	*nb_elts = 0;
 
 	drv = get_clk_driver_by_name(S32GEN1_CLK_DRV_NAME);
 	clk.drv = drv;
 	clk.data = NULL;
 	clk.id = scmi_id;
 
-	ret = s32gen1_scmi_clk_get_rates(&clk, rates, nb_elts);
+	/* Served from the rate tables cached by the clock driver */
+	ret = s32gen1_scmi_clk_get_rates(&clk, clk_rates, &nrates);
 	if (ret == -EINVAL)
 		return SCMI_INVALID_PARAMETERS;
 
+	if (start_idx > nrates)
+		return SCMI_INVALID_PARAMETERS;
+
+	/* The caller only asks for the number of rates */
+	if (rates == NULL) {
+		*nb_elts = nrates;
+		return SCMI_SUCCESS;
+	}
+
+	*nb_elts = MIN(nrates - start_idx, capacity);
+	memcpy(rates, &clk_rates[start_idx], *nb_elts * sizeof(rates[0]));
+
 	return SCMI_SUCCESS;
 }
 
@@ -306,3 +328,49 @@ int32_t plat_scmi_clock_set_state(unsigned int agent_id, unsigned int scmi_id,
 	return ret;
 }
 
+#if (S32_CLK_RATE_BENCH == 1)
+#define RATE_BENCH_ROUNDS	(64U)
+
+static const unsigned int rate_bench_clks[] = {
+	S32CC_SCMI_CLK_A53,
+	S32CC_SCMI_CLK_LINFLEX_LIN,
+	S32CC_SCMI_CLK_LINFLEX_XBAR,
+	S32CC_SCMI_CLK_USDHC_CORE,
+};
+
+/*
+ * Measure the CLOCK_RATE_GET handling, once with empty rate caches, i.e. a
+ * full walk of the clock tree, and once with warm caches.
+ */
+void s32_scmi_clk_rate_bench(void)
+{
+	uint64_t start, uncached = 0U, cached = 0U;
+	unsigned int round, clk_id, n = 0U;
+	size_t i;
+
+	for (round = 0U; round < RATE_BENCH_ROUNDS; round++) {
+		for (i = 0U; i < ARRAY_SIZE(rate_bench_clks); i++) {
+			clk_id = rate_bench_clks[i];
+
+			s32gen1_clk_invalidate_rates();
+
+			start = read_cntpct_el0();
+			(void)plat_scmi_clock_get_rate(S32_SCMI_AGENT_OSPM,
+						       clk_id);
+			uncached += read_cntpct_el0() - start;
+
+			start = read_cntpct_el0();
+			(void)plat_scmi_clock_get_rate(S32_SCMI_AGENT_OSPM,
+						       clk_id);
+			cached += read_cntpct_el0() - start;
+
+			n++;
+		}
+	}
+
+	s32gen1_clk_invalidate_rates();
+
+	NOTICE("SCMI clock rate query: %llu ns uncached, %llu ns cached\n",
+	       s32_ticks_to_ns(uncached) / n, s32_ticks_to_ns(cached) / n);
+}
+#endif
@@ -8,10 +8,19 @@
 #include <common/debug.h>
 #include <drivers/scmi-msg.h>
 #include <drivers/scmi.h>
+#include <lib/mmio.h>
 #include <lib/utils_def.h>
+#include <platform_def.h>
+#include <s32cc_interrupt_mgmt.h>
 #include <s32cc_svc.h>
+#include <scmi-msg/perf.h>
 
 #include <dt-bindings/clock/s32cc-scmi-clock.h>
+#ifdef PLAT_s32g3
+#include <dt-bindings/mscm/s32g3-mscm.h>
+#else
+#include <dt-bindings/mscm/s32cc-mscm.h>
+#endif
 #include <dt-bindings/perf/s32cc-scmi-perf.h>
 
 struct perf_domain {
@@ -26,12 +35,74 @@ struct perf_domain {
 { .clock_id = (ID), .name = (NAME), .attributes = (ATTR), \
 	.min_level = (MIN_LEVEL), .max_level = (MAX_LEVEL), }
 
+#if (S32_SCMI_PERF_FC == 1)
+#define A53_PERF_ATTRIBUTES	(SCMI_PERF_SET_LIMITS | SCMI_PERF_SET_LEVEL | \
+				 SCMI_PERF_FASTCHANNELS)
+#else
+#define A53_PERF_ATTRIBUTES	(SCMI_PERF_SET_LIMITS | SCMI_PERF_SET_LEVEL)
+#endif
+
 static struct perf_domain domains[] = {
 	[S32CC_SCMI_PERF_A53] = PERF_DOMAIN(S32CC_SCMI_CLK_A53, "a53",
-		SCMI_PERF_SET_LIMITS | SCMI_PERF_SET_LEVEL,
+		A53_PERF_ATTRIBUTES,
 		S32GEN1_A53_MIN_LEVEL, S32GEN1_A53_MAX_LEVEL),
 };
 
+#if (S32_SCMI_PERF_FC == 1)
+/*
+ * FastChannel cells of a performance domain. The agent writes the requested
+ * level or limits into the 'set' cells and rings the MSCM doorbell, while
+ * BL31 keeps the 'get' cells up to date. Changes made through the messages
+ * are mirrored into the 'set' cells as well, otherwise the next doorbell
+ * would apply the stale FastChannel request again.
+ */
+struct perf_fc_cells {
+	uint32_t level_set;
+	uint32_t level_get;
+	uint32_t limits_set[2];
+	uint32_t limits_get[2];
+};
+
+#define FC_LIMITS_MAX		0
+#define FC_LIMITS_MIN		1
+
+CASSERT(sizeof(struct perf_fc_cells) * ARRAY_SIZE(domains) <=
+	S32_OSPM_SCMI_FC_SIZE, assert_perf_fc_cells_size);
+
+static struct perf_fc_cells *get_fc_cells(unsigned int domain_id)
+{
+	return (struct perf_fc_cells *)S32_OSPM_SCMI_FC_MEM + domain_id;
+}
+
+static void update_fc_level(unsigned int domain_id, unsigned int perf_level)
+{
+	struct perf_fc_cells *cells = get_fc_cells(domain_id);
+
+	mmio_write_32((uintptr_t)&cells->level_set, perf_level);
+	mmio_write_32((uintptr_t)&cells->level_get, perf_level);
+}
+
+static void update_fc_limits(unsigned int domain_id, unsigned int range_max,
+			     unsigned int range_min)
+{
+	struct perf_fc_cells *cells = get_fc_cells(domain_id);
+
+	mmio_write_32((uintptr_t)&cells->limits_set[FC_LIMITS_MAX], range_max);
+	mmio_write_32((uintptr_t)&cells->limits_set[FC_LIMITS_MIN], range_min);
+	mmio_write_32((uintptr_t)&cells->limits_get[FC_LIMITS_MAX], range_max);
+	mmio_write_32((uintptr_t)&cells->limits_get[FC_LIMITS_MIN], range_min);
+}
+#else
+static void update_fc_level(unsigned int domain_id, unsigned int perf_level)
+{
+}
+
+static void update_fc_limits(unsigned int domain_id, unsigned int range_max,
+			     unsigned int range_min)
+{
+}
+#endif
+
 size_t plat_scmi_perf_domain_count(unsigned int agent_id __unused)
 {
 	return ARRAY_SIZE(domains);
@@ -129,6 +200,7 @@ int32_t plat_scmi_perf_set_level(unsigned int agent_id __unused,
 				    unsigned int perf_level __unused)
 {
 	unsigned int clock_id;
+	int32_t ret;
 
 	if (domain_id >= ARRAY_SIZE(domains))
 		return SCMI_NOT_FOUND;
@@ -143,7 +215,11 @@ int32_t plat_scmi_perf_set_level(unsigned int agent_id __unused,
 	clock_id = domains[domain_id].clock_id;
 
 	/* Only the platform is allowed to set the perf level */
-	return s32gen1_scmi_set_level(S32_SCMI_AGENT_PLAT, clock_id, domain_id, perf_level);
+	ret = s32gen1_scmi_set_level(S32_SCMI_AGENT_PLAT, clock_id, domain_id, perf_level);
+	if (ret == SCMI_SUCCESS)
+		update_fc_level(domain_id, perf_level);
+
+	return ret;
 }
 
 int32_t plat_scmi_perf_get_limits(unsigned int agent_id, unsigned int domain_id,
@@ -189,6 +265,143 @@ int32_t plat_scmi_perf_set_limits(unsigned int agent_id, unsigned int domain_id,
 	domains[domain_id].max_level = range_max;
 	domains[domain_id].min_level = range_min;
 
+	update_fc_limits(domain_id, range_max, range_min);
+
 	return SCMI_SUCCESS;
 }
 
+#if (S32_SCMI_PERF_FC == 1)
+int32_t plat_scmi_perf_describe_fastchannel(unsigned int agent_id __unused,
+					    unsigned int domain_id,
+					    unsigned int message_id,
+					    struct scmi_perf_fastchannel *fc)
+{
+	struct perf_fc_cells *cells;
+	bool doorbell = false;
+
+	if (domain_id >= ARRAY_SIZE(domains))
+		return SCMI_NOT_FOUND;
+
+	if (!(domains[domain_id].attributes & SCMI_PERF_FASTCHANNELS))
+		return SCMI_NOT_SUPPORTED;
+
+	cells = get_fc_cells(domain_id);
+
+	switch (message_id) {
+	case SCMI_PERFORMANCE_LEVEL_SET:
+		fc->chan_addr = (uintptr_t)&cells->level_set;
+		fc->chan_size = sizeof(cells->level_set);
+		doorbell = true;
+		break;
+	case SCMI_PERFORMANCE_LEVEL_GET:
+		fc->chan_addr = (uintptr_t)&cells->level_get;
+		fc->chan_size = sizeof(cells->level_get);
+		break;
+	case SCMI_PERFORMANCE_LIMITS_SET:
+		fc->chan_addr = (uintptr_t)&cells->limits_set[0];
+		fc->chan_size = sizeof(cells->limits_set);
+		doorbell = true;
+		break;
+	case SCMI_PERFORMANCE_LIMITS_GET:
+		fc->chan_addr = (uintptr_t)&cells->limits_get[0];
+		fc->chan_size = sizeof(cells->limits_get);
+		break;
+	default:
+		return SCMI_NOT_SUPPORTED;
+	}
+
+	fc->rate_limit = 0U;
+
+	if (doorbell) {
+		fc->db_addr = MSCM_IRCP_IGR(A53_0_CPN, S32_SCMI_PERF_FC_IRQ);
+		fc->db_set_mask = BIT_32(0);
+		fc->db_preserve_mask = 0U;
+	} else {
+		fc->db_addr = 0U;
+	}
+
+	return SCMI_SUCCESS;
+}
+
+/*
+ * The 'set' cells are compared against the current state of the domain. The
+ * message handlers mirror their changes into these cells, so a doorbell only
+ * applies what the agent wrote through the FastChannels since.
+ */
+static void apply_fc_requests(unsigned int domain_id)
+{
+	struct perf_fc_cells *cells = get_fc_cells(domain_id);
+	uint32_t level, range_max, range_min;
+	unsigned int curr_level;
+	int32_t ret;
+
+	range_max = mmio_read_32((uintptr_t)&cells->limits_set[FC_LIMITS_MAX]);
+	range_min = mmio_read_32((uintptr_t)&cells->limits_set[FC_LIMITS_MIN]);
+	if (range_max != domains[domain_id].max_level ||
+	    range_min != domains[domain_id].min_level) {
+		ret = plat_scmi_perf_set_limits(S32_SCMI_AGENT_OSPM, domain_id,
+						range_max, range_min);
+		if (ret != SCMI_SUCCESS)
+			VERBOSE("Failed to set perf limits [%u, %u]: %d\n",
+				range_min, range_max, ret);
+	}
+
+	level = mmio_read_32((uintptr_t)&cells->level_set);
+	ret = plat_scmi_perf_get_level(S32_SCMI_AGENT_OSPM, domain_id,
+				       &curr_level);
+	if (ret != SCMI_SUCCESS || level != curr_level) {
+		ret = plat_scmi_perf_set_level(S32_SCMI_AGENT_OSPM, domain_id,
+					       level);
+		if (ret != SCMI_SUCCESS)
+			VERBOSE("Failed to set perf level %u: %d\n",
+				level, ret);
+	}
+}
+
+static uint64_t perf_fc_doorbell_handler(uint32_t id, uint32_t flags,
+					 void *handle, void *cookie)
+{
+	uintptr_t isr = MSCM_IRCP_ISR(A53_0_CPN, S32_SCMI_PERF_FC_IRQ);
+	unsigned int domain_id;
+
+	/* Acknowledge the doorbell before sampling the cells */
+	mmio_write_32(isr, mmio_read_32(isr));
+
+	s32_scmi_lock();
+	for (domain_id = 0U; domain_id < ARRAY_SIZE(domains); domain_id++) {
+		if (domains[domain_id].attributes & SCMI_PERF_FASTCHANNELS)
+			apply_fc_requests(domain_id);
+	}
+	s32_scmi_unlock();
+
+	return 0;
+}
+
+int s32_scmi_perf_fc_init(void)
+{
+	unsigned int max_level, min_level;
+	struct perf_fc_cells *cells;
+	unsigned int domain_id, level;
+
+	for (domain_id = 0U; domain_id < ARRAY_SIZE(domains); domain_id++) {
+		cells = get_fc_cells(domain_id);
+		level = s32gen1_scmi_get_level(S32_SCMI_AGENT_PLAT,
+					       domains[domain_id].clock_id,
+					       domain_id);
+
+		max_level = domains[domain_id].max_level;
+		min_level = domains[domain_id].min_level;
+
+		*cells = (struct perf_fc_cells) {
+			.level_set = level,
+			.level_get = level,
+			.limits_set = { max_level, min_level },
+			.limits_get = { max_level, min_level },
+		};
+	}
+
+	return request_intr_type_el3(MSCM_C2C_IRQ_INTID(S32_SCMI_PERF_FC_IRQ),
+				     perf_fc_doorbell_handler);
+}
+#endif
+
@@ -7,6 +7,7 @@
 #include <assert.h>
 #include <arm/css/scmi/scmi_private.h>
 #include <errno.h>
+#include <string.h>
 #include <s32cc_scp_scmi.h>
 
 #include "include/s32cc_scmi_pinctrl_utils.h"
@@ -46,84 +47,67 @@ struct scmi_pinctrl_set_pcf_request_p2a {
 	int32_t status;
 };
 
-static int s32_scmi_pinctrl_set_mux_chunk(const uint16_t *pins,
-					  const uint16_t *funcs,
-					  const unsigned int no)
+static int add_mux_msg(struct scp_scmi_seq *seq, const uint16_t *pins,
+		       const uint16_t *funcs, const unsigned int no)
 {
 	struct scmi_pinctrl_set_mux_request_a2p *payload_args;
-	struct scmi_pinctrl_set_mux_request_p2a *payload_resp;
-	uint8_t buffer[S32_SCP_BUF_SIZE];
-	unsigned int token = 0;
-	mailbox_mem_t *mbx_mem;
 	unsigned int i;
-	int ret;
-
-	_Static_assert(sizeof(buffer) >= sizeof(*mbx_mem),
-		       "SCMI message buffer is too small!");
 
 	if (no > SCMI_MAX_PINS)
 		return -EINVAL;
 
-	memset(buffer, 0, sizeof(buffer));
+	payload_args = scp_scmi_seq_add(seq, SCMI_PROTOCOL_ID_PINCTRL,
+					SCMI_PINCTRL_PINMUX_SET,
+					sizeof(*payload_args) +
+					no * sizeof(payload_args->pf[0]));
+	if (!payload_args)
+		return -ENOMEM;
 
-	mbx_mem = (mailbox_mem_t *)buffer;
-	mbx_mem->res_a = 0U;
-	mbx_mem->status = 0U;
-	mbx_mem->res_b = 0UL;
-	mbx_mem->flags = SCMI_FLAG_RESP_POLL;
-	mbx_mem->len = 4U + sizeof(*payload_args);
-	mbx_mem->msg_header = SCMI_MSG_CREATE(SCMI_PROTOCOL_ID_PINCTRL,
-					      SCMI_PINCTRL_PINMUX_SET,
-					      token);
-
-	payload_args =
-		(struct scmi_pinctrl_set_mux_request_a2p *)mbx_mem->payload;
 	payload_args->no_pins = no;
 	for (i = 0; i < no; i++) {
 		payload_args->pf[i].pin = pins[i];
 		payload_args->pf[i].function = funcs[i];
 	}
 
-	mbx_mem->len +=
-		no * sizeof(struct scmi_pinctrl_pin_function);
+	return 0;
+}
 
-	ret = send_scmi_to_scp((uintptr_t)mbx_mem, sizeof(buffer), PSCI);
-	if (ret)
-		return ret;
+/* Sends the queued requests if there is no room left for a new one */
+static int flush_full_seq(struct scp_scmi_seq *seq)
+{
+	int ret;
 
-	/* The payload contains the response filled by send_scmi_to_scp() */
-	payload_resp =
-		(struct scmi_pinctrl_set_mux_request_p2a *)mbx_mem->payload;
-	ret = payload_resp->status;
-	if (ret != SCMI_E_SUCCESS) {
-		ERROR("Failed to configure pins %d\n", ret);
-		return ret;
-	}
+	if (seq->n_msgs < ARRAY_SIZE(seq->msgs))
+		return 0;
 
-	return 0;
+	ret = scp_scmi_seq_send(seq);
+	scp_scmi_seq_init(seq, PSCI);
+
+	return ret;
 }
 
 int s32_scmi_pinctrl_set_mux(const uint16_t *pins, const uint16_t *funcs,
 			     const unsigned int no)
 {
-	unsigned int i;
-	int ret = 0;
+	struct scp_scmi_seq seq;
+	unsigned int i, chunk;
+	int ret;
 
-	for (i = 0; i < no / SCMI_MAX_PINS; i++) {
-		ret = s32_scmi_pinctrl_set_mux_chunk(pins, funcs,
-						     SCMI_MAX_PINS);
+	scp_scmi_seq_init(&seq, PSCI);
+
+	for (i = 0; i < no; i += chunk) {
+		chunk = MIN(no - i, (unsigned int)SCMI_MAX_PINS);
+
+		ret = flush_full_seq(&seq);
 		if (ret)
 			return ret;
 
-		pins += SCMI_MAX_PINS;
-		funcs += SCMI_MAX_PINS;
+		ret = add_mux_msg(&seq, pins + i, funcs + i, chunk);
+		if (ret)
+			return ret;
 	}
 
-	if (no % SCMI_MAX_PINS)
-		ret = s32_scmi_pinctrl_set_mux_chunk(pins, funcs,
-						     no % SCMI_MAX_PINS);
-
-	return ret;
+	return scp_scmi_seq_send(&seq);
 }
 
 /* In case we may have unaligned writes which would cause
@@ -141,48 +125,30 @@ void s32_write_u32(void *address, uint32_t value)
 	*(uint16_t *)(address + 2) = temp;
 }
 
-static int s32_scmi_pinctrl_set_pcf_chunk(const uint16_t *pins,
-					  const unsigned int no_pins,
-					  const uint32_t *configs,
-					  const unsigned int no_configs)
+static int add_pcf_msg(struct scp_scmi_seq *seq, const uint16_t *pins,
+		       const unsigned int no_pins, const uint32_t *configs,
+		       const unsigned int no_configs)
 {
 	struct scmi_pinctrl_set_pcf_pins_a2p *payload_pins;
 	struct scmi_pinctrl_set_pcf_conf_a2p *payload_conf;
-	struct scmi_pinctrl_set_pcf_request_p2a *payload_resp;
-	uint8_t buffer[S32_SCP_BUF_SIZE];
-	unsigned int i, cfg, val;
-	unsigned int token = 0;
-	mailbox_mem_t *mbx_mem;
 	uint32_t mask = 0, bool_configs = 0;
-	int ret;
-
-	_Static_assert(sizeof(buffer) >= sizeof(*mbx_mem),
-		       "SCMI message buffer is too small!");
+	unsigned int i, cfg, val;
 
 	if (no_pins > SCMI_MAX_PINS)
 		return -EINVAL;
 
-	memset(buffer, 0, sizeof(buffer));
-
-	mbx_mem = (mailbox_mem_t *)buffer;
-	mbx_mem->res_a = 0U;
-	mbx_mem->status = 0U;
-	mbx_mem->res_b = 0UL;
-	mbx_mem->flags = SCMI_FLAG_RESP_POLL;
-	mbx_mem->len = 4U;
-	mbx_mem->msg_header = SCMI_MSG_CREATE(SCMI_PROTOCOL_ID_PINCTRL,
-					      SCMI_PINCTRL_PINCONF_SET_OVR,
-					      token);
-
-	payload_pins =
-		(struct scmi_pinctrl_set_pcf_pins_a2p *)mbx_mem->payload;
+	payload_pins = scp_scmi_seq_add(seq, SCMI_PROTOCOL_ID_PINCTRL,
+					SCMI_PINCTRL_PINCONF_SET_OVR,
+					sizeof(*payload_pins) +
+					no_pins * sizeof(*payload_pins->pins) +
+					sizeof(*payload_conf));
+	if (!payload_pins)
+		return -ENOMEM;
 
 	payload_pins->no_pins = no_pins;
-	mbx_mem->len += sizeof(*payload_pins);
 	for (i = 0; i < no_pins; i++)
 		payload_pins->pins[i] = pins[i];
 
-	mbx_mem->len += no_pins * sizeof(*payload_pins->pins);
 	payload_conf = (void *)(payload_pins->pins + no_pins);
 
 	for (i = 0; i < no_configs; i++) {
@@ -199,47 +165,156 @@ static int s32_scmi_pinctrl_set_pcf_chunk(const uint16_t *pins,
 	s32_write_u32(&payload_conf->mask, mask);
 	s32_write_u32(&payload_conf->bool_configs, bool_configs);
 
-	if (check_u32_overflow(mbx_mem->len, sizeof(*payload_conf)))
-		return -EINVAL;
+	return 0;
+}
 
-	mbx_mem->len += sizeof(*payload_conf);
+int s32_scmi_pinctrl_set_pcf(const uint16_t *pins, const unsigned int no_pins,
+			     const uint32_t *configs,
+			     const unsigned int no_configs)
+{
+	struct scp_scmi_seq seq;
+	unsigned int i, chunk;
+	int ret;
 
-	ret = send_scmi_to_scp((uintptr_t)mbx_mem, sizeof(buffer), PSCI);
-	if (ret)
-		return ret;
+	scp_scmi_seq_init(&seq, PSCI);
 
-	/* The payload contains the response filled by send_scmi_to_scp() */
-	payload_resp =
-		(struct scmi_pinctrl_set_pcf_request_p2a *)mbx_mem->payload;
-	ret = payload_resp->status;
-	if (ret != SCMI_E_SUCCESS) {
-		ERROR("Failed to configure pins %d\n", ret);
-		return ret;
+	for (i = 0; i < no_pins; i += chunk) {
+		chunk = MIN(no_pins - i, (unsigned int)SCMI_MAX_PINS);
+
+		ret = flush_full_seq(&seq);
+		if (ret)
+			return ret;
+
+		ret = add_pcf_msg(&seq, pins + i, chunk, configs, no_configs);
+		if (ret)
+			return ret;
+	}
+
+	return scp_scmi_seq_send(&seq);
+}
+
+static bool same_pcf(const struct s32_pin_config *a,
+		     const struct s32_pin_config *b)
+{
+	if (a->no_configs != b->no_configs)
+		return false;
+
+	return !memcmp(a->configs, b->configs,
+		       a->no_configs * sizeof(*a->configs));
+}
+
+static int add_periph_mux_msgs(struct scp_scmi_seq *seq,
+			       const struct s32_pin_config *cfgs, size_t no)
+{
+	uint16_t pins[SCMI_MAX_PINS], funcs[SCMI_MAX_PINS];
+	unsigned int n = 0;
+	size_t i;
+	int ret;
+
+	for (i = 0; i < no; i++) {
+		pins[n] = cfgs[i].pin;
+		funcs[n] = cfgs[i].function;
+		n++;
+
+		if (n < SCMI_MAX_PINS && i + 1 < no)
+			continue;
+
+		ret = flush_full_seq(seq);
+		if (ret)
+			return ret;
+
+		ret = add_mux_msg(seq, pins, funcs, n);
+		if (ret)
+			return ret;
+
+		n = 0;
 	}
 
 	return 0;
 }
 
-int s32_scmi_pinctrl_set_pcf(const uint16_t *pins, const unsigned int no_pins,
-			     const uint32_t *configs,
-			     const unsigned int no_configs)
+/*
+ * A single PINCONF request is sent for all the pins sharing the same
+ * configuration.
+ */
+static int add_periph_pcf_msgs(struct scp_scmi_seq *seq,
+			       const struct s32_pin_config *cfgs, size_t no)
 {
-	unsigned int i;
-	int ret = 0;
+	uint16_t pins[SCMI_MAX_PINS];
+	unsigned int n;
+	size_t i, j;
+	int ret;
+
+	for (i = 0; i < no; i++) {
+		if (cfgs[i].no_configs > UINT32_MAX)
+			return -EOVERFLOW;
+
+		/* Already sent along with a previous pin */
+		for (j = 0; j < i; j++)
+			if (same_pcf(&cfgs[j], &cfgs[i]))
+				break;
+		if (j < i)
+			continue;
 
-	for (i = 0; i < no_pins / SCMI_MAX_PINS; i++) {
-		ret = s32_scmi_pinctrl_set_pcf_chunk(pins, no_pins,
-						     configs, no_configs);
+		n = 0;
+		for (j = i; j < no; j++) {
+			if (!same_pcf(&cfgs[j], &cfgs[i]))
+				continue;
+
+			pins[n++] = cfgs[j].pin;
+			if (n < SCMI_MAX_PINS)
+				continue;
+
+			ret = flush_full_seq(seq);
+			if (ret)
+				return ret;
+
+			ret = add_pcf_msg(seq, pins, n, cfgs[i].configs,
+					  cfgs[i].no_configs);
+			if (ret)
+				return ret;
+
+			n = 0;
+		}
+
+		if (!n)
+			continue;
+
+		ret = flush_full_seq(seq);
 		if (ret)
 			return ret;
 
-		pins += SCMI_MAX_PINS;
-		configs += SCMI_MAX_PINS;
+		ret = add_pcf_msg(seq, pins, n, cfgs[i].configs,
+				  cfgs[i].no_configs);
+		if (ret)
+			return ret;
 	}
 
-	if (no_pins % SCMI_MAX_PINS)
-		ret = s32_scmi_pinctrl_set_pcf_chunk(pins, no_pins,
-						     configs, no_configs);
+	return 0;
+}
 
-	return ret;
+int s32_scmi_pinctrl_set_periph(const struct s32_pin_config *cfgs,
+				size_t no)
+{
+	struct scp_scmi_seq seq;
+	int ret;
+
+	/* Muxing first, then the pad settings, as done for a single pin */
+	scp_scmi_seq_init(&seq, PSCI);
+
+	ret = add_periph_mux_msgs(&seq, cfgs, no);
+	if (ret)
+		return ret;
+
+	ret = scp_scmi_seq_send(&seq);
+	if (ret)
+		return ret;
+
+	scp_scmi_seq_init(&seq, PSCI);
+
+	ret = add_periph_pcf_msgs(&seq, cfgs, no);
+	if (ret)
+		return ret;
+
+	return scp_scmi_seq_send(&seq);
 }
@@ -7,9 +7,12 @@
 #include <common/debug.h>
 #include <common/fdt_wrappers.h>
 #include <drivers/arm/css/scmi.h>
+#include <drivers/delay_timer.h>
 #include <arm/css/scmi/scmi_logger.h>
 #include <arm/css/scmi/scmi_private.h>
 #include <lib/mmio.h>
+#include <lib/spinlock.h>
+#include <lib/utils.h>
 #include <platform.h>
 #include <libc/errno.h>
 #include <libfdt.h>
@@ -27,9 +30,12 @@
 #include <s32_scmi.h>
 #include <s32cc_dt.h>
 #include <s32cc_scp_scmi.h>
+#include <scmi-msg/base.h>
 
 #define SCMI_GPIO_ACK_IRQ	(0xFFu)
 #define MAX_INTERNAL_MSGS	(1)
+/* Upper bound of the time the SCP may take to answer a request */
+#define S32_SCP_MB_TIMEOUT_US	(100000u)
 
 #define IRQ_CELL_SIZE	(3)
 #define IRQ_NAME_LEN	(16)
@@ -74,6 +80,27 @@ struct scmi_scp_dt_info {
 
 static struct scmi_scp_dt_info scp_dt;
 
+#if (S32_SCMI_ASYNC == 1)
+/*
+ * OSPM request posted to the SCP, whose response is collected from the SCP
+ * notification interrupt. The OSPM channel carries one request at a time and
+ * all its users hold async_lock.
+ */
+struct scp_async_req {
+	uintptr_t scmi_mem;
+	size_t scmi_mem_size;
+	scp_scmi_done_t done;
+	bool pending;
+};
+
+static struct scp_async_req ospm_req;
+static spinlock_t async_lock;
+/* The RX mailbox holds a notification not yet acknowledged by the agent */
+static bool rx_notif_pending;
+/* The SCP raises the OSPM RX doorbell for interrupt-flagged requests */
+static bool scp_async_supported;
+#endif
+
 static const char * const ch_type_str[] = {
 	[PSCI] = "PSCI",
 	[OSPM] = "OSPM",
@@ -153,6 +180,12 @@ static bool is_scmi_logger_enabled(void)
 	return SCMI_LOGGER;
 }
 
+/* Both the logger and the trace need the SCMI metadata regions */
+static bool is_scmi_md_used(void)
+{
+	return SCMI_LOGGER || SCMI_TRACE;
+}
+
 static bool scmi_split_chan_enabled(void)
 {
 	return S32CC_SCMI_SPLIT_CHAN;
@@ -195,7 +228,7 @@ static size_t get_tx_mb_size(uint32_t core)
 
 static uintptr_t get_tx_md_addr(uint32_t core)
 {
-	if (!is_scmi_logger_enabled())
+	if (!is_scmi_md_used())
 		return 0;
 
 	if (!is_mb_valid(core, ARRAY_SIZE(scp_dt.tx_mds)))
@@ -206,7 +239,7 @@ static uintptr_t get_tx_md_addr(uint32_t core)
 
 static size_t get_tx_md_size(uint32_t core)
 {
-	if (!is_scmi_logger_enabled())
+	if (!is_scmi_md_used())
 		return 0;
 
 	if (!is_mb_valid(core, ARRAY_SIZE(scp_dt.tx_mds)))
@@ -252,6 +285,10 @@ void scp_get_rx_md_info(uintptr_t *base, size_t *size)
 	*size = get_rx_md_size();
 }
 
+#if (S32_SCMI_ASYNC == 1)
+static void complete_ospm_req(void);
+#endif
+
 static int scmi_gpio_eirq_ack(void *payload)
 {
 	uintptr_t mb_addr = get_rx_mb_addr();
@@ -260,6 +297,10 @@ static int scmi_gpio_eirq_ack(void *payload)
 	if (is_scmi_logger_enabled())
 		log_scmi_ack(mb, get_rx_md_addr());
 
+#if (S32_SCMI_ASYNC == 1)
+	rx_notif_pending = false;
+#endif
+
 	/* Nothing to perform other than marking the channel as free */
 	SCMI_MARK_CHANNEL_FREE(mb->status);
 
@@ -287,6 +328,14 @@ static uint64_t mscm_interrupt_handler(uint32_t id, uint32_t flags,
 	mailbox_mem_t *mb = (mailbox_mem_t *)mb_addr;
 	uint32_t proto;
 
+#if (S32_SCMI_ASYNC == 1)
+	/* The SCP also raises this interrupt for the posted OSPM requests */
+	complete_ospm_req();
+
+	if (SCMI_IS_CHANNEL_FREE(mb->status) || rx_notif_pending)
+		return 0;
+#endif
+
 	assert(!SCMI_IS_CHANNEL_FREE(mb->status));
 	assert(get_packet_size(mb_addr) <= get_rx_mb_size());
 
@@ -297,6 +346,9 @@ static uint64_t mscm_interrupt_handler(uint32_t id, uint32_t flags,
 
 	if (proto == SCMI_PROTOCOL_ID_GPIO) {
 		process_gpio_notification(mb);
+#if (S32_SCMI_ASYNC == 1)
+		rx_notif_pending = true;
+#endif
 	}
 
 	return 0;
@@ -313,7 +365,7 @@ static int scp_get_mb(void *fdt, int node, const char *name,
 		return -FDT_ERR_NOTFOUND;
 	}
 
-	mb_node = fdt_node_offset_by_phandle(fdt, fdt32_to_cpu(phandles[idx]));
+	mb_node = dt_node_offset_by_phandle(fdt, fdt32_to_cpu(phandles[idx]));
 	if (mb_node < 0) {
 		ERROR("Failed to get SCMI %s mailbox node.\n", name);
 		return -FDT_ERR_NOTFOUND;
@@ -397,7 +449,7 @@ static int scp_get_mboxes_from_fdt(void *fdt, int node, bool init_rx)
 			return ret;
 	}
 
-	if (is_scmi_logger_enabled()) {
+	if (is_scmi_md_used()) {
 		/* Get metadata memory zones */
 		for (i = 0; i < S32_SCP_CH_NUM; i++) {
 			ret = scp_get_tx_md(fdt, node, mboxes, i);
@@ -423,7 +475,7 @@ static int scp_get_irq(void *fdt, int node, const char *prop_name, const char *s
 		return -FDT_ERR_NOTFOUND;
 	}
 
-	irq_node = fdt_node_offset_by_phandle(fdt, fdt32_to_cpu(irqs[IRQ_CELL_SIZE * idx]));
+	irq_node = dt_node_offset_by_phandle(fdt, fdt32_to_cpu(irqs[IRQ_CELL_SIZE * idx]));
 	if (irq_node < 0) {
 		ERROR("Failed to get SCMI %s irq node.\n", string);
 		return -FDT_ERR_NOTFOUND;
@@ -518,7 +570,7 @@ int scp_scmi_dt_init(bool init_rx)
 	if (fdt_get_address(&fdt) == 0)
 		return -EINVAL;
 
-	scmi_node = fdt_node_offset_by_compatible(fdt, -1, "arm,scmi-smc");
+	scmi_node = dt_node_offset_by_compatible(fdt, -1, "arm,scmi-smc");
 	if (scmi_node == -FDT_ERR_NOTFOUND)
 		return -ENODEV;
 
@@ -535,6 +587,42 @@ int scp_scmi_dt_init(bool init_rx)
 	return ret;
 }
 
+#if (S32_SCMI_ASYNC == 1)
+/*
+ * SCP firmware older than S32_SCMI_ASYNC_SCP_VERSION answers the requests
+ * flagged for an interrupt without raising the OSPM RX doorbell, in which case
+ * the OSPM requests keep being forwarded synchronously.
+ */
+static void probe_scp_async(void)
+{
+	struct scp_scmi_seq seq;
+	mailbox_mem_t *rsp;
+	uint32_t version;
+	int ret;
+
+	scp_scmi_seq_init(&seq, OSPM);
+
+	if (!scp_scmi_seq_add(&seq, SCMI_PROTOCOL_ID_BASE,
+			      SCMI_BASE_DISCOVER_IMPLEMENTATION_VERSION, 0))
+		return;
+
+	ret = scp_scmi_seq_send(&seq);
+	if (ret) {
+		WARN("SCMI: failed to get the SCP firmware version (%d)\n", ret);
+		return;
+	}
+
+	rsp = (mailbox_mem_t *)&seq.msgs[0][0];
+	version = rsp->payload[1];
+
+	scp_async_supported = version >= (uint32_t)S32_SCMI_ASYNC_SCP_VERSION;
+	if (!scp_async_supported)
+		NOTICE("SCMI: SCP firmware version 0x%" PRIx32
+		       " does not signal OSPM responses, forwarding them synchronously\n",
+		       version);
+}
+#endif
+
 void scp_scmi_init(bool request_irq)
 {
 	size_t i;
@@ -572,6 +660,8 @@ void scp_scmi_init(bool request_irq)
 	if (is_scmi_logger_enabled())
 		log_scmi_init();
 
+	trace_scmi_init();
+
 	if (!request_irq)
 		return;
 
@@ -587,6 +677,30 @@ void scp_scmi_init(bool request_irq)
 						 scmi_gpio_eirq_ack);
 	if (ret)
 		panic();
+
+#if (S32_SCMI_ASYNC == 1)
+	probe_scp_async();
+#endif
+}
+
+static scmi_channel_t *init_scmi_channel(unsigned int idx)
+{
+	scmi_channel_t *ch = &scmi_channels[idx];
+
+	if (ch->is_initialized)
+		return ch;
+
+	scmi_handles[idx] = scmi_init(ch);
+	if (!scmi_handles[idx]) {
+		if (!scmi_split_chan_enabled())
+			ERROR("Failed to initialize SCMI channel for core %u\n", idx);
+		else
+			ERROR("Failed to initialize SCMI %s channel\n", ch_type_str[idx]);
+
+		return NULL;
+	}
+
+	return ch;
 }
 
 static scmi_channel_t *get_scmi_channel(unsigned int *ch_id, scmi_ch_type_t type)
@@ -610,18 +724,9 @@ static scmi_channel_t *get_scmi_channel(unsigned int *ch_id, scmi_ch_type_t type
 		idx = type;
 	}
 
-	ch = &scmi_channels[idx];
-	if (!ch->is_initialized) {
-		scmi_handles[idx] = scmi_init(ch);
-		if (!scmi_handles[idx]) {
-			if (!split_chan)
-				ERROR("Failed to initialize SCMI channel for core %d\n", idx);
-			else
-				ERROR("Failed to initialize SCMI %s channel\n", ch_type_str[type]);
-
-			return NULL;
-		}
-	}
+	ch = init_scmi_channel(idx);
+	if (!ch)
+		return NULL;
 
 	if (!split_chan && ch_id)
 		*ch_id = idx;
@@ -854,18 +959,156 @@ static int handle_internal_msg(uintptr_t scmi_mem)
 	return SCMI_SUCCESS;
 }
 
-static int forward_to_scp(uintptr_t scmi_mem, size_t scmi_mem_size, scmi_ch_type_t type)
+static bool is_scp_msg_done(scmi_channel_t *ch)
+{
+	mailbox_mem_t *mbx_mem = (mailbox_mem_t *)(ch->info->scmi_mbx_mem);
+
+	return SCMI_IS_CHANNEL_FREE(mbx_mem->status);
+}
+
+/* Wait for the SCP to release the mailbox, i.e. to answer the last request */
+static int wait_scp_msg(scmi_channel_t *ch)
+{
+	uint64_t timeout = timeout_init_us(S32_SCP_MB_TIMEOUT_US);
+
+	while (!is_scp_msg_done(ch)) {
+		if (timeout_elapsed(timeout)) {
+			ERROR("SCMI: SCP mailbox timeout\n");
+			return SCMI_BUSY;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Post a request to the SCP without waiting for the response, the caller
+ * owns the channel.
+ */
+static int post_scp_msg(scmi_channel_t *ch, uintptr_t msg)
+{
+	scmi_channel_plat_info_t *ch_info = ch->info;
+	mailbox_mem_t *mbx_mem = (mailbox_mem_t *)(ch_info->scmi_mbx_mem);
+	int ret;
+
+	ret = wait_scp_msg(ch);
+	if (ret)
+		return ret;
+
+	ret = copy_scmi_msg((uintptr_t)mbx_mem, msg, ch_info->scmi_mbx_size);
+	if (ret)
+		return SCMI_OUT_OF_RANGE;
+
+	/* The copied status is the one of the sender's buffer */
+	if (!SCMI_IS_CHANNEL_FREE(mbx_mem->status))
+		SCMI_MARK_CHANNEL_FREE(mbx_mem->status);
+
+	if (SCMI_LOGGER)
+		log_scmi_req(mbx_mem, ch_info->scmi_md_mem);
+
+	trace_scmi_req(mbx_mem, ch_info->scmi_md_mem);
+
+	SCMI_MARK_CHANNEL_BUSY(mbx_mem->status);
+
+	/* Same ordering requirements as in scmi_send_sync_command() */
+	dmbst();
+
+	ch_info->ring_doorbell(ch_info);
+	dmbsy();
+
+	return 0;
+}
+
+
+static int collect_scp_msg(scmi_channel_t *ch, uintptr_t msg,
+			   size_t msg_size)
+{
+	scmi_channel_plat_info_t *ch_info = ch->info;
+	mailbox_mem_t *mbx_mem = (mailbox_mem_t *)(ch_info->scmi_mbx_mem);
+
+	dmbld();
+
+	if (SCMI_LOGGER)
+		log_scmi_rsp(mbx_mem, ch_info->scmi_md_mem);
+
+	trace_scmi_rsp(mbx_mem, ch_info->scmi_md_mem);
+
+	if (copy_scmi_msg(msg, (uintptr_t)mbx_mem, msg_size))
+		return SCMI_OUT_OF_RANGE;
+
+	return SCMI_SUCCESS;
+}
+
+#if (S32_SCMI_ASYNC == 1)
+/* Called with async_lock held */
+static void complete_ospm_req_locked(scmi_channel_t *ch)
+{
+	mailbox_mem_t *agent_mem = (mailbox_mem_t *)ospm_req.scmi_mem;
+
+	if (!ospm_req.pending || !is_scp_msg_done(ch))
+		return;
+
+	if (collect_scp_msg(ch, ospm_req.scmi_mem, ospm_req.scmi_mem_size)) {
+		agent_mem->payload[0] = (uint32_t)SCMI_OUT_OF_RANGE;
+		agent_mem->len = 8U;
+		SCMI_MARK_CHANNEL_FREE(agent_mem->status);
+	}
+
+	ospm_req.pending = false;
+	ospm_req.done(ospm_req.scmi_mem);
+}
+
+static void complete_ospm_req(void)
+{
+	scmi_channel_t *ch = get_scmi_channel(NULL, OSPM);
+
+	if (!ch)
+		return;
+
+	spin_lock(&async_lock);
+	complete_ospm_req_locked(ch);
+	spin_unlock(&async_lock);
+}
+
+/*
+ * Returns with async_lock held and no request in flight on the OSPM
+ * channel. A response the interrupt handler didn't collect yet is
+ * collected here.
+ */
+static int get_ospm_channel(scmi_channel_t *ch)
+{
+	uint64_t timeout = timeout_init_us(S32_SCP_MB_TIMEOUT_US);
+
+	while (true) {
+		spin_lock(&async_lock);
+
+		complete_ospm_req_locked(ch);
+		if (!ospm_req.pending)
+			return 0;
+
+		spin_unlock(&async_lock);
+
+		if (timeout_elapsed(timeout)) {
+			ERROR("SCMI: posted OSPM request timeout\n");
+			return SCMI_BUSY;
+		}
+	}
+}
+
+static void put_ospm_channel(void)
+{
+	spin_unlock(&async_lock);
+}
+#endif
+
+static int send_sync_to_scp(scmi_channel_t *ch, uintptr_t scmi_mem,
+			    size_t scmi_mem_size)
 {
-	unsigned int ch_id;
 	scmi_channel_plat_info_t *ch_info;
-	scmi_channel_t *ch = get_scmi_channel(&ch_id, type);
 	mailbox_mem_t *mbx_mem;
 	size_t packet_size;
 	int ret;
 
-	if (!ch)
-		return SCMI_GENERIC_ERROR;
-
 	ch_info = ch->info;
 	mbx_mem = (mailbox_mem_t *)(ch_info->scmi_mbx_mem);
 
@@ -908,7 +1151,32 @@ static int forward_to_scp(uintptr_t scmi_mem, size_t scmi_mem_size, scmi_ch_type
 	return SCMI_SUCCESS;
 }
 
-int send_scmi_to_scp(uintptr_t scmi_mem, size_t scmi_mem_size, scmi_ch_type_t type)
+static int forward_to_scp(uintptr_t scmi_mem, size_t scmi_mem_size, scmi_ch_type_t type)
+{
+	scmi_channel_t *ch = get_scmi_channel(NULL, type);
+
+	if (!ch)
+		return SCMI_GENERIC_ERROR;
+
+#if (S32_SCMI_ASYNC == 1)
+	if (type == OSPM) {
+		int ret;
+
+		ret = get_ospm_channel(ch);
+		if (ret)
+			return ret;
+
+		ret = send_sync_to_scp(ch, scmi_mem, scmi_mem_size);
+		put_ospm_channel();
+
+		return ret;
+	}
+#endif
+
+	return send_sync_to_scp(ch, scmi_mem, scmi_mem_size);
+}
+
+static int check_scmi_to_scp(uintptr_t scmi_mem, scmi_ch_type_t type)
 {
 	unsigned int ch_idx;
 
@@ -924,8 +1192,190 @@ int send_scmi_to_scp(uintptr_t scmi_mem, size_t scmi_mem_size, scmi_ch_type_t ty
 	if (get_packet_size(scmi_mem) > get_tx_mb_size(ch_idx))
 		return SCMI_OUT_OF_RANGE;
 
+	return SCMI_SUCCESS;
+}
+
+int send_scmi_to_scp(uintptr_t scmi_mem, size_t scmi_mem_size, scmi_ch_type_t type)
+{
+	int ret;
+
+	ret = check_scmi_to_scp(scmi_mem, type);
+	if (ret)
+		return ret;
+
 	if (is_internal_msg((mailbox_mem_t *)scmi_mem))
 		return handle_internal_msg(scmi_mem);
 
 	return forward_to_scp(scmi_mem, scmi_mem_size, type);
 }
+
+#if (S32_SCMI_ASYNC == 1)
+int post_scmi_to_scp(uintptr_t scmi_mem, size_t scmi_mem_size,
+		     scp_scmi_done_t done)
+{
+	scmi_channel_t *ch;
+	int ret;
+
+	ret = check_scmi_to_scp(scmi_mem, OSPM);
+	if (ret)
+		return ret;
+
+	/* Handled in place, there is nothing to wait for */
+	if (is_internal_msg((mailbox_mem_t *)scmi_mem)) {
+		ret = handle_internal_msg(scmi_mem);
+		if (ret == SCMI_SUCCESS)
+			done(scmi_mem);
+
+		return ret;
+	}
+
+	/* Nothing would tell the agent that the response is there */
+	if (!scp_async_supported) {
+		ret = forward_to_scp(scmi_mem, scmi_mem_size, OSPM);
+		if (ret == SCMI_SUCCESS)
+			done(scmi_mem);
+
+		return ret;
+	}
+
+	ch = get_scmi_channel(NULL, OSPM);
+	if (!ch)
+		return SCMI_GENERIC_ERROR;
+
+	validate_scmi_channel(ch);
+
+	ret = get_ospm_channel(ch);
+	if (ret)
+		return ret;
+
+	/* The agent's flags ask the SCP to signal the response */
+	ret = post_scp_msg(ch, scmi_mem);
+	if (!ret) {
+		ospm_req = (struct scp_async_req) {
+			.scmi_mem = scmi_mem,
+			.scmi_mem_size = scmi_mem_size,
+			.done = done,
+			.pending = true,
+		};
+	}
+
+	put_ospm_channel();
+
+	return ret;
+}
+#endif
+
+void scp_scmi_seq_init(struct scp_scmi_seq *seq, scmi_ch_type_t type)
+{
+	seq->n_msgs = 0u;
+	seq->type = type;
+}
+
+void *scp_scmi_seq_add(struct scp_scmi_seq *seq, uint32_t proto,
+		       uint32_t msg_id, size_t payload_size)
+{
+	mailbox_mem_t *mbx_mem;
+
+	if (seq->n_msgs >= ARRAY_SIZE(seq->msgs))
+		return NULL;
+
+	if (payload_size > sizeof(seq->msgs[0]) - sizeof(*mbx_mem))
+		return NULL;
+
+	/* Internal messages are never forwarded to the SCP */
+	if (get_internal_msg(proto, msg_id))
+		return NULL;
+
+	mbx_mem = (mailbox_mem_t *)&seq->msgs[seq->n_msgs][0];
+	zeromem(mbx_mem, sizeof(seq->msgs[0]));
+	mbx_mem->flags = SCMI_FLAG_RESP_POLL;
+	mbx_mem->len = 4U + payload_size;
+	mbx_mem->msg_header = SCMI_MSG_CREATE(proto, msg_id, seq->n_msgs);
+
+	if (!is_proto_allowed(mbx_mem))
+		return NULL;
+
+	seq->n_msgs++;
+
+	return &mbx_mem->payload[0];
+}
+
+static int check_seq_responses(struct scp_scmi_seq *seq,
+			       unsigned int n_msgs)
+{
+	mailbox_mem_t *mbx_mem;
+	unsigned int i;
+	int32_t status;
+	int ret = 0;
+
+	for (i = 0u; i < n_msgs; i++) {
+		mbx_mem = (mailbox_mem_t *)&seq->msgs[i][0];
+		if (SCMI_MSG_GET_TOKEN(mbx_mem->msg_header) != i) {
+			ERROR("SCMI response token mismatch: %u instead of %u\n",
+			      (unsigned int)SCMI_MSG_GET_TOKEN(mbx_mem->msg_header),
+			      i);
+			return SCMI_PROTOCOL_ERROR;
+		}
+
+		status = (int32_t)mbx_mem->payload[0];
+		if (status == SCMI_E_SUCCESS)
+			continue;
+
+		ERROR("SCMI request 0x%x/0x%x failed: %d\n",
+		      SCMI_MSG_GET_PROTO(mbx_mem->msg_header),
+		      SCMI_MSG_GET_MSG_ID(mbx_mem->msg_header), status);
+		if (!ret)
+			ret = status;
+	}
+
+	return ret;
+}
+
+int scp_scmi_seq_send(struct scp_scmi_seq *seq)
+{
+	uintptr_t msg;
+	scmi_channel_t *ch;
+	unsigned int i;
+	int ret = 0;
+
+	if (!seq->n_msgs)
+		return 0;
+
+	if (scmi_split_chan_enabled() && !is_ch_type_valid(seq->type))
+		return SCMI_DENIED;
+
+	/*
+	 * Only the caller's own TX mailbox carries the sequence. Without split
+	 * channels, the mailboxes of the other cores carry their PSCI
+	 * requests, which must not wait behind it.
+	 */
+	ch = get_scmi_channel(NULL, seq->type);
+	if (!ch)
+		return SCMI_GENERIC_ERROR;
+
+	validate_scmi_channel(ch);
+	scmi_get_channel(ch);
+
+	for (i = 0u; i < seq->n_msgs; i++) {
+		msg = (uintptr_t)&seq->msgs[i][0];
+
+		ret = post_scp_msg(ch, msg);
+		if (ret)
+			break;
+
+		ret = wait_scp_msg(ch);
+		if (ret)
+			break;
+
+		ret = collect_scp_msg(ch, msg, sizeof(seq->msgs[0]));
+		if (ret)
+			break;
+	}
+
+	scmi_put_channel(ch);
+
+	if (ret)
+		return ret;
+
+	return check_seq_responses(seq, seq->n_msgs);
+}
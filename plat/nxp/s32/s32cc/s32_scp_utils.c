@@ -16,6 +16,7 @@
 #include <arm/css/scmi/scmi_private.h>
 #include <clk/s32gen1_clk_funcs.h>
 #include <common/debug.h>
+#include <errno.h>
 #include <drivers/scmi.h>
 #include <scmi-msg/clock.h>
 #include <scmi-msg/nvmem.h>
@@ -25,26 +26,17 @@
 #include <dt-bindings/nvmem/s32cc-scmi-nvmem.h>
 #include <dt-bindings/reset/s32cc-scmi-reset.h>
 
-static int scp_scmi_reset_set_state(uint32_t domain_id, bool assert)
+static int scp_seq_reset_set_state(struct scp_scmi_seq *seq,
+				   uint32_t domain_id, bool assert)
 {
-	int ret;
-	unsigned int token = 0;
 	struct scmi_reset_domain_request_a2p *payload_args;
-	struct scmi_reset_domain_request_p2a *payload_resp;
-	mailbox_mem_t *mbx_mem;
-	uint8_t buffer[S32_SCP_BUF_SIZE];
 
-	mbx_mem = (mailbox_mem_t *)buffer;
-	mbx_mem->res_a = 0U;
-	mbx_mem->status = 0U;
-	mbx_mem->res_b = 0UL;
-	mbx_mem->flags = SCMI_FLAG_RESP_POLL;
-	mbx_mem->len = 4U + sizeof(*payload_args);
-	mbx_mem->msg_header = SCMI_MSG_CREATE(SCMI_PROTOCOL_ID_RESET_DOMAIN,
-					      SCMI_RESET_DOMAIN_REQUEST,
-					      token);
+	payload_args = scp_scmi_seq_add(seq, SCMI_PROTOCOL_ID_RESET_DOMAIN,
+					SCMI_RESET_DOMAIN_REQUEST,
+					sizeof(*payload_args));
+	if (!payload_args)
+		return -ENOMEM;
 
-	payload_args = (struct scmi_reset_domain_request_a2p *)mbx_mem->payload;
 	payload_args->domain_id = domain_id;
 	payload_args->reset_state = 0;
 
@@ -53,41 +45,20 @@ static int scp_scmi_reset_set_state(uint32_t domain_id, bool assert)
 	else
 		payload_args->flags = 0U;
 
-	ret = send_scmi_to_scp((uintptr_t)mbx_mem, sizeof(buffer), PSCI);
-	if (ret)
-		return ret;
-
-	/* The payload contains the response filled by send_scmi_to_scp() */
-	payload_resp = (struct scmi_reset_domain_request_p2a *)mbx_mem->payload;
-	ret = payload_resp->status;
-	if (ret != SCMI_E_SUCCESS) {
-		ERROR("Failed to reset domain %u\n", domain_id);
-		return ret;
-	}
-
 	return 0;
 }
 
-static int scp_scmi_clk_set_config(unsigned int clock_index, bool enable)
+static int scp_seq_clk_set_config(struct scp_scmi_seq *seq,
+				  unsigned int clock_index, bool enable)
 {
-	int ret;
-	unsigned int token = 0;
 	struct scmi_clock_config_set_a2p *payload_args;
-	struct scmi_clock_config_set_p2a *payload_resp;
-	mailbox_mem_t *mbx_mem;
-	uint8_t buffer[S32_SCP_BUF_SIZE];
 
-	mbx_mem = (mailbox_mem_t *)buffer;
-	mbx_mem->res_a = 0U;
-	mbx_mem->status = 0U;
-	mbx_mem->res_b = 0UL;
-	mbx_mem->flags = SCMI_FLAG_RESP_POLL;
-	mbx_mem->len = 4U + sizeof(struct scmi_clock_config_set_a2p);
-	mbx_mem->msg_header = SCMI_MSG_CREATE(SCMI_PROTOCOL_ID_CLOCK,
-					      SCMI_CLOCK_CONFIG_SET,
-					      token);
+	payload_args = scp_scmi_seq_add(seq, SCMI_PROTOCOL_ID_CLOCK,
+					SCMI_CLOCK_CONFIG_SET,
+					sizeof(*payload_args));
+	if (!payload_args)
+		return -ENOMEM;
 
-	payload_args = (struct scmi_clock_config_set_a2p *)mbx_mem->payload;
 	payload_args->clock_id = clock_index;
 
 	if (enable)
@@ -95,25 +66,41 @@ static int scp_scmi_clk_set_config(unsigned int clock_index, bool enable)
 	else
 		payload_args->attributes = 0u;
 
-	ret = send_scmi_to_scp((uintptr_t)mbx_mem, sizeof(buffer), PSCI);
-	if (ret)
-		return ret;
+	return 0;
+}
 
-	/* The payload contains the response filled by send_scmi_to_scp() */
-	payload_resp = (struct scmi_clock_config_set_p2a *)mbx_mem->payload;
-	ret = payload_resp->status;
-	if (ret != SCMI_E_SUCCESS) {
-		ERROR("Failed to %s clock %u\n", enable ? "enable" : "disable",
-		      clock_index);
-		return ret;
+static int scp_seq_clks_set_config(struct scp_scmi_seq *seq,
+				   const unsigned int *clks, size_t n_clks,
+				   bool enable)
+{
+	size_t i;
+	int ret;
+
+	for (i = 0; i < n_clks; i++) {
+		ret = scp_seq_clk_set_config(seq, clks[i], enable);
+		if (ret)
+			return ret;
 	}
 
 	return 0;
 }
 
-static int scp_scmi_clk_set_config_enable(unsigned int clock_index)
+static int scp_scmi_reset_set_state(uint32_t domain_id, bool assert)
 {
-	return scp_scmi_clk_set_config(clock_index, true);
+	struct scp_scmi_seq seq;
+	int ret;
+
+	scp_scmi_seq_init(&seq, PSCI);
+
+	ret = scp_seq_reset_set_state(&seq, domain_id, assert);
+	if (ret)
+		return ret;
+
+	ret = scp_scmi_seq_send(&seq);
+	if (ret)
+		ERROR("Failed to reset domain %u\n", domain_id);
+
+	return ret;
 }
 
 static int scp_scmi_clk_set_rate(unsigned int clock_index, unsigned long rate)
@@ -270,102 +257,110 @@ int scp_a53_clock_setup(void)
 	return scp_scmi_clk_set_rate(S32CC_SCMI_CLK_A53, freq * MHZ);
 }
 
-static int scp_enable_lin_clock(void)
-{
-	int ret;
-
-	ret = scp_scmi_clk_set_config_enable(S32CC_SCMI_CLK_LINFLEX_XBAR);
-	if (ret)
-		return ret;
-
-	return scp_scmi_clk_set_config_enable(S32CC_SCMI_CLK_LINFLEX_LIN);
-}
+static const unsigned int lin_clks[] = {
+	S32CC_SCMI_CLK_LINFLEX_XBAR,
+	S32CC_SCMI_CLK_LINFLEX_LIN,
+};
+
+static const unsigned int sdhc_clks[] = {
+	S32CC_SCMI_CLK_USDHC_CORE,
+	S32CC_SCMI_CLK_USDHC_AHB,
+	S32CC_SCMI_CLK_USDHC_MODULE,
+	S32CC_SCMI_CLK_USDHC_MOD32K,
+};
+
+static const unsigned int qspi_clks[] = {
+	S32CC_SCMI_CLK_QUADSPI_FLASH1X,
+	S32CC_SCMI_CLK_QUADSPI_FLASH2X,
+	S32CC_SCMI_CLK_QUADSPI_REG,
+	S32CC_SCMI_CLK_QUADSPI_AHB,
+};
+
+static const unsigned int ddr_clks[] = {
+	S32CC_SCMI_CLK_DDR_PLL_REF,
+	S32CC_SCMI_CLK_DDR_AXI,
+	S32CC_SCMI_CLK_DDR_REG,
+};
 
-static int scp_enable_sdhc_clock(void)
+static int scp_set_ddr_clock_state(bool enable)
 {
+	struct scp_scmi_seq seq;
 	int ret;
 
-	ret = scp_scmi_clk_set_config_enable(S32CC_SCMI_CLK_USDHC_CORE);
-	if (ret)
-		return ret;
+	scp_scmi_seq_init(&seq, PSCI);
 
-	ret = scp_scmi_clk_set_config_enable(S32CC_SCMI_CLK_USDHC_AHB);
+	ret = scp_seq_clks_set_config(&seq, ddr_clks, ARRAY_SIZE(ddr_clks),
+				      enable);
 	if (ret)
 		return ret;
 
-	ret = scp_scmi_clk_set_config_enable(S32CC_SCMI_CLK_USDHC_MODULE);
+	ret = scp_scmi_seq_send(&seq);
 	if (ret)
-		return ret;
+		ERROR("Failed to %s DDR clocks\n", enable ? "enable" : "disable");
 
-	return scp_scmi_clk_set_config_enable(S32CC_SCMI_CLK_USDHC_MOD32K);
+	return ret;
 }
 
-static int scp_enable_qspi_clock(void)
+static int scp_enable_ddr_clock(void)
 {
-	int ret;
-
-	ret = scp_scmi_clk_set_config_enable(S32CC_SCMI_CLK_QUADSPI_FLASH1X);
-	if (ret)
-		return ret;
-
-	ret = scp_scmi_clk_set_config_enable(S32CC_SCMI_CLK_QUADSPI_FLASH2X);
-	if (ret)
-		return ret;
-
-	ret = scp_scmi_clk_set_config_enable(S32CC_SCMI_CLK_QUADSPI_REG);
-	if (ret)
-		return ret;
+	return scp_set_ddr_clock_state(true);
+}
 
-	return scp_scmi_clk_set_config_enable(S32CC_SCMI_CLK_QUADSPI_AHB);
+static int scp_disable_ddr_clock(void)
+{
+	return scp_set_ddr_clock_state(false);
 }
 
-static int scp_set_ddr_clock_state(bool enable)
+int scp_periph_clock_init(void)
 {
+	struct scp_scmi_seq seq;
 	int ret;
 
-	ret = scp_scmi_clk_set_config(S32CC_SCMI_CLK_DDR_PLL_REF, enable);
+	/* The clocks are independent, enable them in a single exchange */
+	scp_scmi_seq_init(&seq, PSCI);
+
+	ret = scp_seq_clks_set_config(&seq, lin_clks, ARRAY_SIZE(lin_clks),
+				      true);
 	if (ret)
 		return ret;
 
-	ret = scp_scmi_clk_set_config(S32CC_SCMI_CLK_DDR_AXI, enable);
+	if (fip_location_mmc)
+		ret = scp_seq_clks_set_config(&seq, sdhc_clks,
+					      ARRAY_SIZE(sdhc_clks), true);
+	else if (fip_location_qspi)
+		ret = scp_seq_clks_set_config(&seq, qspi_clks,
+					      ARRAY_SIZE(qspi_clks), true);
 	if (ret)
 		return ret;
 
-	return scp_scmi_clk_set_config(S32CC_SCMI_CLK_DDR_REG, enable);
-}
+	ret = scp_seq_clks_set_config(&seq, ddr_clks, ARRAY_SIZE(ddr_clks),
+				      true);
+	if (ret)
+		return ret;
 
-static int scp_enable_ddr_clock(void)
-{
-	return scp_set_ddr_clock_state(true);
-}
+	ret = scp_scmi_seq_send(&seq);
+	if (ret)
+		ERROR("Failed to enable BL2 peripheral clocks\n");
 
-static int scp_disable_ddr_clock(void)
-{
-	return scp_set_ddr_clock_state(false);
+	return ret;
 }
 
-int scp_periph_clock_init(void)
+int scp_reset_ddr_periph(void)
 {
 	int ret;
 
-	ret = scp_enable_lin_clock();
+	ret = scp_disable_ddr_clock();
 	if (ret)
 		return ret;
 
-	if (fip_location_mmc) {
-		ret = scp_enable_sdhc_clock();
-		if (ret)
-			return ret;
-	} else if (fip_location_qspi) {
-		ret = scp_enable_qspi_clock();
-		if (ret)
-			return ret;
-	}
+	ret = scp_scmi_reset_set_state(S32CC_SCMI_RST_DDR, false);
+	if (ret)
+		return ret;
 
 	return scp_enable_ddr_clock();
 }
 
-int scp_reset_ddr_periph(void)
+int scp_assert_ddr_reset(void)
 {
 	int ret;
 
@@ -373,7 +368,7 @@ int scp_reset_ddr_periph(void)
 	if (ret)
 		return ret;
 
-	ret = scp_scmi_reset_set_state(S32CC_SCMI_RST_DDR, false);
+	ret = scp_scmi_reset_set_state(S32CC_SCMI_RST_DDR, true);
 	if (ret)
 		return ret;
 
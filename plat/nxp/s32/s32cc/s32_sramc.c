@@ -59,8 +59,8 @@ static bool in_overlap(uintptr_t s1, uintptr_t e1, uintptr_t s2, uintptr_t e2)
 	return MAX(s1, s2) <= MIN(e1, e2);
 }
 
-static void clear_sramc_range(uintptr_t base, uint32_t start_offset,
-			      uint32_t end_offset)
+static void start_sramc_init(uintptr_t base, uint32_t start_offset,
+			     uint32_t end_offset)
 {
 	/* Disable the controller */
 	mmio_write_32(base + SRAMC_PRAMCR_OFFSET, 0x0);
@@ -71,14 +71,17 @@ static void clear_sramc_range(uintptr_t base, uint32_t start_offset,
 
 	/* Initialization request */
 	mmio_write_32(base + SRAMC_PRAMCR_OFFSET, SRAMC_PRAMCR_INITREQ);
+}
 
+static void wait_sramc_init(uintptr_t base)
+{
 	while (!(mmio_read_32(base + SRAMC_PRAMSR_OFFSET) & SRAMC_PRAMSR_IDONE))
 		;
 	mmio_write_32(base + SRAMC_PRAMSR_OFFSET, SRAMC_PRAMSR_IDONE);
 }
 
-static void clear_sram_range(struct sram_ctrl *c, uintptr_t start_addr,
-			      uintptr_t end_addr)
+static void start_sram_range_clear(struct sram_ctrl *c, uintptr_t start_addr,
+				   uintptr_t end_addr)
 {
 	uint32_t start_offset, end_offset;
 	uintptr_t base = c->base_addr;
@@ -93,11 +96,14 @@ static void clear_sram_range(struct sram_ctrl *c, uintptr_t start_addr,
 				    &c->mmap_added))
 		panic();
 
-	clear_sramc_range(base, start_offset, end_offset);
+	start_sramc_init(base, start_offset, end_offset);
+	c->init_pending = true;
 }
 
 #ifdef SSRAMC_BASE_ADDR
-void s32_ssram_clear(void)
+static bool ssram_init_pending;
+
+void s32_ssram_clear_start(void)
 {
 	static bool mmap_added;
 
@@ -105,11 +111,32 @@ void s32_ssram_clear(void)
 				    &mmap_added))
 		panic();
 
-	clear_sramc_range(SSRAMC_BASE_ADDR, 0x0, SSRAM_MAX_ADDR);
+	start_sramc_init(SSRAMC_BASE_ADDR, 0x0, SSRAM_MAX_ADDR);
+	ssram_init_pending = true;
+}
+
+void s32_ssram_clear_wait(void)
+{
+	if (!ssram_init_pending)
+		return;
+
+	wait_sramc_init(SSRAMC_BASE_ADDR);
+	ssram_init_pending = false;
+}
+
+void s32_ssram_clear(void)
+{
+	s32_ssram_clear_start();
+	s32_ssram_clear_wait();
 }
 #endif
 
-int s32_sram_clear(uintptr_t start, uintptr_t end)
+/*
+ * Request the initialization of all SRAM controllers covering the
+ * [start, end) range without waiting for it. The controllers work in
+ * parallel; s32_sram_clear_wait() must be called before the range is used.
+ */
+int s32_sram_clear_start(uintptr_t start, uintptr_t end)
 {
 	struct sram_ctrl *ctrls;
 	struct sram_ctrl *c;
@@ -142,8 +169,40 @@ int s32_sram_clear(uintptr_t start, uintptr_t end)
 		s = MAX(start, (uintptr_t)c->min_sram_addr);
 		e = MIN(end, (uintptr_t)c->max_sram_addr);
 
-		clear_sram_range(c, s, e);
+		start_sram_range_clear(c, s, e);
+	}
+
+	return 0;
+}
+
+void s32_sram_clear_wait(void)
+{
+	struct sram_ctrl *ctrls;
+	struct sram_ctrl *c;
+	size_t i, n_ctrls;
+
+	s32_get_sramc(&ctrls, &n_ctrls);
+
+	for (i = 0u; i < n_ctrls; i++) {
+		c = &ctrls[i];
+
+		if (!c->init_pending)
+			continue;
+
+		wait_sramc_init(c->base_addr);
+		c->init_pending = false;
 	}
+}
+
+int s32_sram_clear(uintptr_t start, uintptr_t end)
+{
+	int ret;
+
+	ret = s32_sram_clear_start(start, end);
+	if (ret)
+		return ret;
+
+	s32_sram_clear_wait();
 
 	return 0;
 }
@@ -12,7 +12,9 @@
 #include <drivers/io/io_fip.h>
 #include <drivers/io/io_block.h>
 #include <drivers/nxp/s32/mmc/s32_mmc.h>
+#include <drivers/nxp/s32/qspi/s32_qspi.h>
 #include <drivers/partition/partition.h>
+#include <arch_helpers.h>
 #include <assert.h>
 #include <tools_share/firmware_image_package.h>
 #include <lib/mmio.h>
@@ -24,13 +26,11 @@
 #include "s32cc_storage.h"
 #include "s32cc_bl_common.h"
 
-#define QUADSPI_MCR			0x00000000u
-#define QUADSPI_MCR_SWRSTHD_MASK	BIT(1)
-#define QUADSPI_MCR_SWRSTSD_MASK	BIT(0)
-#define QUADSPI_MCR_MDIS_MASK		BIT(14)
-
 static const io_dev_connector_t *s32_mmc_io_conn;
 static const io_dev_connector_t *s32_memmap_io_conn;
+#if (S32_QSPI_IP_READ == 1)
+static const io_dev_connector_t *s32_qspi_io_conn;
+#endif
 static const io_dev_connector_t *fip_dev_con;
 static uintptr_t boot_dev_handle;
 static uintptr_t fip_dev_handle;
@@ -39,6 +39,28 @@ static io_block_spec_t fip_memmap_spec;
 
 static io_block_spec_t fip_mmc_spec;
 
+#if (S32_QSPI_IP_READ == 1)
+#define QSPI_BLOCK_BUF_SIZE	(8U * S32_QSPI_BLOCK_SIZE)
+
+static uint8_t qspi_block_buf[QSPI_BLOCK_BUF_SIZE] __aligned(S32_QSPI_BLOCK_SIZE);
+
+static io_block_spec_t fip_qspi_spec;
+
+/* Images are streamed through IP command reads, straight to their destination */
+static const io_block_dev_spec_t qspi_dev_spec = {
+	.buffer	= {
+		.offset = (uintptr_t)qspi_block_buf,
+		.length = QSPI_BLOCK_BUF_SIZE
+	},
+	.ops = {
+		.read = s32_qspi_read,
+	},
+	.block_size = S32_QSPI_BLOCK_SIZE,
+	.direct_align = sizeof(uint32_t),
+	.direct_max = SIZE_MAX & ~((size_t)S32_QSPI_BLOCK_SIZE - 1U),
+};
+#endif
+
 static const io_block_dev_spec_t mmc_dev_spec = {
 	.buffer	= {
 		.offset = S32_MMC_BUFFER_BASE,
@@ -48,6 +70,13 @@ static const io_block_dev_spec_t mmc_dev_spec = {
 		.read = mmc_read_blocks,
 	},
 	.block_size = MMC_BLOCK_SIZE,
+	/*
+	 * Block aligned image data is DMA-ed straight to its load address. The
+	 * buffer is flushed and invalidated around the transfer, so it must
+	 * not share a cache line with anything else.
+	 */
+	.direct_align = CACHE_WRITEBACK_GRANULE,
+	.direct_max = S32_MMC_MAX_XFER_SIZE,
 };
 
 static io_block_spec_t mbr_spec = {
@@ -203,18 +232,12 @@ static unsigned long get_fip_offset(void)
 	if (fip_location_mmc)
 		return fip_mmc_spec.offset;
 
-	return fip_memmap_spec.offset;
-}
-
-static void invalidate_qspi_ahb(void)
-{
-	uint32_t reset_mask = QUADSPI_MCR_SWRSTHD_MASK | QUADSPI_MCR_SWRSTSD_MASK;
+#if (S32_QSPI_IP_READ == 1)
+	if (fip_location_qspi)
+		return fip_qspi_spec.offset;
+#endif
 
-	mmio_clrbits_32(S32_QSPI_BASE + QUADSPI_MCR, QUADSPI_MCR_MDIS_MASK);
-	mmio_setbits_32(S32_QSPI_BASE + QUADSPI_MCR, reset_mask);
-	mmio_setbits_32(S32_QSPI_BASE + QUADSPI_MCR, QUADSPI_MCR_MDIS_MASK);
-	mmio_clrbits_32(S32_QSPI_BASE + QUADSPI_MCR, reset_mask);
-	mmio_clrbits_32(S32_QSPI_BASE + QUADSPI_MCR, QUADSPI_MCR_MDIS_MASK);
+	return fip_memmap_spec.offset;
 }
 
 int plat_get_image_source(unsigned int image_id, uintptr_t *dev_handle,
@@ -236,16 +259,32 @@ int plat_get_image_source(unsigned int image_id, uintptr_t *dev_handle,
 	return 0;
 }
 
-static void plat_s32_mmc_setup(void)
+static int s32_mmc_dev_register(void)
 {
+	static bool registered;
 	int result;
-	partition_entry_t fip_part;
+
+	if (registered)
+		return 0;
 
 	result = s32_plat_config_sdhc_pinctrl();
 	if (result)
-		panic();
+		return result;
 
 	result = s32_mmc_register();
+	if (result)
+		return result;
+
+	registered = true;
+	return 0;
+}
+
+static void plat_s32_mmc_setup(void)
+{
+	int result;
+	partition_entry_t fip_part;
+
+	result = s32_mmc_dev_register();
 	if (result)
 		panic();
 
@@ -314,14 +353,14 @@ static int get_qspi_fip_part(uintptr_t *base, size_t *size)
 		return -FDT_ERR_BADSTATE;
 	}
 
-	offs = fdt_node_offset_by_compatible(s32_fdt, -1, "nxp,s32cc-qspi");
+	offs = dt_node_offset_by_compatible(s32_fdt, -1, "nxp,s32cc-qspi");
 	if (offs < 0)
 		return offs;
 
 	if (fdt_get_status(offs) != DT_ENABLED)
 		return -FDT_ERR_BADSTATE;
 
-	offs = fdt_node_offset_by_compatible(s32_fdt, offs, "fixed-partitions");
+	offs = dt_node_offset_by_compatible(s32_fdt, offs, "fixed-partitions");
 	if (offs < 0)
 		return offs;
 
@@ -352,6 +391,23 @@ static void plat_s32_qspi_setup(void)
 	if (result || !fip_base || !fip_size)
 		panic();
 
+	result = s32_qspi_init();
+	if (result) {
+		ERROR("QSPI setup: error %d\n", result);
+		panic();
+	}
+
+#if (S32_QSPI_IP_READ == 1)
+	result = register_io_dev_block(&s32_qspi_io_conn);
+	assert(result == 0);
+
+	result = io_dev_open(s32_qspi_io_conn, (uintptr_t)&qspi_dev_spec,
+			     &boot_dev_handle);
+	assert(result == 0);
+
+	fip_qspi_spec.offset = fip_base;
+	fip_qspi_spec.length = fip_size;
+#else
 	result = register_io_dev_memmap(&s32_memmap_io_conn);
 	assert(result == 0);
 
@@ -359,8 +415,6 @@ static void plat_s32_qspi_setup(void)
 			     &boot_dev_handle);
 	assert(result == 0);
 
-	invalidate_qspi_ahb();
-
 	result = mmap_add_dynamic_region(S32_FLASH_BASE + fip_base,
 					 S32_FLASH_BASE + fip_base,
 					 MMU_ROUND_UP_TO_PAGE(fip_size),
@@ -372,8 +426,48 @@ static void plat_s32_qspi_setup(void)
 
 	fip_memmap_spec.offset = S32_FLASH_BASE + fip_base;
 	fip_memmap_spec.length = fip_size;
+#endif
 }
 
+#if (S32_QSPI_BENCH == 1)
+#define QSPI_BENCH_BUF_SIZE	(8 * 1024)
+#define QSPI_BENCH_ROUNDS	(32)
+
+static uint8_t qspi_bench_buf[QSPI_BENCH_BUF_SIZE] __aligned(CACHE_WRITEBACK_GRANULE);
+
+/* Read throughput of the FIP partition, through the same path as the images */
+static void s32_qspi_bench(uintptr_t spec)
+{
+	uint64_t start, ticks;
+	uintptr_t handle = 0;
+	size_t total = 0, len;
+	unsigned int i;
+	int ret;
+
+	ret = io_open(boot_dev_handle, spec, &handle);
+	if (ret)
+		return;
+
+	start = read_cntpct_el0();
+	for (i = 0; i < QSPI_BENCH_ROUNDS; i++) {
+		ret = io_read(handle, (uintptr_t)qspi_bench_buf,
+			      sizeof(qspi_bench_buf), &len);
+		if (ret || len != sizeof(qspi_bench_buf))
+			break;
+		total += len;
+	}
+	ticks = read_cntpct_el0() - start;
+	(void)io_close(handle);
+
+	if (!ticks || !total)
+		return;
+
+	NOTICE("QSPI: FIP read (%s) %zu KiB: %llu KiB/s\n",
+	       S32_QSPI_IP_READ ? "IP commands" : "AHB", total / 1024U,
+	       s32_ticks_to_kib_s(total, ticks));
+}
+#endif
+
 void s32_io_setup(void)
 {
 	int result __maybe_unused;
@@ -385,7 +479,14 @@ void s32_io_setup(void)
 
 	if (fip_location_qspi) {
 		plat_s32_qspi_setup();
+#if (S32_QSPI_IP_READ == 1)
+		s32_policies[FIP_IMAGE_ID].image_spec = (uintptr_t)&fip_qspi_spec;
+#else
 		s32_policies[FIP_IMAGE_ID].image_spec = (uintptr_t)&fip_memmap_spec;
+#endif
+#if (S32_QSPI_BENCH == 1)
+		s32_qspi_bench(s32_policies[FIP_IMAGE_ID].image_spec);
+#endif
 	}
 
 	if (fip_location_mmc) {
@@ -401,3 +502,42 @@ void s32_io_setup(void)
 
 	INFO("BL2: FIP offset = 0x%lx\n", get_fip_offset());
 }
+
+static int check_raw_access(size_t offset, size_t size)
+{
+	if (!fip_location_mmc)
+		return -ENOTSUP;
+
+	if ((offset % MMC_BLOCK_SIZE) || (size % MMC_BLOCK_SIZE) || !size)
+		return -EINVAL;
+
+	return s32_mmc_dev_register();
+}
+
+int s32_storage_raw_read(size_t offset, uintptr_t buf, size_t size)
+{
+	int ret;
+
+	ret = check_raw_access(offset, size);
+	if (ret)
+		return ret;
+
+	if (mmc_read_blocks(offset / MMC_BLOCK_SIZE, buf, size) != size)
+		return -EIO;
+
+	return 0;
+}
+
+int s32_storage_raw_write(size_t offset, uintptr_t buf, size_t size)
+{
+	int ret;
+
+	ret = check_raw_access(offset, size);
+	if (ret)
+		return ret;
+
+	if (mmc_write_blocks(offset / MMC_BLOCK_SIZE, buf, size) != size)
+		return -EIO;
+
+	return 0;
+}
@@ -7,19 +7,49 @@
 #include <common/debug.h>
 #include <common/runtime_svc.h>
 #include <drivers/scmi.h>
+#include <lib/spinlock.h>
+#include <lib/utils_def.h>
+#include <libfdt.h>
+#include <plat/common/platform.h>
 #include <scmi-msg/common.h>
 #include <s32_svc.h>
 #include <s32cc_bl_common.h>
+#include <s32cc_boot_prof.h>
+#include <s32cc_dt.h>
+#include <s32cc_interrupt_mgmt.h>
 #include <s32cc_scp_scmi.h>
 #include <s32cc_svc.h>
 
 #define S32_SCMI_ID			0xc20000feU
+/* Returns the address and the size of the boot profiling record */
+#define S32_SIP_BOOT_PROF_ID		0xc20000fdU
+/* Returns the address and the size of the SCMI latency trace */
+#define S32_SIP_SCMI_TRACE_ID		0xc20000fcU
+/* Returns the count, max and average duration of an EL3 interrupt (x1) */
+#define S32_SIP_IRQ_STATS_ID		0xc20000fbU
 
 #define MSG_ID(m)			((m) & 0xffU)
 #define MSG_TYPE(m)			(((m) >> 8) & 0x3U)
 #define MSG_PRO_ID(m)			(((m) >> 10) & 0xffU)
 #define MSG_TOKEN(m)			(((m) >> 18) & 0x3ffU)
 
+/*
+ * Agents using the "arm,scmi-smc-param" transport pass the address of their
+ * shared memory window as a page number in x1 and an offset in x2.
+ */
+#define SMC_PARAM_PAGE_SHIFT		12U
+#define SMC_PARAM_PAGE_SIZE		BIT_64(SMC_PARAM_PAGE_SHIFT)
+
+/* The SCMI server state is shared by all the OSPM channels and FastChannels */
+static spinlock_t scmi_lock;
+
+#if (S32_SCMI_ASYNC == 1)
+#define GIC_IRQ_CELL_SIZE		3U
+
+/* Interrupt used to signal the completion of the agent's requests, if any */
+static int scmi_a2p_irq = -1;
+#endif
+
 static const uint8_t s32_protocols[] = {
 	SCMI_PROTOCOL_ID_PERF,
 	SCMI_PROTOCOL_ID_CLOCK,
@@ -53,7 +83,14 @@ const uint8_t *plat_scmi_protocol_list(unsigned int agent_id)
 
 int32_t plat_scmi_reset_agent(unsigned int agent_id)
 {
-	return plat_scmi_clock_agent_reset(agent_id);
+	int32_t ret;
+
+	/* Base protocol runs unlocked, but this touches the shared clock state */
+	s32_scmi_lock();
+	ret = plat_scmi_clock_agent_reset(agent_id);
+	s32_scmi_unlock();
+
+	return ret;
 }
 
 size_t plat_scmi_protocol_count(void)
@@ -61,18 +98,130 @@ size_t plat_scmi_protocol_count(void)
 	return ARRAY_SIZE(s32_protocols) - 1;
 }
 
+void s32_scmi_lock(void)
+{
+	spin_lock(&scmi_lock);
+}
+
+void s32_scmi_unlock(void)
+{
+	spin_unlock(&scmi_lock);
+}
+
+static struct scmi_shared_mem *get_ospm_channel(unsigned int ch)
+{
+	return (struct scmi_shared_mem *)S32_OSPM_SCMI_CH_MEM(ch);
+}
+
+/*
+ * Each OSPM channel has its own shared memory window, so requests issued in
+ * parallel on different channels never share a mailbox.
+ */
+static struct scmi_shared_mem *find_ospm_channel(u_register_t x1,
+						 u_register_t x2)
+{
+	uintptr_t addr;
+
+	/*
+	 * The plain "arm,scmi-smc" transport doesn't identify the channel, it
+	 * is bound to the first one. The other channels are only reachable
+	 * through "arm,scmi-smc-param".
+	 */
+	if (!x1)
+		return get_ospm_channel(0U);
+
+	if (x1 > (UINTPTR_MAX >> SMC_PARAM_PAGE_SHIFT) ||
+	    x2 >= SMC_PARAM_PAGE_SIZE)
+		return NULL;
+
+	addr = (x1 << SMC_PARAM_PAGE_SHIFT) + x2;
+	if (addr < S32_OSPM_SCMI_MEM ||
+	    addr >= S32_OSPM_SCMI_CH_MEM(S32_OSPM_SCMI_CHANNELS))
+		return NULL;
+
+	if ((addr - S32_OSPM_SCMI_MEM) % S32_OSPM_SCMI_MEM_SIZE)
+		return NULL;
+
+	return (struct scmi_shared_mem *)addr;
+}
+
+#if (S32_SCMI_ASYNC == 1)
+/* The "a2p" interrupt of the "arm,scmi-smc" transport */
+static void init_scmi_a2p_irq(void)
+{
+	void *fdt = NULL;
+	int node, idx, irq;
+
+	if (dt_open_and_check() < 0 || !fdt_get_address(&fdt))
+		return;
+
+	node = dt_node_offset_by_compatible(fdt, -1, "arm,scmi-smc");
+	if (node < 0)
+		return;
+
+	idx = fdt_stringlist_search(fdt, node, "interrupt-names", "a2p");
+	if (idx < 0)
+		return;
+
+	if (fdt_get_irq_props_by_index(fdt, node, GIC_IRQ_CELL_SIZE, idx,
+				       &irq)) {
+		ERROR("Failed to get the SCMI a2p interrupt\n");
+		return;
+	}
+
+	scmi_a2p_irq = irq;
+}
+
+static bool wants_completion_irq(const struct scmi_shared_mem *mem)
+{
+	return scmi_a2p_irq >= 0 &&
+	       (mem->flags & SCMI_SHMEM_FLAG_INTR_ENABLED);
+}
+
+static void signal_completion(uintptr_t scmi_mem)
+{
+	plat_ic_set_interrupt_pending(scmi_a2p_irq);
+}
+#endif
+
 static int32_t s32_svc_smc_setup(void)
 {
-	struct scmi_shared_mem *mem = (void *)S32_OSPM_SCMI_MEM;
+	unsigned int ch;
+
+	for (ch = 0U; ch < S32_OSPM_SCMI_CHANNELS; ch++)
+		get_ospm_channel(ch)->channel_status =
+			SCMI_SHMEM_CHAN_STAT_CHANNEL_FREE;
+
+#if (S32_SCMI_ASYNC == 1)
+	init_scmi_a2p_irq();
+#endif
 
-	mem->channel_status = SCMI_SHMEM_CHAN_STAT_CHANNEL_FREE;
 	return 0;
 }
 
-static int scmi_handler(uint32_t smc_fid, u_register_t x1,
-			u_register_t x2, u_register_t x3)
+/*
+ * Only the protocols backed by the clock driver (clock, perf and reset
+ * domains) share mutable state between the OSPM channels. Discovery
+ * messages and the base protocol report static data and can run
+ * concurrently on all channels.
+ */
+static bool scmi_msg_needs_lock(const struct scmi_msg *msg)
+{
+	if (msg->message_id <= SCMI_PROTOCOL_MESSAGE_ATTRIBUTES)
+		return false;
+
+	switch (msg->protocol_id) {
+	case SCMI_PROTOCOL_ID_CLOCK:
+	case SCMI_PROTOCOL_ID_PERF:
+	case SCMI_PROTOCOL_ID_RESET_DOMAIN:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static int scmi_handler(struct scmi_shared_mem *mem)
 {
-	struct scmi_shared_mem *mem = (void *)S32_OSPM_SCMI_MEM;
 	struct response *response = (struct response *)&mem->msg_payload[0];
 	uint32_t msg_header = mem->msg_header;
 	struct scmi_msg msg = {
@@ -84,23 +233,44 @@ static int scmi_handler(uint32_t smc_fid, u_register_t x1,
 		.out = (char *)response,
 		.out_size = S32_OSPM_SCMI_MEM_SIZE - sizeof(*mem),
 	};
+	bool locked = scmi_msg_needs_lock(&msg);
 
+	if (locked)
+		s32_scmi_lock();
 	scmi_process_message(&msg);
+	if (locked)
+		s32_scmi_unlock();
 
 	mem->length = msg.out_size_out + 4;
 	mem->channel_status = 1;
 
+#if (S32_SCMI_ASYNC == 1)
+	if (wants_completion_irq(mem))
+		signal_completion((uintptr_t)mem);
+#endif
+
 	return 0;
 }
 
-static int scp_scmi_handler(uint32_t smc_fid, u_register_t x1,
-			    u_register_t x2, u_register_t x3)
+static int scp_scmi_handler(struct scmi_shared_mem *mem)
 {
-	struct scmi_shared_mem *mem = (void *)S32_OSPM_SCMI_MEM;
 	struct response *response = (struct response *)&mem->msg_payload[0];
 	int ret;
 
-	ret = send_scmi_to_scp(S32_OSPM_SCMI_MEM, S32_OSPM_SCMI_MEM_SIZE, OSPM);
+#if (S32_SCMI_ASYNC == 1)
+	/*
+	 * Don't keep the core in EL3 while the SCP works on the request, the
+	 * agent waits for its completion interrupt.
+	 */
+	if (wants_completion_irq(mem))
+		ret = post_scmi_to_scp((uintptr_t)mem, S32_OSPM_SCMI_MEM_SIZE,
+				       signal_completion);
+	else
+		ret = send_scmi_to_scp((uintptr_t)mem, S32_OSPM_SCMI_MEM_SIZE,
+				       OSPM);
+#else
+	ret = send_scmi_to_scp((uintptr_t)mem, S32_OSPM_SCMI_MEM_SIZE, OSPM);
+#endif
 	if (ret != SCMI_SUCCESS) {
 		response->status = ret;
 		mem->channel_status = 1;
@@ -119,14 +289,43 @@ uintptr_t s32_svc_smc_handler(uint32_t smc_fid,
 			       void *handle,
 			       u_register_t flags)
 {
+	struct scmi_shared_mem *mem;
+#if (S32_IRQ_STATS == 1)
+	uint64_t count, max, avg;
+#endif
+
 	switch (smc_fid) {
 	case S32_SCMI_ID:
-		if (is_scp_used()) {
-			SMC_RET1(handle, scp_scmi_handler(smc_fid, x1, x2, x3));
+		mem = find_ospm_channel(x1, x2);
+		if (!mem) {
+			SMC_RET1(handle, SMC_UNK);
+		} else if (is_scp_used()) {
+			SMC_RET1(handle, scp_scmi_handler(mem));
 		} else {
-			SMC_RET1(handle, scmi_handler(smc_fid, x1, x2, x3));
+			SMC_RET1(handle, scmi_handler(mem));
 		}
 		break;
+#if (S32_BOOT_PROF == 1)
+	case S32_SIP_BOOT_PROF_ID:
+		SMC_RET3(handle, SMC_OK, S32_BOOT_PROF_BASE,
+			 S32_BOOT_PROF_SIZE);
+		break;
+#endif
+#if (SCMI_TRACE == 1)
+	case S32_SIP_SCMI_TRACE_ID:
+		if (!is_scp_used())
+			SMC_RET1(handle, SMC_UNK);
+		SMC_RET3(handle, SMC_OK, S32_SCMI_TRACE_MEM,
+			 S32_SCMI_TRACE_SIZE);
+		break;
+#endif
+#if (S32_IRQ_STATS == 1)
+	case S32_SIP_IRQ_STATS_ID:
+		if (s32cc_el3_irq_get_stats((uint32_t)x1, &count, &max, &avg))
+			SMC_RET1(handle, SMC_UNK);
+		SMC_RET4(handle, SMC_OK, count, max, avg);
+		break;
+#endif
 	default:
 		WARN("Unimplemented SIP Service Call: 0x%x\n", smc_fid);
 		SMC_RET1(handle, SMC_UNK);
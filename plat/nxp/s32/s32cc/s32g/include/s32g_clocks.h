@@ -137,6 +137,8 @@ enum S32G_DFS_PARAMS {
 #define MC_CGM_MUXn_CSC_SEL_CORE_PLL_PHI0	4
 #define MC_CGM_MUXn_CSC_SEL_CORE_PLL_DFS1	12
 #define MC_CGM_MUXn_CSC_SEL_PERIPH_PLL_PHI3	21
+#define MC_CGM_MUXn_CSC_SEL_PERIPH_PLL_DFS1	26
+#define MC_CGM_MUXn_CSC_SEL_PERIPH_PLL_DFS3	28
 #define MC_CGM_MUXn_CSC_SEL_DDR_PLL_PHI0	36
 #define MC_CGM_MUXn_CSC_SEL_PERIPH_PLL_PHI0	18
 #define MC_CGM_MUXn_CSC_SEL_PERIPH_PLL_PHI7	25
@@ -0,0 +1,32 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef S32G_DDR_CACHE_H
+#define S32G_DDR_CACHE_H
+
+#include <stdint.h>
+
+/*
+ * Initialize the DDR SubSystem, reusing the training results stored on the
+ * boot device by a previous boot if they are still valid for this board.
+ * Falls back to a full PHY training otherwise.
+ */
+uint32_t s32g_ddr_init(void);
+
+/*
+ * Persist the freshly trained settings to the boot device. Must be called
+ * after the boot device was set up. Does nothing if the DDR was initialized
+ * from a valid cache entry.
+ */
+void s32g_ddr_cache_commit(void);
+
+/*
+ * Temperature band used to qualify the stored training results.
+ * The default implementation returns 0; boards with a temperature sensor may
+ * override it to force a retraining when the band changes.
+ */
+uint32_t s32g_ddr_cache_temp_band(void);
+
+#endif /* S32G_DDR_CACHE_H */
@@ -47,6 +47,10 @@
 
 #define BL31SSRAM_MAILBOX	(S32G_SSRAM_BASE)
 
+/* Boot profiling record, at the end of the standby RAM */
+#define S32_BOOT_PROF_SIZE	(0x400)
+#define S32_BOOT_PROF_BASE	(S32G_SSRAM_LIMIT - S32_BOOT_PROF_SIZE)
+
 #define MAX_MMAP_REGIONS		52
 #ifndef MAX_XLAT_TABLES
 #define MAX_XLAT_TABLES			28
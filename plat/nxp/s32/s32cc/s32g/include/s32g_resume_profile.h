@@ -0,0 +1,26 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#ifndef S32G_RESUME_PROFILE_H
+#define S32G_RESUME_PROFILE_H
+
+/*
+ * On the way to standby, BL31 snapshots the clock programming needed on the
+ * resume path into a register script kept in the standby RAM. On wake-up,
+ * BL2 replays the part the DDR restore depends on, without going through the
+ * DT, the MMU setup and the clock driver, and BL31 replays the rest.
+ *
+ * A profile is used for a single resume.
+ */
+void s32g_resume_profile_capture(void);
+
+/*
+ * Both return the number of replayed operations, -ENOENT if there is no
+ * valid profile or a negative error code if the replay failed.
+ */
+int s32g_resume_profile_run_pre_ddr(void);
+int s32g_resume_profile_run_post_ddr(void);
+
+#endif /* S32G_RESUME_PROFILE_H */
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <errno.h>
 #include <lib/mmio.h>
 #include <drivers/nxp/s32/rtc/s32g/s32g_rtc.h>
 #include "s32g_clocks.h"
@@ -18,6 +19,7 @@
 #include "s32g_bl_common.h"
 #include "s32g_vr5510.h"
 #include "s32cc_sramc.h"
+#include "s32cc_boot_prof.h"
 #include <s32cc_scp_scmi.h>
 #include <s32cc_scp_utils.h>
 #include "s32cc_flexnoc.h"
@@ -28,6 +30,12 @@
 #include "ddr_lp.h"
 #include <dt-bindings/ddr-errata/s32-ddr-errata.h>
 #endif
+#if (S32_DDR_TRAIN_CACHE == 1)
+#include "s32g_ddr_cache.h"
+#endif
+#if (S32G_FAST_RESUME == 1)
+#include "s32g_resume_profile.h"
+#endif
 
 static bl_mem_params_node_t s32g_bl2_mem_params_descs[6];
 REGISTER_BL_IMAGE_DESCS(s32g_bl2_mem_params_descs)
@@ -94,12 +102,6 @@ static int init_and_setup_pmic(void)
 	return ret;
 }
 
-#pragma weak platform_adjust_noc_settings
-int platform_adjust_noc_settings(void)
-{
-	return 0;
-}
-
 static const uintptr_t used_ips_base[] = {
 	/* Linflex */
 	S32_UART_BASE,
@@ -136,22 +138,48 @@ static const struct s32_mmu_filter scp_filters[] = {
 	},
 };
 
-static void resume_bl31(struct s32g_ssram_mailbox *ssram_mb)
-{
 #if S32CC_EMU == 0
-	s32g_warm_entrypoint_t resume_entrypoint;
-	const struct s32_mmu_filter *mmu_filters;
-	size_t n_mmu_filters;
-	uintptr_t csr_addr;
+static void mark_wake_event(void)
+{
+#if (S32_BOOT_PROF == 1)
+	uint32_t arg = S32_BOOT_ARG_NONE;
+	uint64_t usec;
 
-	resume_entrypoint = ssram_mb->bl31_warm_entrypoint;
-	csr_addr = (uintptr_t)&ssram_mb->csr_settings[0];
+	/* Only a wake-up by the RTC leaves a timestamp behind */
+	if (!s32g_rtc_get_event_age(&usec))
+		arg = (uint32_t)MIN(usec, (uint64_t)S32_BOOT_ARG_NONE - 1U);
 
-	if (s32g_reset_rtc()) {
-		ERROR("Failed to reset RTC");
-		panic();
+	s32_boot_prof_mark(S32_BOOT_WAKE_EVENT, arg);
+#endif
+}
+
+/*
+ * Replay the clock programming captured by BL31 at suspend. The PMIC and the
+ * NoC settings aren't needed by the DDR restore and are left to BL31.
+ */
+static bool fast_resume_setup(void)
+{
+#if (S32G_FAST_RESUME == 1)
+	int ret;
+
+	ret = s32g_resume_profile_run_pre_ddr();
+	if (ret >= 0) {
+		s32_boot_prof_mark(S32_BOOT_RESUME_SCRIPT, ret);
+		return true;
 	}
 
+	if (ret != -ENOENT)
+		ERROR("Failed to replay the resume profile\n");
+#endif
+
+	return false;
+}
+
+static void resume_setup(void)
+{
+	const struct s32_mmu_filter *mmu_filters;
+	size_t n_mmu_filters;
+
 	if (is_scp_used()) {
 		mmu_filters = &scp_filters[0];
 		n_mmu_filters = ARRAY_SIZE(scp_filters);
@@ -169,35 +197,74 @@ static void resume_bl31(struct s32g_ssram_mailbox *ssram_mb)
 		panic();
 	}
 
+	s32_boot_prof_mark(S32_BOOT_MMU_ENABLE, S32_BOOT_ARG_NONE);
+
+	s32_boot_prof_mark(S32_BOOT_CLK_START, S32_BOOT_ARG_NONE);
 	if (s32_periph_clock_init()) {
 		ERROR("Failed to enable BL2 periph clocks\n");
 		panic();
 	}
+	s32_boot_prof_mark(S32_BOOT_CLK_END, S32_BOOT_ARG_NONE);
 
+	s32_boot_prof_mark(S32_BOOT_PMIC_START, S32_BOOT_ARG_NONE);
 	if (init_and_setup_pmic()) {
 		ERROR("Failed to disable VR5510 watchdog\n");
 		panic();
 	}
+	s32_boot_prof_mark(S32_BOOT_PMIC_END, S32_BOOT_ARG_NONE);
 
 	if (platform_adjust_noc_settings()) {
 		ERROR("Failed to apply NoC settings\n");
 		panic();
 	}
+}
+#endif
 
+static void resume_bl31(struct s32g_ssram_mailbox *ssram_mb)
+{
+#if S32CC_EMU == 0
+	s32g_warm_entrypoint_t resume_entrypoint;
+	uintptr_t csr_addr;
+	bool fast_resume;
+
+	resume_entrypoint = ssram_mb->bl31_warm_entrypoint;
+	csr_addr = (uintptr_t)&ssram_mb->csr_settings[0];
+
+	mark_wake_event();
+
+	if (s32g_reset_rtc()) {
+		ERROR("Failed to reset RTC");
+		panic();
+	}
+
+	fast_resume = fast_resume_setup();
+	if (!fast_resume)
+		resume_setup();
+
+	s32_boot_prof_mark(S32_BOOT_DDR_START, S32_BOOT_ARG_NONE);
 	if (ddrss_to_normal_mode(csr_addr)) {
 		ERROR("Failed to transition DDR to normal mode\n");
 		panic();
 	}
 
 	dsbsy();
+	s32_boot_prof_mark(S32_BOOT_DDR_END, S32_BOOT_ARG_NONE);
 
-	if (s32_el3_mmu_ddr_fixup())
-		panic();
+	/* The fast path runs with the MMU off */
+	if (!fast_resume) {
+		if (s32_el3_mmu_ddr_fixup())
+			panic();
+
+		s32_boot_prof_mark(S32_BOOT_MMU_DDR, S32_BOOT_ARG_NONE);
+	}
 
 #if (ERRATA_S32_050543 == 1)
 	ddr_errata_update_flag(polling_needed);
 #endif
 
+	s32_boot_prof_mark(S32_BOOT_BL2_EXIT, S32_BOOT_ARG_NONE);
+	s32_boot_prof_commit(true);
+
 	isb();
 	dsb();
 	disable_mmu_el3();
@@ -214,6 +281,8 @@ void bl2_el3_early_platform_setup(u_register_t arg0, u_register_t arg1,
 	size_t params_size = ARRAY_SIZE(s32g_bl2_mem_params_descs);
 	int ret = 0;
 
+	s32_boot_prof_mark(S32_BOOT_BL2_ENTRY, S32_BOOT_ARG_NONE);
+
 	if (is_scp_used())
 		scp_scmi_init(false);
 
@@ -226,9 +295,13 @@ void bl2_el3_early_platform_setup(u_register_t arg0, u_register_t arg1,
 			ERROR("Failed to get reset cause from SCP\n");
 	}
 
+	s32_boot_prof_mark(S32_BOOT_RESET_CAUSE, reset_cause);
+
 	s32_early_plat_init();
 
+	s32_boot_prof_mark(S32_BOOT_HSE_WAIT_START, S32_BOOT_ARG_NONE);
 	wait_hse_init();
+	s32_boot_prof_mark(S32_BOOT_HSE_WAIT_END, S32_BOOT_ARG_NONE);
 
 	if (reset_cause == CAUSE_WAKEUP_DURING_STANDBY) {
 		/* Trampoline to bl31_warm_entrypoint */
@@ -253,8 +326,19 @@ void bl2_el3_plat_arch_setup(void)
 {
 	console_s32_register();
 
+	/*
+	 * The SRAM controllers initialize their memory in the background,
+	 * while the PMIC and the DDR subsystem are configured.
+	 */
+	s32_boot_prof_mark(S32_BOOT_SRAM_CLEAR_START, S32_BOOT_ARG_NONE);
+	s32_sram_clear_start(S32_BL33_IMAGE_BASE, get_bl2_dtb_base());
+
+	s32_ssram_clear_start();
+
+	s32_boot_prof_mark(S32_BOOT_PMIC_START, S32_BOOT_ARG_NONE);
 	if (init_and_setup_pmic())
 		panic();
+	s32_boot_prof_mark(S32_BOOT_PMIC_END, S32_BOOT_ARG_NONE);
 
 	if (platform_adjust_noc_settings()) {
 		ERROR("Failed to apply NoC settings\n");
@@ -263,28 +347,42 @@ void bl2_el3_plat_arch_setup(void)
 
 	NOTICE("Reset status: %s\n", get_reset_cause_str(reset_cause));
 
-	s32_sram_clear(S32_BL33_IMAGE_BASE, get_bl2_dtb_base());
-
-	s32_ssram_clear();
-
 	clear_swt_faults();
 
+	/* The DDR driver stores the CSRs into the standby RAM */
+	s32_ssram_clear_wait();
+
 	/* This will also populate CSR section from bl31ssram */
+	s32_boot_prof_mark(S32_BOOT_DDR_START, S32_BOOT_ARG_NONE);
+#if (S32_DDR_TRAIN_CACHE == 1)
+	if (s32g_ddr_init()) {
+#else
 	if (ddr_init()) {
+#endif
 		ERROR("Failed to configure the DDR subsystem\n");
 		panic();
 	}
 
 	dsbsy();
+	s32_boot_prof_mark(S32_BOOT_DDR_END, S32_BOOT_ARG_NONE);
+
+	s32_sram_clear_wait();
+	s32_boot_prof_mark(S32_BOOT_SRAM_CLEAR_END, S32_BOOT_ARG_NONE);
 
 	if (s32_el3_mmu_ddr_fixup())
 		panic();
 
+	s32_boot_prof_mark(S32_BOOT_MMU_DDR, S32_BOOT_ARG_NONE);
+
 #if (ERRATA_S32_050543 == 1)
 	ddr_errata_update_flag(polling_needed);
 #endif
 
 	s32_io_setup();
 
+#if (S32_DDR_TRAIN_CACHE == 1)
+	s32g_ddr_cache_commit();
+#endif
+
 	hse_secboot_setup();
 }
@@ -11,6 +11,64 @@ S32_SOC_FAMILY	:= ${S32CC_PLAT}/s32g
 S32_VR5510 ?= 0
 $(eval $(call add_define_val,S32_VR5510,$(S32_VR5510)))
 
+# Store the DDR training results on the boot device (MMC only) and reuse them
+# on the following cold boots instead of running the PHY training again.
+# S32_DDR_TRAIN_CACHE_OFFSET is the byte offset of the reserved area on the
+# boot device and must be aligned to the MMC block size.
+# A restore is checked with a data pattern over the first DDR page; if it
+# fails, the stored results are dropped and the DDR is trained again.
+S32_DDR_TRAIN_CACHE ?= 0
+$(eval $(call add_define_val,S32_DDR_TRAIN_CACHE,$(S32_DDR_TRAIN_CACHE)))
+
+ifeq ($(S32_DDR_TRAIN_CACHE),1)
+ifndef S32_DDR_TRAIN_CACHE_OFFSET
+$(error "S32_DDR_TRAIN_CACHE_OFFSET must be set")
+endif
+$(eval $(call add_define,S32_DDR_TRAIN_CACHE_OFFSET))
+
+BL2_SOURCES		+= ${S32_SOC_FAMILY}/s32g_ddr_cache.c
+endif
+
+# Resume from standby by replaying the clock programming BL31 captured at
+# suspend, without going through the DT, the MMU setup and the clock driver in
+# BL2. The PMIC and the NoC are set up by BL31, after the DDR restore.
+S32G_FAST_RESUME ?= 0
+$(eval $(call add_define_val,S32G_FAST_RESUME,$(S32G_FAST_RESUME)))
+
+ifeq ($(S32G_FAST_RESUME),1)
+BL2_SOURCES		+= ${S32CC_PLAT}/s32_reg_script.c \
+			   ${S32_SOC_FAMILY}/s32g_resume_profile.c \
+
+BL31_SOURCES		+= ${S32CC_PLAT}/s32_reg_script.c \
+			   ${S32_SOC_FAMILY}/s32g_resume_profile.c \
+			   common/tf_crc32.c \
+
+BL31_CPPFLAGS		+= -march=armv8-a+crc
+endif
+
+ifeq ($(S32_CLK_SCRIPT),1)
+ifeq ($(FIP_LOCATION),)
+$(error S32_CLK_SCRIPT needs FIP_LOCATION)
+endif
+
+CLK_SCRIPT_GEN		:= tools/nxp/clk_script_gen/clk_script_gen.py
+CLK_SCRIPT_FREQS	:= tools/nxp/clk_script_gen/boot_clk_freqs.in
+CLK_SCRIPT_DIR		:= ${BUILD_PLAT}/clk_script
+
+BL2_SOURCES		+= ${S32CC_PLAT}/s32_reg_script.c \
+			   ${CLK_SCRIPT_DIR}/s32_boot_clk_script.c \
+
+${CLK_SCRIPT_DIR}/boot_clk_freqs: ${CLK_SCRIPT_FREQS}
+	${Q}mkdir -p $(dir $@)
+	${ECHO} "  PP      $<"
+	${Q}$(CPP) $(CPPFLAGS) -P -x assembler-with-cpp -D__LINKER__ -o $@ $<
+
+${CLK_SCRIPT_DIR}/s32_boot_clk_script.c: ${CLK_SCRIPT_DIR}/boot_clk_freqs \
+					 ${CLK_SCRIPT_GEN}
+	${ECHO} "  GEN     $@"
+	${Q}${PYTHON} ${CLK_SCRIPT_GEN} $< ${FIP_LOCATION} $@
+endif
+
 ifeq ($(S32CC_EMU),1)
 DDR_DRV_SRCS := \
 	${DDR_DRV}/emu/ddrss_emu.c \
@@ -0,0 +1,276 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <common/tf_crc32.h>
+#include <drivers/mmc.h>
+#include <errno.h>
+#include <lib/utils.h>
+#include <plat/common/platform.h>
+#include <plat/nxp/s32g/ssram_mailbox.h>
+#include <string.h>
+#include "ddr_init.h"
+#include "ddr_lp.h"
+#include "s32_bl_common.h"
+#include "s32cc_storage.h"
+#include "s32g_bl_common.h"
+#include "s32g_ddr_cache.h"
+
+/* "DDRT" */
+#define DDR_CACHE_MAGIC		(0x54524444U)
+#define DDR_CACHE_VERSION	(1U)
+
+/* Window used to check the data bus after restoring the training results */
+#define DDR_CHECK_BASE		S32_DDR0_BASE
+#define DDR_CHECK_SIZE		PAGE_SIZE_4KB
+
+/*
+ * On-storage layout of the cached training results. The payload is the
+ * CSR/DDRC snapshot produced by store_csr() and store_ddrc_regs(), i.e. the
+ * same data used for resuming from standby.
+ */
+struct s32g_ddr_cache_hdr {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t fingerprint;
+	uint32_t temp_band;
+	uint32_t payload_size;
+	uint32_t crc;
+};
+
+struct s32g_ddr_cache {
+	struct s32g_ddr_cache_hdr hdr;
+	uint8_t payload[BL31SSRAM_CSR_SIZE] __aligned(4);
+};
+
+#define DDR_CACHE_SIZE	round_up(sizeof(struct s32g_ddr_cache), MMC_BLOCK_SIZE)
+
+static union {
+	struct s32g_ddr_cache cache;
+	uint8_t raw[DDR_CACHE_SIZE];
+} ddr_cache __aligned(CACHE_WRITEBACK_GRANULE);
+
+static bool ddr_cache_dirty;
+
+#pragma weak s32g_ddr_cache_temp_band
+uint32_t s32g_ddr_cache_temp_band(void)
+{
+	return 0;
+}
+
+static uint32_t crc_table(uint32_t crc, const void *table, size_t size)
+{
+	return tf_crc32(crc, table, size);
+}
+
+/*
+ * Identifies the DDR configuration the training results belong to. Any change
+ * in the controller, PHY or PIE settings, or in the PHY firmware, invalidates
+ * the stored results.
+ */
+static uint32_t get_fingerprint(void)
+{
+	uint32_t crc = 0;
+
+	crc = crc_table(crc, ddrc_cfg, ddrc_cfg_size * sizeof(ddrc_cfg[0]));
+	crc = crc_table(crc, dq_swap_cfg,
+			dq_swap_cfg_size * sizeof(dq_swap_cfg[0]));
+	crc = crc_table(crc, phy_cfg, phy_cfg_size * sizeof(phy_cfg[0]));
+	crc = crc_table(crc, pie_cfg, pie_cfg_size * sizeof(pie_cfg[0]));
+	crc = crc_table(crc, FIRMWARE_VERSION, sizeof(FIRMWARE_VERSION));
+
+	return crc;
+}
+
+static bool is_cache_valid(const struct s32g_ddr_cache *cache)
+{
+	const struct s32g_ddr_cache_hdr *hdr = &cache->hdr;
+
+	if (hdr->magic != DDR_CACHE_MAGIC || hdr->version != DDR_CACHE_VERSION)
+		return false;
+
+	if (hdr->payload_size != sizeof(cache->payload))
+		return false;
+
+	if (hdr->fingerprint != get_fingerprint()) {
+		INFO("DDR cache: configuration changed\n");
+		return false;
+	}
+
+	if (hdr->temp_band != s32g_ddr_cache_temp_band()) {
+		INFO("DDR cache: temperature band changed\n");
+		return false;
+	}
+
+	if (hdr->crc != tf_crc32(0, cache->payload, sizeof(cache->payload))) {
+		WARN("DDR cache: CRC mismatch\n");
+		return false;
+	}
+
+	return true;
+}
+
+static int load_cache(void)
+{
+	int ret;
+
+	ret = s32_storage_raw_read(S32_DDR_TRAIN_CACHE_OFFSET,
+				   (uintptr_t)&ddr_cache, sizeof(ddr_cache));
+	if (ret)
+		return ret;
+
+	if (!is_cache_valid(&ddr_cache.cache))
+		return -EINVAL;
+
+	return 0;
+}
+
+static int store_cache(void)
+{
+	return s32_storage_raw_write(S32_DDR_TRAIN_CACHE_OFFSET,
+				     (uintptr_t)&ddr_cache, sizeof(ddr_cache));
+}
+
+static void invalidate_cache(void)
+{
+	zeromem(&ddr_cache, sizeof(ddr_cache));
+
+	if (store_cache())
+		ERROR("DDR cache: failed to invalidate the stored entry\n");
+}
+
+/*
+ * Walking ones (and their complement on odd words) over a page of DDR, through
+ * a non-cacheable mapping. Badly restored DQ/DQS delays show up as corrupted
+ * bits here, before any image is loaded into DDR.
+ */
+static int check_ddr(void)
+{
+	volatile uint64_t *mem = (volatile uint64_t *)DDR_CHECK_BASE;
+	size_t words = DDR_CHECK_SIZE / sizeof(*mem);
+	bool is_added = false;
+	uint64_t pattern;
+	size_t i;
+	int ret;
+
+	ret = s32_mmap_dynamic_region(DDR_CHECK_BASE, DDR_CHECK_SIZE,
+				      MT_NON_CACHEABLE | MT_RW | MT_SECURE,
+				      &is_added);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < words; i++) {
+		pattern = BIT_64(i % 64U);
+		mem[i] = (i & 1U) ? ~pattern : pattern;
+	}
+
+	for (i = 0; i < words; i++) {
+		pattern = BIT_64(i % 64U);
+		if (mem[i] != ((i & 1U) ? ~pattern : pattern)) {
+			ERROR("DDR cache: data mismatch at 0x%lx\n",
+			      (uintptr_t)&mem[i]);
+			ret = -EIO;
+			break;
+		}
+	}
+
+	/* The rest of the DDR was cleared by the restore */
+	for (i = 0; i < words; i++)
+		mem[i] = 0;
+
+	if (is_added)
+		(void)mmap_remove_dynamic_region(DDR_CHECK_BASE,
+						 DDR_CHECK_SIZE);
+
+	return ret;
+}
+
+static uint32_t restore_ddr(void)
+{
+	uint32_t ret;
+
+	/*
+	 * Keep the snapshot in the standby RAM as well, it will be needed when
+	 * resuming from suspend.
+	 */
+	memcpy((void *)BL31SSRAM_CSR_BASE, ddr_cache.cache.payload,
+	       sizeof(ddr_cache.cache.payload));
+
+	ret = ddrss_init_from_snapshot(BL31SSRAM_CSR_BASE);
+	if (ret != NO_ERR)
+		return ret;
+
+	if (check_ddr())
+		return TRAINING_FAILED;
+
+	return NO_ERR;
+}
+
+uint32_t s32g_ddr_init(void)
+{
+	uint64_t start = read_cntpct_el0();
+	uint32_t ret;
+	bool cached;
+
+	cached = (load_cache() == 0);
+	if (cached) {
+		ret = restore_ddr();
+		if (ret == NO_ERR)
+			goto out;
+
+		/*
+		 * Drop the stored results and go through a full training,
+		 * starting again from a DDR subsystem in reset.
+		 */
+		ERROR("DDR cache: failed to restore the training results\n");
+		invalidate_cache();
+		cached = false;
+
+		ret = assert_ddr_reset();
+		if (ret)
+			return ret;
+	}
+
+	ret = ddr_init();
+	if (ret)
+		return ret;
+
+	ddr_cache_dirty = true;
+
+out:
+	INFO("DDR %s in %llu us\n", cached ? "restored" : "trained",
+	     s32_ticks_to_us(read_cntpct_el0() - start));
+
+	return ret;
+}
+
+void s32g_ddr_cache_commit(void)
+{
+	struct s32g_ddr_cache *cache = &ddr_cache.cache;
+
+	if (!ddr_cache_dirty)
+		return;
+
+	zeromem(&ddr_cache, sizeof(ddr_cache));
+	memcpy(cache->payload, (void *)BL31SSRAM_CSR_BASE,
+	       sizeof(cache->payload));
+
+	cache->hdr = (struct s32g_ddr_cache_hdr) {
+		.magic = DDR_CACHE_MAGIC,
+		.version = DDR_CACHE_VERSION,
+		.fingerprint = get_fingerprint(),
+		.temp_band = s32g_ddr_cache_temp_band(),
+		.payload_size = sizeof(cache->payload),
+		.crc = tf_crc32(0, cache->payload, sizeof(cache->payload)),
+	};
+
+	if (store_cache()) {
+		WARN("DDR cache: failed to store the training results\n");
+		return;
+	}
+
+	ddr_cache_dirty = false;
+}
@@ -11,6 +11,9 @@
 #include "s32g_clocks.h"
 #include "s32g_mc_me.h"
 #include "s32g_resume.h"
+#if (S32G_FAST_RESUME == 1)
+#include "s32g_resume_profile.h"
+#endif
 #include "s32g_vr5510.h"
 #include "s32gen1-wkpu.h"
 
@@ -114,6 +117,11 @@ static void __dead2 platform_suspend(unsigned int current_cpu)
 {
 	set_warm_entry();
 
+#if (S32G_FAST_RESUME == 1)
+	/* While the clocks are still running */
+	s32g_resume_profile_capture();
+#endif
+
 	if (!is_scp_used()) {
 		pmic_prepare_for_suspend();
 		s32gen1_wkpu_enable_irqs();
@@ -3,19 +3,66 @@
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <errno.h>
 #include <bl31/bl31.h>		/* for bl31_warm_entrypoint() */
+#include <clk/s32gen1_clk_funcs.h>
 #include <s32cc_bl_common.h>
+#include <s32cc_boot_prof.h>
+#include <s32cc_flexnoc.h>
 #include <s32cc_linflexuart.h>
 #include <s32cc_lowlevel.h>
+#include <s32cc_pmic.h>
 #include <s32gen1-wkpu.h>
 #include <s32cc_scp_scmi.h>
+#if (S32G_FAST_RESUME == 1)
+#include <s32g_resume_profile.h>
+#endif
+
+/*
+ * The parts of the resume setup BL2 skipped on the fast path, because the
+ * DDR restore doesn't depend on them.
+ */
+static void resume_deferred_setup(void)
+{
+#if (S32G_FAST_RESUME == 1)
+	int ret;
+
+	ret = s32g_resume_profile_run_post_ddr();
+	if (ret == -ENOENT)
+		return;
+
+	if (ret < 0) {
+		ERROR("Failed to replay the resume profile\n");
+		panic();
+	}
+
+#if S32CC_EMU == 0
+	if (!is_scp_used() && pmic_setup()) {
+		ERROR("Failed to disable VR5510 watchdog\n");
+		panic();
+	}
+#endif
+
+	if (platform_adjust_noc_settings()) {
+		ERROR("Failed to apply NoC settings\n");
+		panic();
+	}
+
+	s32_boot_prof_mark(S32_BOOT_RESUME_DEFERRED, ret);
+#endif
+}
 
 void s32g_resume_entrypoint(void)
 {
 	uintptr_t core_addr;
 
+	resume_deferred_setup();
+
 	if (!is_scp_used()) {
 		s32gen1_wkpu_reset();
+
+		/* BL2 reprogrammed the clock tree */
+		s32gen1_clk_invalidate_rates();
 	}
 
 #if (S32_USE_LINFLEX_IN_BL31 == 1)
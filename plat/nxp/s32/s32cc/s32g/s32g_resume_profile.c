@@ -0,0 +1,289 @@
+/*
+ * Copyright 2024 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <arch_helpers.h>
+#include <assert.h>
+#include <errno.h>
+#include <common/debug.h>
+#include <common/tf_crc32.h>
+#include <lib/cassert.h>
+#include <lib/mmio.h>
+#include <plat/nxp/s32g/ssram_mailbox.h>
+#include "s32cc_bl_common.h"
+#include "s32cc_reg_script.h"
+#include "s32g_clocks.h"
+#include "s32g_mc_me.h"
+#include "s32g_resume_profile.h"
+
+CASSERT(sizeof(struct s32g_ssram_mailbox) <=
+	S32_BOOT_PROF_BASE - BL31SSRAM_MAILBOX,
+	assert_s32g_ssram_mailbox_size);
+
+#define DDR_PLL_ODIVS		(1U)
+#define PERIPH_PLL_ODIVS	(8U)
+
+/* MC_CGM0 muxes set up by BL2 on the resume path, see early_clocks.c */
+static const uint8_t cgm0_muxes[] = {
+	8,	/* LINFLEX */
+	12,	/* QSPI */
+	14,	/* SDHC */
+};
+
+static struct s32g_resume_profile *get_profile(void)
+{
+	struct s32g_ssram_mailbox *ssram_mb = (void *)BL31SSRAM_MAILBOX;
+
+	return &ssram_mb->resume_profile;
+}
+
+static uint32_t get_crc(const struct s32g_resume_profile *prof)
+{
+	uint32_t n_ops = prof->n_pre_ddr + prof->n_post_ddr;
+	uint32_t crc;
+
+	crc = tf_crc32(0U, (const unsigned char *)&prof->n_pre_ddr,
+		       sizeof(prof->n_pre_ddr) + sizeof(prof->n_post_ddr));
+
+	return tf_crc32(crc, (const unsigned char *)prof->ops,
+			n_ops * sizeof(prof->ops[0]));
+}
+
+static bool is_valid(const struct s32g_resume_profile *prof)
+{
+	if (prof->magic != S32G_RESUME_PROFILE_MAGIC)
+		return false;
+
+	if (prof->n_pre_ddr + prof->n_post_ddr > ARRAY_SIZE(prof->ops))
+		return false;
+
+	return prof->crc == get_crc(prof);
+}
+
+/*
+ * Same sequence as program_pll() in the clock driver. The output dividers
+ * that were off are left off.
+ */
+static int add_pll(struct s32_reg_script *script, enum s32_pll_type pll,
+		   uint32_t n_odivs)
+{
+	uint32_t odivs[PERIPH_PLL_ODIVS];
+	uint32_t i;
+
+	assert(n_odivs <= ARRAY_SIZE(odivs));
+
+	if (mmio_read_32(PLLDIG_PLLCR(pll)) & PLLDIG_PLLCR_PLLPD)
+		return -ENODEV;
+
+	for (i = 0U; i < n_odivs; i++) {
+		odivs[i] = mmio_read_32(PLLDIG_PLLODIV(pll, i));
+		s32_reg_script_write(script, PLLDIG_PLLODIV(pll, i),
+				     odivs[i] & ~PLLDIG_PLLODIV_DE);
+	}
+
+	s32_reg_script_write(script, PLLDIG_PLLCR(pll), PLLDIG_PLLCR_PLLPD);
+	s32_reg_script_write(script, PLLDIG_PLLCLKMUX(pll),
+			     mmio_read_32(PLLDIG_PLLCLKMUX(pll)));
+	s32_reg_script_write(script, PLLDIG_PLLDV(pll),
+			     mmio_read_32(PLLDIG_PLLDV(pll)));
+	s32_reg_script_write(script, PLLDIG_PLLFD(pll),
+			     mmio_read_32(PLLDIG_PLLFD(pll)));
+	s32_reg_script_write(script, PLLDIG_PLLCR(pll), 0U);
+	s32_reg_script_poll(script, PLLDIG_PLLSR(pll), PLLDIG_PLLSR_LOCK,
+			    PLLDIG_PLLSR_LOCK);
+
+	for (i = 0U; i < n_odivs; i++) {
+		if (odivs[i] & PLLDIG_PLLODIV_DE)
+			s32_reg_script_write(script, PLLDIG_PLLODIV(pll, i),
+					     odivs[i]);
+	}
+
+	return 0;
+}
+
+static void add_dfs(struct s32_reg_script *script, enum s32_dfs_type dfs)
+{
+	uint32_t ports, ctl;
+	uint32_t i;
+
+	ports = mmio_read_32(DFS_PORTSR(dfs)) & DFS_PORTSR_PORTSTAT_MASK;
+	if (!ports)
+		return;
+
+	ctl = mmio_read_32(DFS_CTL(dfs));
+
+	s32_reg_script_write(script, DFS_PORTRESET(dfs),
+			     DFS_PORTRESET_RESET_MASK);
+	s32_reg_script_poll(script, DFS_PORTSR(dfs), DFS_PORTSR_PORTSTAT_MASK,
+			    0U);
+	s32_reg_script_write(script, DFS_CTL(dfs), DFS_CTL_RESET);
+
+	for (i = 0U; i < S32_DFS_PORTS_NR; i++) {
+		if (ports & BIT_32(i))
+			s32_reg_script_write(script, DFS_DVPORTn(dfs, i),
+					     mmio_read_32(DFS_DVPORTn(dfs, i)));
+	}
+
+	s32_reg_script_write(script, DFS_CTL(dfs), ctl & ~DFS_CTL_RESET);
+	s32_reg_script_write(script, DFS_PORTRESET(dfs),
+			     ~ports & DFS_PORTRESET_RESET_MASK);
+	s32_reg_script_poll(script, DFS_PORTSR(dfs), DFS_PORTSR_PORTSTAT_MASK,
+			    ports);
+}
+
+/* Same sequence as sw_mux_clk_config(), followed by the first divider */
+static void add_cgm_mux(struct s32_reg_script *script, uintptr_t cgm,
+			uint32_t mux)
+{
+	uint32_t css, csc, dc, source;
+
+	css = mmio_read_32(CGM_MUXn_CSS(cgm, mux));
+	csc = mmio_read_32(CGM_MUXn_CSC(cgm, mux));
+	dc = mmio_read_32(CGM_MUXn_DCn(cgm, mux, 0));
+	source = MC_CGM_MUXn_CSS_SELSTAT(css);
+
+	/* FIRC is the reset source */
+	if (source != MC_CGM_MUXn_CSC_SEL_CORE_PLL_FIRC) {
+		csc &= ~(MC_CGM_MUXn_CSC_SELCTL_MASK | MC_CGM_MUXn_CSC_CLK_SW);
+
+		s32_reg_script_poll(script, CGM_MUXn_CSS(cgm, mux),
+				    MC_CGM_MUXn_CSS_SWIP, 0U);
+		s32_reg_script_write(script, CGM_MUXn_CSC(cgm, mux),
+				     csc | MC_CGM_MUXn_CSC_SELCTL(source) |
+				     MC_CGM_MUXn_CSC_CLK_SW);
+		s32_reg_script_poll(script, CGM_MUXn_CSC(cgm, mux),
+				    MC_CGM_MUXn_CSC_CLK_SW, 0U);
+		s32_reg_script_poll(script, CGM_MUXn_CSS(cgm, mux),
+				    MC_CGM_MUXn_CSS_SWIP |
+				    MC_CGM_MUXn_CSS_SWTRG_MASK |
+				    MC_CGM_MUXn_CSS_SELSTAT_MASK,
+				    (MC_CGM_MUXn_CSS_SWTRG_SUCCESS <<
+				     MC_CGM_MUXn_CSS_SWTRG_OFFSET) |
+				    (source << MC_CGM_MUXn_CSS_SELSTAT_OFFSET));
+	}
+
+	if (dc & MUXn_DCn_DE) {
+		s32_reg_script_write(script, CGM_MUXn_DCn(cgm, mux, 0), dc);
+		s32_reg_script_poll(script, CGM_MUXn_DIV_UPD_STAT(cgm, mux),
+				    DIV_UPD_STAT_DIV_STAT, 0U);
+	}
+}
+
+/* Same sequence as enable_part_cofb() */
+static void add_part_cofb(struct s32_reg_script *script, uint32_t part,
+			  uint32_t blocks)
+{
+	s32_reg_script_clrset(script, S32_MC_ME_PRTN_N_COFB0_CLKEN(part), 0U,
+			      blocks);
+	s32_reg_script_clrset(script, S32_MC_ME_PRTN_N_PCONF(part), 0U,
+			      S32_MC_ME_PRTN_N_PCONF_PCE_MASK);
+	s32_reg_script_clrset(script, S32_MC_ME_PRTN_N_PUPD(part), 0U,
+			      S32_MC_ME_PRTN_N_PUPD_PCUD_MASK);
+	s32_reg_script_write(script, S32_MC_ME_CTL_KEY, S32_MC_ME_CTL_KEY_KEY);
+	s32_reg_script_write(script, S32_MC_ME_CTL_KEY,
+			     S32_MC_ME_CTL_KEY_INVERTEDKEY);
+	s32_reg_script_poll(script, S32_MC_ME_PRTN_N_STAT(part),
+			    S32_MC_ME_PRTN_N_PUPD_PCUD_MASK,
+			    S32_MC_ME_PRTN_N_PCONF_PCE_MASK);
+	s32_reg_script_poll(script, S32_MC_ME_PRTN_N_COFB0_STAT(part), blocks,
+			    blocks);
+}
+
+/* What s32_enable_ddr_clock() does, FXOSC is already on by then */
+static int add_ddr_clock(struct s32_reg_script *script)
+{
+	int ret;
+
+	ret = add_pll(script, S32_DDR_PLL, DDR_PLL_ODIVS);
+	if (ret)
+		return ret;
+
+	add_cgm_mux(script, MC_CGM5_BASE_ADDR, 0U);
+	add_part_cofb(script, S32_MC_ME_DDR_0_PART,
+		      S32_MC_ME_PRTN_N_REQ(S32_MC_ME_DDR_0_REQ));
+
+	return 0;
+}
+
+/* The rest of s32_periph_clock_init(), with the blocks enabled at suspend */
+static void add_periph_clocks(struct s32_reg_script *script)
+{
+	uint32_t clken;
+	size_t i;
+
+	if (add_pll(script, S32_PERIPH_PLL, PERIPH_PLL_ODIVS))
+		return;
+
+	add_dfs(script, S32_PERIPH_DFS);
+
+	for (i = 0; i < ARRAY_SIZE(cgm0_muxes); i++)
+		add_cgm_mux(script, MC_CGM0_BASE_ADDR, cgm0_muxes[i]);
+
+	clken = mmio_read_32(S32_MC_ME_PRTN_N_COFB0_CLKEN(S32_MC_ME_PRTN0));
+	add_part_cofb(script, S32_MC_ME_PRTN0, clken);
+}
+
+void s32g_resume_profile_capture(void)
+{
+	struct s32g_resume_profile *prof = get_profile();
+	struct s32_reg_script script;
+	int ret = 0;
+
+	prof->magic = 0U;
+	s32_reg_script_init(&script, prof->ops, ARRAY_SIZE(prof->ops));
+
+	if (!is_scp_used())
+		ret = add_ddr_clock(&script);
+	prof->n_pre_ddr = script.len;
+
+	if (!is_scp_used())
+		add_periph_clocks(&script);
+	prof->n_post_ddr = script.len - prof->n_pre_ddr;
+
+	if (ret || script.overflow) {
+		ERROR("Failed to capture the resume profile\n");
+	} else {
+		prof->crc = get_crc(prof);
+		prof->magic = S32G_RESUME_PROFILE_MAGIC;
+	}
+
+	/* BL2 reads it with the MMU off */
+	flush_dcache_range((uintptr_t)prof, sizeof(*prof));
+}
+
+int s32g_resume_profile_run_pre_ddr(void)
+{
+	struct s32g_resume_profile *prof = get_profile();
+	int ret;
+
+	if (!is_valid(prof))
+		return -ENOENT;
+
+	ret = s32_reg_script_run(prof->ops, prof->n_pre_ddr);
+	if (ret) {
+		/* BL2 takes the full path, BL31 has nothing left to do */
+		prof->magic = 0U;
+		return ret;
+	}
+
+	return prof->n_pre_ddr;
+}
+
+int s32g_resume_profile_run_post_ddr(void)
+{
+	struct s32g_resume_profile *prof = get_profile();
+	int ret;
+
+	if (!is_valid(prof))
+		return -ENOENT;
+
+	prof->magic = 0U;
+
+	ret = s32_reg_script_run(&prof->ops[prof->n_pre_ddr],
+				 prof->n_post_ddr);
+	if (ret)
+		return ret;
+
+	return prof->n_post_ddr;
+}
@@ -30,6 +30,10 @@ BL31_SOURCES += \
 		   ${S32_DRIVERS}/clk/s32r_scmi_ids.c \
 	       ${PLAT_SOC_PATH}/s32r_bl31.c \
 
+ifeq (${S32_CLK_SCRIPT},1)
+$(error S32_CLK_SCRIPT is not supported on S32R45)
+endif
+
 ERRATA_S32_050481	:= 1
 ERRATA_S32_050543	:= 1
 
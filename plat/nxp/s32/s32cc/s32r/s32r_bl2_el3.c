@@ -82,7 +82,8 @@ void bl2_el3_plat_arch_setup(void)
 
 	NOTICE("Reset status: %s\n", get_reset_cause_str(reset_cause));
 
-	s32_sram_clear(S32_BL33_IMAGE_BASE, get_bl2_dtb_base());
+	/* Let the SRAM controllers work while the DDR is being trained */
+	s32_sram_clear_start(S32_BL33_IMAGE_BASE, get_bl2_dtb_base());
 
 	clear_swt_faults();
 
@@ -93,6 +94,8 @@ void bl2_el3_plat_arch_setup(void)
 
 	dsbsy();
 
+	s32_sram_clear_wait();
+
 	if (s32_el3_mmu_ddr_fixup())
 		panic();
 
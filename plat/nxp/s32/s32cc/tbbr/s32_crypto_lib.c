@@ -4,18 +4,26 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <arch_helpers.h>
+#include <common/bl_common.h>
 #include <common/debug.h>
 #include <drivers/auth/crypto_mod.h>
 #include <drivers/nxp/s32/hse/hse_core.h>
 #include <drivers/nxp/s32/hse/hse_mem.h>
 #include <errno.h>
 #include <hse_interface.h>
+#include <lib/cassert.h>
+#include <lib/utils.h>
+#include <lib/utils_def.h>
 #include <mbedtls/asn1.h>
 #include <mbedtls/md.h>
 #include <mbedtls/oid.h>
 #include <mbedtls/platform.h>
 #include <mbedtls/x509.h>
 #include <plat/common/platform.h>
+#include <s32_bl_common.h>
+#include <s32cc_platform_def.h>
+#include <string.h>
 
 static void init(void)
 {
@@ -42,69 +50,424 @@ static hseHashAlgo_t get_hse_hash_algo(mbedtls_md_type_t md_alg)
 	}
 }
 
+/*
+ * Images outside the memory reachable by HSE are hashed through a bounce
+ * buffer of this size, using the START/UPDATE/FINISH access modes. It must be
+ * a multiple of the largest hash block size (SHA2-512: 128 bytes).
+ */
+#define HSE_HASH_CHUNK_SIZE	(64U * 1024U)
+#define HSE_HASH_STREAM_ID	(0U)
+
+CASSERT(HSE_HASH_CHUNK_SIZE % 128U == 0U, assert_hse_hash_chunk_size);
+
+/*
+ * Memory HSE is known to read from: the SRAM, where BL2 keeps the certificates,
+ * and the DDR regions BL2 loads images into. The rest of DDR0 may be firewalled
+ * from HSE or hold data owned by other masters, so it is never handed over.
+ */
+static const struct {
+	uintptr_t base;
+	uintptr_t end;
+} hse_shared_windows[] = {
+	{ S32_SRAM_BASE, S32_SRAM_END - 1U },
+	{ BL31_BASE, BL31_LIMIT },
+	{ S32_BL32_BASE, S32_BL32_LIMIT - 1U },
+	{ BL33_BASE, S32_BL33_LIMIT },
+	{ S32_DECOMP_BUF_BASE, S32_DECOMP_BUF_BASE + S32_DECOMP_BUF_SIZE - 1U },
+};
+
+/* The caller must clean the buffer to memory before handing it over */
+static bool is_hse_accessible(uintptr_t addr, size_t len)
+{
+	uintptr_t end;
+	size_t i;
+
+	if (!len || check_uptr_overflow(addr, len - 1U))
+		return false;
+
+	end = addr + len - 1U;
+
+	for (i = 0; i < ARRAY_SIZE(hse_shared_windows); i++)
+		if (addr >= hse_shared_windows[i].base &&
+		    end <= hse_shared_windows[i].end)
+			return true;
+
+	return false;
+}
+
+static void hse_hash_desc(hseSrvDescriptor_t *srv_desc,
+			  const hseHashSrv_t *hash_req, hseAccessMode_t mode,
+			  uintptr_t input, uint32_t input_len)
+{
+	hseHashSrv_t *req = &srv_desc->hseSrv.hashReq;
+
+	*srv_desc = (hseSrvDescriptor_t){0};
+	srv_desc->srvId = HSE_SRV_ID_HASH;
+	*req = *hash_req;
+	req->accessMode = mode;
+	req->inputLength = input_len;
+	req->pInput = input;
+}
+
+/* The image is read by HSE directly from where it was loaded */
+static int hse_hash_in_place(const hseHashSrv_t *hash_req, void *data_ptr,
+			     uint32_t data_len)
+{
+	hseSrvDescriptor_t srv_desc;
+	int ret;
+
+	flush_dcache_range((uintptr_t)data_ptr, data_len);
+
+	hse_hash_desc(&srv_desc, hash_req, HSE_ACCESS_MODE_ONE_PASS,
+		      hse_virt_to_phys(data_ptr), data_len);
+
+	ret = hse_srv_req_sync(HSE_CHANNEL_CRYPTO, &srv_desc);
+	if (ret)
+		VERBOSE("%s: hse_srv_req_sync (%d)\n", __func__, ret);
+
+	return ret;
+}
+
+/*
+ * The image is fed to HSE in chunks, through two buffers from the reserved
+ * pool: the next chunk is copied while HSE is still hashing the current one.
+ */
+static int hse_hash_streamed(const hseHashSrv_t *hash_req, void *data_ptr,
+			     uint32_t data_len)
+{
+	hseAccessMode_t mode = HSE_ACCESS_MODE_START;
+	const uint8_t *data = data_ptr;
+	void *chunk[2] = {NULL, NULL};
+	hseSrvDescriptor_t srv_desc;
+	bool in_flight = false;
+	struct hse_req req;
+	unsigned int idx = 0;
+	uint32_t size;
+	int ret = 0, err;
+
+	chunk[0] = hse_mem_alloc(MIN(data_len, HSE_HASH_CHUNK_SIZE));
+	if (!chunk[0])
+		return -ENOMEM;
+
+	if (data_len > HSE_HASH_CHUNK_SIZE) {
+		chunk[1] = hse_mem_alloc(HSE_HASH_CHUNK_SIZE);
+		if (!chunk[1]) {
+			ret = -ENOMEM;
+			goto free_chunks;
+		}
+	}
+
+	while (data_len) {
+		size = MIN(data_len, HSE_HASH_CHUNK_SIZE);
+
+		/* Last chunk */
+		if (size == data_len) {
+			if (mode == HSE_ACCESS_MODE_START)
+				mode = HSE_ACCESS_MODE_ONE_PASS;
+			else
+				mode = HSE_ACCESS_MODE_FINISH;
+		}
+
+		hse_memcpy(chunk[idx], data, size);
+
+		/* Requests on the same stream must not overlap */
+		if (in_flight) {
+			in_flight = false;
+			ret = hse_wait(&req);
+			if (ret)
+				break;
+		}
+
+		hse_hash_desc(&srv_desc, hash_req, mode,
+			      hse_virt_to_phys(chunk[idx]), size);
+
+		ret = hse_srv_req_submit(HSE_CHANNEL_CRYPTO, &srv_desc, &req);
+		if (ret)
+			break;
+		in_flight = true;
+
+		data += size;
+		data_len -= size;
+		mode = HSE_ACCESS_MODE_UPDATE;
+		idx ^= 1U;
+	}
+
+	if (in_flight) {
+		err = hse_wait(&req);
+		if (!ret)
+			ret = err;
+	}
+
+	if (ret)
+		VERBOSE("%s: hash request failed (%d)\n", __func__, ret);
+
+free_chunks:
+	hse_mem_free(chunk[1]);
+	hse_mem_free(chunk[0]);
+
+	return ret;
+}
+
+static int hse_hash_bufs_alloc(uint8_t md_size, void **hash_len_buf,
+			       void **hash_buf)
+{
+	*hash_len_buf = hse_mem_alloc(sizeof(uint32_t));
+	if (!*hash_len_buf)
+		return -ENOMEM;
+	hse_memcpy(*hash_len_buf, &md_size, sizeof(uint32_t));
+
+	*hash_buf = hse_mem_alloc(md_size);
+	if (!*hash_buf) {
+		hse_mem_free(*hash_len_buf);
+		*hash_len_buf = NULL;
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
+static void hse_hash_bufs_free(void *hash_len_buf, void *hash_buf)
+{
+	hse_mem_free(hash_buf);
+	hse_mem_free(hash_len_buf);
+}
+
+static int hse_hash_req_init(hseHashSrv_t *hash_req,
+			     const mbedtls_md_info_t *md_info,
+			     void *hash_len_buf, void *hash_buf)
+{
+	hseHashAlgo_t hash_alg;
+
+	hash_alg = get_hse_hash_algo(mbedtls_md_get_type(md_info));
+	if (hash_alg == HSE_HASH_ALGO_NULL)
+		return -EINVAL;
+
+	*hash_req = (hseHashSrv_t){0};
+	hash_req->streamId = HSE_HASH_STREAM_ID;
+	hash_req->sgtOption = HSE_SGT_OPTION_NONE;
+	hash_req->hashAlgo = hash_alg;
+	hash_req->pHashLength = hse_virt_to_phys(hash_len_buf);
+	hash_req->pHash = hse_virt_to_phys(hash_buf);
+
+	return 0;
+}
+
 static int hse_calc_hash(void *data_ptr, unsigned int data_len,
 			 const mbedtls_md_info_t *md_info, void *hash)
 {
-	void *data_buf = NULL, *hash_len_buf = NULL, *hash_buf = NULL;
-	hseSrvDescriptor_t srv_desc = {0};
-	hseHashAlgo_t hash_alg;
+	void *hash_len_buf = NULL, *hash_buf = NULL;
+	hseHashSrv_t hash_req;
+	uint64_t start;
+	bool in_place;
 	uint8_t md_size;
 	int ret;
 
 	if (!data_ptr || !data_len || !md_info || !hash)
 		return -EINVAL;
 
-	hash_alg = get_hse_hash_algo(mbedtls_md_get_type(md_info));
-	if (hash_alg == HSE_HASH_ALGO_NULL)
-		return -EINVAL;
-
 	md_size = mbedtls_md_get_size(md_info);
 	if (!md_size)
 		return -EINVAL;
 
-	data_buf = hse_mem_alloc(data_len);
-	if (!data_buf)
-		return -ENOMEM;
-	hse_memcpy(data_buf, data_ptr, data_len);
+	ret = hse_hash_bufs_alloc(md_size, &hash_len_buf, &hash_buf);
+	if (ret)
+		return ret;
 
-	hash_len_buf = hse_mem_alloc(sizeof(uint32_t));
-	if (!hash_len_buf) {
-		ret = -ENOMEM;
-		goto free_data_buf;
-	}
-	hse_memcpy(hash_len_buf, &md_size, sizeof(uint32_t));
+	ret = hse_hash_req_init(&hash_req, md_info, hash_len_buf, hash_buf);
+	if (ret)
+		goto free_hash_bufs;
 
-	hash_buf = hse_mem_alloc(md_size);
-	if (!hash_buf) {
-		ret = -ENOMEM;
-		goto free_hash_len_buf;
+	start = read_cntpct_el0();
+
+	in_place = is_hse_accessible((uintptr_t)data_ptr, data_len);
+	if (in_place)
+		ret = hse_hash_in_place(&hash_req, data_ptr, data_len);
+	else
+		ret = hse_hash_streamed(&hash_req, data_ptr, data_len);
+	if (ret)
+		goto free_hash_bufs;
+
+	INFO("HSE: hashed %u bytes %s in %llu us\n", data_len,
+	     in_place ? "in place" : "in chunks",
+	     s32_ticks_to_us(read_cntpct_el0() - start));
+
+	hse_memcpy(hash, hash_buf, md_size);
+
+free_hash_bufs:
+	hse_hash_bufs_free(hash_len_buf, hash_buf);
+
+	return ret;
+}
+
+#if (S32_HSE_DEFERRED_AUTH == 1)
+/*
+ * Images HSE can read in place are hashed in the background, on the spare
+ * crypto channels, while BL2 goes on loading the next images. The digest is
+ * checked once the request completes: when its slot is needed again, when BL2
+ * needs the image content, and at the latest before BL2 hands over to the
+ * loaded images.
+ */
+struct hse_deferred_hash {
+	struct hse_req req;
+	void *data_ptr;
+	unsigned int data_len;
+	void *hash_len_buf;
+	void *hash_buf;
+	unsigned char expected[MBEDTLS_MD_MAX_SIZE];
+	uint8_t md_size;
+	uint64_t submitted;
+	unsigned int image_id;
+	bool pending;
+};
+
+static const enum hse_ch_type deferred_hash_channels[] = {
+	HSE_CHANNEL_CRYPTO_1,
+	HSE_CHANNEL_CRYPTO_2,
+	HSE_CHANNEL_CRYPTO_3,
+};
+
+static struct hse_deferred_hash
+	deferred_hashes[ARRAY_SIZE(deferred_hash_channels)];
+
+/* Owner of the hashes submitted from now on, see s32_crypto_set_image_id() */
+static unsigned int loading_image_id = INVALID_IMAGE_ID;
+
+void s32_crypto_set_image_id(unsigned int image_id)
+{
+	loading_image_id = image_id;
+}
+
+static int hse_deferred_hash_check(struct hse_deferred_hash *dh)
+{
+	unsigned char hash[MBEDTLS_MD_MAX_SIZE];
+	uint64_t wait_start, wait_end;
+	int ret;
+
+	wait_start = read_cntpct_el0();
+	ret = hse_wait(&dh->req);
+	wait_end = read_cntpct_el0();
+
+	if (!ret) {
+		hse_memcpy(hash, dh->hash_buf, dh->md_size);
+		if (memcmp(hash, dh->expected, dh->md_size))
+			ret = -EAUTH;
 	}
-	srv_desc.srvId = HSE_SRV_ID_HASH;
-	srv_desc.hseSrv.hashReq.accessMode = HSE_ACCESS_MODE_ONE_PASS;
-	srv_desc.hseSrv.hashReq.sgtOption = HSE_SGT_OPTION_NONE;
-	srv_desc.hseSrv.hashReq.hashAlgo = hash_alg;
-	srv_desc.hseSrv.hashReq.inputLength = data_len;
-	srv_desc.hseSrv.hashReq.pInput = hse_virt_to_phys(data_buf);
-	srv_desc.hseSrv.hashReq.pHashLength = hse_virt_to_phys(hash_len_buf);
-	srv_desc.hseSrv.hashReq.pHash = hse_virt_to_phys(hash_buf);
 
-	ret = hse_srv_req_sync(HSE_CHANNEL_CRYPTO, &srv_desc);
+	hse_hash_bufs_free(dh->hash_len_buf, dh->hash_buf);
+	dh->pending = false;
+
+	INFO("HSE: hashed %u bytes at %p, overlapped with %llu us of loading, waited %llu us\n",
+	     dh->data_len, dh->data_ptr,
+	     s32_ticks_to_us(wait_start - dh->submitted),
+	     s32_ticks_to_us(wait_end - wait_start));
+
 	if (ret) {
-		VERBOSE("%s: hse_srv_req_sync (%d)\n", __func__, ret);
-		goto free_hash_buf;
+		ERROR("HSE: image id %u at %p failed authentication (%d)\n",
+		      dh->image_id, dh->data_ptr, ret);
+		zero_normalmem(dh->data_ptr, dh->data_len);
+		flush_dcache_range((uintptr_t)dh->data_ptr, dh->data_len);
+		return -EAUTH;
 	}
 
-	hse_memcpy(hash, hash_buf, md_size);
+	return 0;
+}
 
-free_hash_buf:
-	hse_mem_free(hash_buf);
-free_hash_len_buf:
-	hse_mem_free(hash_len_buf);
-free_data_buf:
-	hse_mem_free(data_buf);
+static struct hse_deferred_hash *get_deferred_hash_slot(unsigned int *ch_idx)
+{
+	struct hse_deferred_hash *oldest = NULL;
+	unsigned int i, oldest_idx = 0;
+
+	for (i = 0; i < ARRAY_SIZE(deferred_hashes); i++) {
+		if (!deferred_hashes[i].pending) {
+			*ch_idx = i;
+			return &deferred_hashes[i];
+		}
+
+		if (!oldest || deferred_hashes[i].submitted < oldest->submitted) {
+			oldest = &deferred_hashes[i];
+			oldest_idx = i;
+		}
+	}
+
+	/*
+	 * All channels busy, settle the request submitted first. A failure
+	 * belongs to an image loaded earlier, not to the one being loaded, so
+	 * it doesn't go back through the authentication of the latter.
+	 */
+	if (hse_deferred_hash_check(oldest))
+		plat_error_handler(-EAUTH);
+
+	*ch_idx = oldest_idx;
+	return oldest;
+}
+
+static int hse_hash_deferred(void *data_ptr, unsigned int data_len,
+			     const mbedtls_md_info_t *md_info,
+			     const unsigned char *expected)
+{
+	struct hse_deferred_hash *dh;
+	hseSrvDescriptor_t srv_desc;
+	hseHashSrv_t hash_req;
+	unsigned int ch_idx;
+	uint8_t md_size;
+	int ret;
+
+	md_size = mbedtls_md_get_size(md_info);
+	if (!md_size || md_size > sizeof(dh->expected))
+		return -EINVAL;
+
+	dh = get_deferred_hash_slot(&ch_idx);
+
+	ret = hse_hash_bufs_alloc(md_size, &dh->hash_len_buf, &dh->hash_buf);
+	if (ret)
+		return ret;
+
+	ret = hse_hash_req_init(&hash_req, md_info, dh->hash_len_buf,
+				dh->hash_buf);
+	if (ret)
+		goto free_hash_bufs;
+
+	flush_dcache_range((uintptr_t)data_ptr, data_len);
+
+	hse_hash_desc(&srv_desc, &hash_req, HSE_ACCESS_MODE_ONE_PASS,
+		      hse_virt_to_phys(data_ptr), data_len);
+
+	ret = hse_srv_req_submit(deferred_hash_channels[ch_idx], &srv_desc,
+				 &dh->req);
+	if (ret)
+		goto free_hash_bufs;
+
+	dh->data_ptr = data_ptr;
+	dh->data_len = data_len;
+	dh->md_size = md_size;
+	memcpy(dh->expected, expected, md_size);
+	dh->submitted = read_cntpct_el0();
+	dh->image_id = loading_image_id;
+	dh->pending = true;
+
+	return 0;
+
+free_hash_bufs:
+	hse_hash_bufs_free(dh->hash_len_buf, dh->hash_buf);
+	return ret;
+}
+
+int s32_crypto_wait_deferred(void)
+{
+	unsigned int i;
+	int ret = 0;
+
+	for (i = 0; i < ARRAY_SIZE(deferred_hashes); i++) {
+		if (!deferred_hashes[i].pending)
+			continue;
+
+		if (hse_deferred_hash_check(&deferred_hashes[i]))
+			ret = -EAUTH;
+	}
 
 	return ret;
 }
+#endif /* S32_HSE_DEFERRED_AUTH */
 
 /*
  * NOTE: This has been made internal in mbedtls 3.6.0 and the mbedtls team has
@@ -288,6 +651,23 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 	}
 	hash = p;
 
+#if (S32_HSE_DEFERRED_AUTH == 1)
+	/*
+	 * CRYPTO_SUCCESS only means the hash was queued: the digest is
+	 * compared in s32_crypto_wait_deferred(), which BL2 calls before using
+	 * the image content and before handing over to any image, see
+	 * bl2_plat_handle_pending_image_auth().
+	 */
+	if (data_ptr && data_len &&
+	    is_hse_accessible((uintptr_t)data_ptr, data_len)) {
+		ret = hse_hash_deferred(data_ptr, data_len, md_info, hash);
+		if (ret != 0)
+			return CRYPTO_ERR_HASH;
+
+		return CRYPTO_SUCCESS;
+	}
+#endif
+
 	ret = hse_calc_hash(data_ptr, data_len, md_info, data_hash);
 	if (ret != 0)
 		return CRYPTO_ERR_HASH;
@@ -0,0 +1,401 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+"""
+Build the register sequence of s32_periph_clock_init() (early_clocks.c) ahead
+of time: peripheral PLL, LINFLEX, SDHC or QSPI (depending on the FIP location)
+and DDR clocks. The output is a 'struct s32_reg_op' table replayed by
+s32_reg_script_run(), see s32cc_reg_script.h.
+
+The PLL, DFS and divider settings are computed with the same fixed-point
+arithmetic as the clock driver (s32_fp.h, enable_clk.c), so that the replay
+programs the very values the driver would. The frequencies come from
+boot_clk_freqs.in, preprocessed with the BL2 flags of the board.
+
+Unlike the driver, the sequence doesn't depend on the state left by BootROM:
+the PLLs are always reprogrammed, with their other output dividers left off,
+and the DFS is reset before its port is set up.
+"""
+
+import re
+import sys
+
+U64_MASK = (1 << 64) - 1
+
+FP_PRECISION = 100000000
+FP_PRECISION_ERROR = FP_PRECISION // 100
+
+PERIPH_PLL_ODIVS = 8
+DDR_PLL_ODIVS = 1
+PLL_MFN_DEN = 18432
+PLL_MFI_MAX = 0xFF
+DFS_MFN_DEN = 36
+DFS_MFI_MAX = 0xFF
+CGM_DIV_MAX = 8
+
+# PERIPH_PLL PHI3, see s32gen1_clk.c
+LIN_PLL_ODIV = 3
+# PERIPH_DFS ports
+QSPI_DFS_PORT = 0
+SDHC_DFS_PORT = 2
+
+FREQS = ('fxosc', 'periph_pll_vco', 'lin_baud', 'periph_dfs3', 'sdhc',
+         'periph_dfs1', 'qspi_2x', 'ddr_pll_vco', 'ddr')
+
+FREQ_RE = re.compile(r'^\s*(\w+)\s*=\s*(.+?)\s*$')
+SUFFIX_RE = re.compile(r'\b(\d+)[uUlL]+\b')
+EXPR_RE = re.compile(r'^[0-9\s()+\-*/]+$')
+
+
+class ClkError(Exception):
+    pass
+
+
+# s32_fp.h, on 64-bit unsigned integers
+def u2fp(val):
+    return (val * FP_PRECISION) & U64_MASK
+
+
+def fp2u(val):
+    return ((val + FP_PRECISION_ERROR) & U64_MASK) // FP_PRECISION
+
+
+def reduce_factors(a, b):
+    for factor in range(2, 6):
+        while a % factor == 0 and b % factor == 0:
+            a //= factor
+            b //= factor
+    return a, b
+
+
+def reduce_precision(a, b):
+    lost = 1
+
+    if not a or not b:
+        return lost
+
+    while ((a * b) & U64_MASK) // a != b:
+        lost <<= 1
+        a >>= 1
+        b >>= 1
+        if not a:
+            raise ClkError('fixed-point overflow')
+
+    return lost
+
+
+def fp_div(a, b):
+    div_factor = FP_PRECISION
+
+    a, b = reduce_factors(a, b)
+    div_factor, b = reduce_factors(div_factor, b)
+
+    prec_factor = reduce_precision(a, div_factor)
+
+    a //= prec_factor
+    b //= prec_factor
+    div_factor //= prec_factor
+
+    res = ((a * div_factor) & U64_MASK) // b
+    return (res * prec_factor) & U64_MASK
+
+
+def fp_mul(a, b):
+    factor = FP_PRECISION
+
+    a, factor = reduce_factors(a, factor)
+    b, factor = reduce_factors(b, factor)
+
+    return ((a * b) & U64_MASK) // factor
+
+
+def fp_add(a, b):
+    return (a + b) & U64_MASK
+
+
+def fp_sub(a, b):
+    return (a - b) & U64_MASK
+
+
+# Settings, as computed by enable_clk.c
+def get_pll_mfi_mfn(pll_vco, ref_freq):
+    mfi = pll_vco // ref_freq
+
+    dmfn = fp_div(u2fp(pll_vco % ref_freq), u2fp(ref_freq))
+    dmfn = fp_mul(dmfn, u2fp(PLL_MFN_DEN))
+
+    mfn = fp2u(dmfn) & 0xFFFFFFFF
+
+    if fp_sub(dmfn, u2fp(mfn)) >= FP_PRECISION // 2:
+        mfn += 1
+
+    vco = fp_div(u2fp(mfn), u2fp(PLL_MFN_DEN))
+    vco = fp_add(u2fp(mfi), vco)
+    vco = fp_mul(u2fp(ref_freq), vco)
+
+    if fp2u(vco) != pll_vco:
+        raise ClkError('no MFI and MFN settings for PLL freq %d, nearest %d' %
+                       (pll_vco, fp2u(vco)))
+
+    if mfi > PLL_MFI_MAX:
+        raise ClkError('PLL MFI %d out of range' % mfi)
+
+    return mfi, mfn
+
+
+def get_div(pfreq, freq, what):
+    dc = fp2u(fp_div(u2fp(pfreq), u2fp(freq)))
+
+    if not dc or fp2u(fp_div(u2fp(pfreq), u2fp(dc))) != freq:
+        raise ClkError('cannot set %s divider for input %d & output %d' %
+                       (what, pfreq, freq))
+
+    return dc
+
+
+def get_dfs_mfi_mfn(dfs_freq, freq):
+    factor = fp_div(u2fp(dfs_freq), u2fp(freq))
+    factor = fp_div(factor, u2fp(2))
+    mfi = fp2u(factor)
+    mfn = fp2u(fp_mul(fp_sub(factor, u2fp(mfi)), u2fp(DFS_MFN_DEN)))
+
+    div_freq = fp_add(u2fp(mfi), fp_div(u2fp(mfn), u2fp(DFS_MFN_DEN)))
+    div_freq = fp_mul(u2fp(2), div_freq)
+    div_freq = fp_div(u2fp(dfs_freq), div_freq)
+
+    if fp2u(div_freq) != freq:
+        raise ClkError('no MFI and MFN settings for DFS freq %d, nearest %d' %
+                       (freq, fp2u(div_freq)))
+
+    if mfi > DFS_MFI_MAX or mfn >= DFS_MFN_DEN:
+        raise ClkError('DFS MFI %d / MFN %d out of range' % (mfi, mfn))
+
+    return mfi, mfn
+
+
+# Register operations, see s32cc_reg_script.h
+class Script:
+    def __init__(self):
+        self.lines = []
+        self.len = 0
+
+    def comment(self, text):
+        if self.lines:
+            self.lines.append('')
+        self.lines.append('\t/* %s */' % text)
+
+    def _add(self, op, *args):
+        self.lines.append('\tS32_REG_%s(%s),' % (op, ', '.join(args)))
+        self.len += 1
+
+    def write(self, reg, val):
+        self._add('WRITE', reg, val)
+
+    def clrset(self, reg, clr, set_):
+        self._add('CLRSET', reg, clr, set_)
+
+    def poll(self, reg, mask, val):
+        self._add('POLL', reg, mask, val)
+
+
+# Same sequences as the clock driver, see enable_clk.c
+def add_pll(script, pll, n_odivs, vco, ref_freq, name):
+    mfi, mfn = get_pll_mfi_mfn(vco, ref_freq)
+
+    script.comment('%s: VCO %d Hz from FXOSC, MFI %d, MFN %d' %
+                   (name, vco, mfi, mfn))
+
+    for i in range(n_odivs):
+        script.clrset('PLLDIG_PLLODIV(%s, %d)' % (pll, i),
+                      'PLLDIG_PLLODIV_DE', '0U')
+
+    script.write('PLLDIG_PLLCR(%s)' % pll, 'PLLDIG_PLLCR_PLLPD')
+    script.write('PLLDIG_PLLCLKMUX(%s)' % pll,
+                 'PLLDIG_PLLCLKMUX_REFCLK_FXOSC')
+    script.clrset('PLLDIG_PLLDV(%s)' % pll,
+                  'PLLDIG_PLLDV_RDIV_MASK | PLLDIG_PLLDV_MFI_MASK',
+                  'PLLDIG_PLLDV_RDIV_SET(1U) | PLLDIG_PLLDV_MFI(%dU)' % mfi)
+    script.write('PLLDIG_PLLFD(%s)' % pll,
+                 'PLLDIG_PLLFD_MFN_SET(%dU) | PLLDIG_PLLFD_SMDEN' % mfn)
+    script.write('PLLDIG_PLLCR(%s)' % pll, '0U')
+    script.poll('PLLDIG_PLLSR(%s)' % pll, 'PLLDIG_PLLSR_LOCK',
+                'PLLDIG_PLLSR_LOCK')
+
+
+def add_pll_odiv(script, pll, index, vco, freq, name):
+    dc = get_div(vco, freq, '%s PLL' % name)
+
+    script.comment('%s: PHI%d %d Hz, divider %d' % (name, index, freq, dc))
+
+    reg = 'PLLDIG_PLLODIV(%s, %d)' % (pll, index)
+    script.write(reg, 'PLLDIG_PLLODIV_DIV_SET(%dU)' % (dc - 1))
+    script.clrset(reg, '0U', 'PLLDIG_PLLODIV_DE')
+
+
+def add_dfs_port(script, dfs, port, dfs_freq, freq, name):
+    mfi, mfn = get_dfs_mfi_mfn(dfs_freq, freq)
+
+    script.comment('%s: DFS port %d %d Hz, MFI %d, MFN %d' %
+                   (name, port, freq, mfi, mfn))
+
+    script.write('DFS_PORTOLSR(%s)' % dfs, 'DFS_PORTRESET_RESET_MASK')
+    script.write('DFS_PORTRESET(%s)' % dfs, 'DFS_PORTRESET_RESET_MASK')
+    script.poll('DFS_PORTSR(%s)' % dfs, 'DFS_PORTSR_PORTSTAT_MASK', '0U')
+    script.write('DFS_CTL(%s)' % dfs, 'DFS_CTL_RESET')
+    script.write('DFS_DVPORTn(%s, %d)' % (dfs, port),
+                 'DFS_DVPORTn_MFI(%dU) | DFS_DVPORTn_MFN(%dU)' % (mfi, mfn))
+    script.write('DFS_CTL(%s)' % dfs, '~(uint32_t)DFS_CTL_RESET')
+    script.clrset('DFS_PORTRESET(%s)' % dfs, 'BIT_32(%d)' % port, '0U')
+    script.poll('DFS_PORTSR(%s)' % dfs, 'BIT_32(%d)' % port,
+                'BIT_32(%d)' % port)
+    script.poll('DFS_PORTOLSR(%s)' % dfs, 'BIT_32(%d)' % port, '0U')
+
+
+def add_cgm_mux(script, cgm, mux, source, name):
+    script.comment('%s: MC_CGM mux %d from %s' % (name, mux, source))
+
+    csc = 'CGM_MUXn_CSC(%s, %d)' % (cgm, mux)
+    css = 'CGM_MUXn_CSS(%s, %d)' % (cgm, mux)
+    source = 'MC_CGM_MUXn_CSC_SEL_%s' % source
+
+    script.poll(css, 'MC_CGM_MUXn_CSS_SWIP', '0U')
+    script.clrset(csc, 'MC_CGM_MUXn_CSC_SELCTL_MASK',
+                  'MC_CGM_MUXn_CSC_SELCTL(%s) | MC_CGM_MUXn_CSC_CLK_SW' %
+                  source)
+    script.poll(csc, 'MC_CGM_MUXn_CSC_CLK_SW', '0U')
+    script.poll(css, 'MC_CGM_MUXn_CSS_SWIP', '0U')
+    script.poll(css,
+                'MC_CGM_MUXn_CSS_SWTRG_MASK | MC_CGM_MUXn_CSS_SELSTAT_MASK',
+                '(MC_CGM_MUXn_CSS_SWTRG_SUCCESS << '
+                'MC_CGM_MUXn_CSS_SWTRG_OFFSET) | '
+                '(%s << MC_CGM_MUXn_CSS_SELSTAT_OFFSET)' % source)
+
+
+def add_cgm_div(script, cgm, mux, pfreq, freq, name):
+    dc = get_div(pfreq, freq, '%s CGM' % name)
+    if dc > CGM_DIV_MAX:
+        raise ClkError('%s CGM divider %d out of range' % (name, dc))
+
+    script.comment('%s: %d Hz, divider %d' % (name, freq, dc))
+
+    script.write('CGM_MUXn_DCn(%s, %d, 0)' % (cgm, mux),
+                 'MUXn_DCn_DE | MC_CGM_MUXn_DCn_DIV(%dU)' % (dc - 1))
+    script.poll('CGM_MUXn_DIV_UPD_STAT(%s, %d)' % (cgm, mux),
+                'DIV_UPD_STAT_DIV_STAT', '0U')
+
+
+def add_part_cofb(script, part, req, name):
+    block = 'S32_MC_ME_PRTN_N_REQ(%s)' % req
+
+    script.comment('%s: %s block enable' % (name, part))
+
+    script.clrset('S32_MC_ME_PRTN_N_COFB0_CLKEN(%s)' % part, '0U', block)
+    script.clrset('S32_MC_ME_PRTN_N_PCONF(%s)' % part, '0U',
+                  'S32_MC_ME_PRTN_N_PCONF_PCE_MASK')
+    script.clrset('S32_MC_ME_PRTN_N_PUPD(%s)' % part, '0U',
+                  'S32_MC_ME_PRTN_N_PUPD_PCUD_MASK')
+    script.write('S32_MC_ME_CTL_KEY', 'S32_MC_ME_CTL_KEY_KEY')
+    script.write('S32_MC_ME_CTL_KEY', 'S32_MC_ME_CTL_KEY_INVERTEDKEY')
+    script.poll('S32_MC_ME_PRTN_N_STAT(%s)' % part,
+                'S32_MC_ME_PRTN_N_PUPD_PCUD_MASK',
+                'S32_MC_ME_PRTN_N_PCONF_PCE_MASK')
+    script.poll('S32_MC_ME_PRTN_N_COFB0_STAT(%s)' % part, block, block)
+
+
+# s32_periph_clock_init()
+def build(freqs, fip_location):
+    script = Script()
+    vco = freqs['periph_pll_vco']
+
+    add_pll(script, 'S32_PERIPH_PLL', PERIPH_PLL_ODIVS, vco, freqs['fxosc'],
+            'PERIPH_PLL')
+    add_pll_odiv(script, 'S32_PERIPH_PLL', LIN_PLL_ODIV, vco,
+                 freqs['lin_baud'], 'LINFLEX')
+    add_cgm_mux(script, 'MC_CGM0_BASE_ADDR', 8, 'PERIPH_PLL_PHI3', 'LINFLEX')
+
+    if fip_location == 'mmc':
+        add_dfs_port(script, 'S32_PERIPH_DFS', SDHC_DFS_PORT, vco,
+                     freqs['periph_dfs3'], 'SDHC')
+        add_cgm_mux(script, 'MC_CGM0_BASE_ADDR', 14, 'PERIPH_PLL_DFS3',
+                    'SDHC')
+        add_cgm_div(script, 'MC_CGM0_BASE_ADDR', 14, freqs['periph_dfs3'],
+                    freqs['sdhc'], 'SDHC')
+        add_part_cofb(script, 'S32_MC_ME_USDHC_PART', 'S32_MC_ME_USDHC_REQ',
+                      'SDHC')
+    elif fip_location == 'qspi':
+        add_dfs_port(script, 'S32_PERIPH_DFS', QSPI_DFS_PORT, vco,
+                     freqs['periph_dfs1'], 'QSPI')
+        add_cgm_mux(script, 'MC_CGM0_BASE_ADDR', 12, 'PERIPH_PLL_DFS1',
+                    'QSPI')
+        add_cgm_div(script, 'MC_CGM0_BASE_ADDR', 12, freqs['periph_dfs1'],
+                    freqs['qspi_2x'], 'QSPI')
+
+    vco = freqs['ddr_pll_vco']
+    add_pll(script, 'S32_DDR_PLL', DDR_PLL_ODIVS, vco, freqs['fxosc'],
+            'DDR_PLL')
+    add_pll_odiv(script, 'S32_DDR_PLL', 0, vco, freqs['ddr'], 'DDR')
+    add_cgm_mux(script, 'MC_CGM5_BASE_ADDR', 0, 'DDR_PLL_PHI0', 'DDR')
+    add_part_cofb(script, 'S32_MC_ME_DDR_0_PART', 'S32_MC_ME_DDR_0_REQ',
+                  'DDR')
+
+    return script
+
+
+def parse_freqs(path):
+    freqs = {}
+
+    with open(path) as f:
+        for line in f:
+            match = FREQ_RE.match(line)
+            if not match:
+                continue
+
+            name, expr = match.groups()
+            expr = SUFFIX_RE.sub(r'\1', expr)
+            if not EXPR_RE.match(expr):
+                raise ClkError('%s: cannot evaluate %s = %s' %
+                               (path, name, expr))
+
+            freqs[name] = eval(expr.replace('/', '//'), {'__builtins__': {}})
+
+    for name in FREQS:
+        if not freqs.get(name):
+            raise ClkError('%s: no frequency for %s' % (path, name))
+
+    return freqs
+
+
+def main(argv):
+    if len(argv) != 4 or argv[2] not in ('mmc', 'qspi', 'memory'):
+        sys.stderr.write('usage: %s <freqs> <mmc|qspi|memory> <output.c>\n' %
+                         argv[0])
+        return 1
+
+    try:
+        script = build(parse_freqs(argv[1]), argv[2])
+    except ClkError as e:
+        sys.stderr.write('%s: %s\n' % (argv[0], e))
+        return 1
+
+    with open(argv[3], 'w') as f:
+        f.write('/*\n * Generated from %s by clk_script_gen.py, do not edit.\n'
+                ' * FIP location: %s, %d register operations.\n */\n\n' %
+                (argv[1], argv[2], script.len))
+        f.write('#include <s32cc_clk_script.h>\n')
+        f.write('#include <s32g_clocks.h>\n')
+        f.write('#include <s32g_mc_me.h>\n\n')
+        f.write('const struct s32_reg_op s32_boot_clk_script[] = {\n')
+        f.write('\n'.join(script.lines))
+        f.write('\n};\n\n')
+        f.write('const uint32_t s32_boot_clk_script_len =\n'
+                '\tARRAY_SIZE(s32_boot_clk_script);\n')
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
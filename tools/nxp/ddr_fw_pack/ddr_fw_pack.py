@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 NXP
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+"""
+Pack the S32 DDR PHY firmware tables (imem_cfg.c, dmem_cfg.c) into a stream
+of runs decoded by load_phy_image(). Each run starts with a header halfword:
+
+  bit 15     : 0 - 'count' literal halfwords follow
+               1 - a single halfword follows, to be written 'count' times
+  bits 14..0 : count
+
+The generated file keeps the array and size symbol names of the input, the
+sizes now being those of the packed streams.
+"""
+
+import re
+import sys
+
+RUN_FILL = 0x8000
+RUN_COUNT_MAX = 0x7FFF
+# A fill run costs two halfwords
+FILL_MIN = 3
+
+ARRAY_RE = re.compile(r'uint16_t\s+(\w+)\[\]\s*=\s*\{(.*?)\};', re.S)
+VALUE_RE = re.compile(r'0x([0-9a-fA-F]+)U?')
+
+
+def pack(values):
+    out = []
+    lits = []
+
+    def flush_lits():
+        while lits:
+            chunk = lits[:RUN_COUNT_MAX]
+            del lits[:RUN_COUNT_MAX]
+            out.append(len(chunk))
+            out.extend(chunk)
+
+    i = 0
+    while i < len(values):
+        run = 1
+        while i + run < len(values) and values[i + run] == values[i]:
+            run += 1
+
+        if run >= FILL_MIN:
+            flush_lits()
+            left = run
+            while left:
+                count = min(left, RUN_COUNT_MAX)
+                out.extend([RUN_FILL | count, values[i]])
+                left -= count
+        else:
+            lits.extend(values[i:i + run])
+
+        i += run
+
+    flush_lits()
+    return out
+
+
+def unpack(stream):
+    out = []
+    i = 0
+    while i < len(stream):
+        hdr = stream[i]
+        count = hdr & RUN_COUNT_MAX
+        if hdr & RUN_FILL:
+            out.extend([stream[i + 1]] * count)
+            i += 2
+        else:
+            out.extend(stream[i + 1:i + 1 + count])
+            i += 1 + count
+    return out
+
+
+def emit_array(name, stream):
+    lines = ['uint16_t %s[] = {' % name]
+    for i in range(0, len(stream), 8):
+        words = ', '.join('0x%04xU' % w for w in stream[i:i + 8])
+        lines.append('\t%s,' % words)
+    lines.append('};')
+    lines.append('')
+    lines.append('size_t %s_size = ARRAY_SIZE(%s);' % (name, name))
+    return '\n'.join(lines)
+
+
+def main(argv):
+    if len(argv) != 3:
+        sys.stderr.write('usage: %s <input.c> <output.c>\n' % argv[0])
+        return 1
+
+    with open(argv[1]) as f:
+        src = f.read()
+
+    arrays = ARRAY_RE.findall(src)
+    if not arrays:
+        sys.stderr.write('%s: no firmware tables found\n' % argv[1])
+        return 1
+
+    body = []
+    for name, values in arrays:
+        if ('%s_size = ARRAY_SIZE(%s)' % (name, name)) not in src:
+            sys.stderr.write('%s: no size for %s\n' % (argv[1], name))
+            return 1
+
+        values = [int(v, 16) for v in VALUE_RE.findall(values)]
+        stream = pack(values)
+        if unpack(stream) != values:
+            sys.stderr.write('%s: failed to pack %s\n' % (argv[1], name))
+            return 1
+
+        body.append('/* %d halfwords packed into %d */\n%s' %
+                    (len(values), len(stream), emit_array(name, stream)))
+
+    with open(argv[2], 'w') as f:
+        f.write('/*\n * Generated from %s by ddr_fw_pack.py, do not edit.\n'
+                ' */\n\n' % argv[1])
+        f.write('#include "ddr_init.h"\n\n')
+        f.write('\n\n'.join(body))
+        f.write('\n')
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))